@@ -1,23 +1,79 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <fstream>
 #include <getopt.h>
+#include <unistd.h>
+#include <fcntl.h>
 #include <json/json.h>
 #include "poker/cfr_solver.h"
 #include "poker/game_tree.h"
 #include "poker/evaluator.h"
+#include "poker/metrics.h"
+#include "poker/progress_reporter.h"
+#include "poker/strategy_diff.h"
+#include "poker/strategy_file.h"
+#include "poker/strategy_store.h"
+#include "poker/solution_cache.h"
+#include "poker/distributed_cfr.h"
+#include "poker/checkpoint_merge.h"
+#include "poker/trace.h"
+#include "poker/batch_job.h"
+#include "poker/solve_job.h"
+#include "poker/solver_daemon.h"
 
 using namespace poker;
 
 void print_usage(const char* program_name) {
     std::cout << "Usage: " << program_name << " [OPTIONS]\n"
+              << "       " << program_name << " --merge-checkpoints OUT CKPT...\n"
               << "Options:\n"
-              << "  --task-type TYPE     Type de tâche: 'preflop' ou 'postflop'\n"
+              << "  --task-type TYPE     Type de tâche: 'preflop', 'postflop' ou 'batch' (voir batch_job.h)\n"
               << "  --params-file FILE   Fichier JSON avec les paramètres de simulation\n"
               << "  --output-format FMT  Format de sortie: 'json' ou 'text' (défaut: text)\n"
+              << "  --serve              Mode démon: tâches en trames JSON sur stdin (voir solver_daemon.h)\n"
+              << "  --socket PATH        Avec --serve: écouter sur un socket Unix au lieu de stdin\n"
+              << "  --workers N          Avec --serve: tâches résolues en parallèle (défaut: 1)\n"
+              << "  --cached-trees N     Avec --serve: arbres conservés entre les tâches (défaut: 4)\n"
+              << "  --metrics-file FILE  Métriques Prometheus écrites en fin de résolution (avec --serve:\n"
+              << "                       après chaque tâche), pour le collecteur textfile de node_exporter\n"
+              << "  --progress-fd FD     Avancement en NDJSON sur le descripteur FD (ex.: 3, ou 2 pour\n"
+              << "                       stderr), séparé du résultat (voir progress_reporter.h)\n"
+              << "  --progress-interval MS  Cadence des événements d'avancement (défaut: 1000)\n"
+              << "  --strategy-diff-fd FD   Infosets dont la stratégie moyenne a changé, en NDJSON sur FD\n"
+              << "                       (voir strategy_diff.h)\n"
+              << "  --strategy-diff-every N   Itérations entre deux trames de diff (défaut: 100)\n"
+              << "  --strategy-diff-threshold X   Écart minimal d'une probabilité (défaut: 0.01)\n"
+              << "  --export-strategy FILE   Stratégies moyennes de tous les infosets au format binaire\n"
+              << "                       quantifié (voir strategy_file.h), écrites après la résolution\n"
+              << "  --strategy-bits N    Précision de l'export: 8 ou 16 bits (défaut: 8)\n"
+              << "  --strategy-prune X   Probabilités inférieures à X mises à zéro à l'export (défaut: 0)\n"
+              << "  --strategy-to-json FILE   Convertir un export binaire en JSON sur la sortie standard\n"
+              << "  --query-strategy FILE   Interroger un export binaire: une requête JSON par ligne sur\n"
+              << "                       l'entrée standard ({\"history\", \"hand\", \"board\"}), une\n"
+              << "                       réponse par ligne sur la sortie standard (voir strategy_store.h)\n"
+              << "  --solution-cache DIR   Solutions réutilisées entre les exécutions pour un même spot, à\n"
+              << "                       l'isomorphisme de couleurs près (voir solution_cache.h)\n"
+              << "  --solution-cache-mb N  Budget disque du cache, entrées les moins récentes supprimées\n"
+              << "                       (défaut: 1024)\n"
+              << "  --coordinator ADDR   Résolution répartie: sous-arbres de la racine confiés aux workers\n"
+              << "                       connectés sur ADDR (socket Unix ou hôte:port, voir distributed_cfr.h)\n"
+              << "  --distributed-workers N   Avec --coordinator: workers attendus (défaut: 1)\n"
+              << "  --worker ADDR        Worker d'une résolution répartie: se connecte au coordinateur ADDR\n"
+              << "  --merge-checkpoints OUT   Fusionner les checkpoints MCCFR CKPT... de résolutions indépendantes\n"
+              << "                       d'un même arbre (graines différentes) en OUT: regrets et\n"
+              << "                       stratégies additionnés (voir checkpoint_merge.h)\n"
+              << "  --trace FILE         Chronologie des phases par thread (JSON trace event de Chrome,\n"
+              << "                       à ouvrir dans ui.perfetto.dev), écrite en fin d'exécution\n"
               << "  --help               Afficher cette aide\n"
               << "\nExemples:\n"
               << "  " << program_name << " --task-type preflop --params-file params.json --output-format json\n"
+              << "  " << program_name << " --task-type postflop --params-file params.json --coordinator /tmp/cfr.sock \\\n"
+              << "      --distributed-workers 2   (puis deux fois: " << program_name << " --worker /tmp/cfr.sock)\n"
+              << "  " << program_name << " --serve --socket /tmp/poker-solver.sock --workers 2\n"
               << "  " << program_name << " (mode interactif)\n";
 }
 
@@ -38,134 +94,147 @@ Json::Value load_params_file(const std::string& filename) {
     return root;
 }
 
-CFRConfig parse_solver_config(const Json::Value& config) {
-    CFRConfig cfr_config;
-    
-    if (config.isMember("max_iterations")) {
-        cfr_config.max_iterations = config["max_iterations"].asInt();
-    }
-    if (config.isMember("target_exploitability")) {
-        cfr_config.target_exploitability = config["target_exploitability"].asDouble();
-    }
-    if (config.isMember("use_chance_sampling")) {
-        cfr_config.use_chance_sampling = config["use_chance_sampling"].asBool();
-    }
-    if (config.isMember("use_discounting")) {
-        cfr_config.use_discounting = config["use_discounting"].asBool();
-    }
-    if (config.isMember("alpha")) {
-        cfr_config.alpha = config["alpha"].asDouble();
-    }
-    if (config.isMember("beta")) {
-        cfr_config.beta = config["beta"].asDouble();
-    }
-    if (config.isMember("checkpoint_frequency")) {
-        cfr_config.checkpoint_frequency = config["checkpoint_frequency"].asInt();
-    }
-    
-    return cfr_config;
-}
+// Flux NDJSON pendant une résolution; fd < 0: désactivé
+struct ProgressOptions {
+    int fd = -1;                  // --progress-fd
+    int interval_ms = 1000;
+    int strategy_diff_fd = -1;    // --strategy-diff-fd
+    int strategy_diff_every = 100;
+    double strategy_diff_threshold = 0.01;
+};
 
-GameState parse_game_config(const Json::Value& config) {
-    GameState state;
-    
-    // Configuration par défaut
-    state.num_players = 2;
-    state.street = 0; // preflop
-    state.current_player = 0;
-    state.button_position = 1;
-    state.small_blind = 0.5;
-    state.big_blind = 1.0;
-    state.pot = 1.5; // SB + BB
-    
-    // Parser les paramètres depuis le JSON
-    if (config.isMember("num_players")) {
-        state.num_players = config["num_players"].asInt();
-    }
-    if (config.isMember("small_blind")) {
-        state.small_blind = config["small_blind"].asDouble();
-    }
-    if (config.isMember("big_blind")) {
-        state.big_blind = config["big_blind"].asDouble();
-    }
-    if (config.isMember("stack_size")) {
-        double stack_size = config["stack_size"].asDouble();
-        state.stacks.resize(state.num_players, stack_size);
-    } else {
-        state.stacks.resize(state.num_players, 100.0); // 100 BB par défaut
+// Export binaire de la solution; strategy_file vide: désactivé
+struct ExportOptions {
+    std::string strategy_file;    // --export-strategy
+    StrategyExportOptions format;
+};
+
+// Résultat rendu par le cache de solutions, sans résolution
+void print_cached_result(const SolutionCache::Lookup& cached, const std::string& output_format) {
+    if (output_format == "json") {
+        Json::Value output = cached.result;
+        output["solution_cache"] = solution_cache_status_name(cached.status);
+        
+        Json::StreamWriterBuilder builder;
+        std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+        writer->write(output, &std::cout);
+        std::cout << std::endl;
+        return;
     }
     
-    // Initialiser les mises (SB et BB déjà misés)
-    state.bets.resize(state.num_players, 0.0);
-    if (state.num_players >= 2) {
-        state.bets[0] = state.small_blind;  // Small blind
-        state.bets[1] = state.big_blind;    // Big blind
-        state.stacks[0] -= state.small_blind;
-        state.stacks[1] -= state.big_blind;
-    }
+    const Json::Value& result = cached.result["result"];
+    std::cout << "\n=== Résultats de la simulation (cache " << cached.key << ") ===\n";
+    std::cout << "Type: " << cached.result["task_type"].asString() << "\n";
+    std::cout << "Statut: " << (result["converged"].asBool() ? "Convergé" : "Non convergé") << "\n";
+    std::cout << "Itérations: " << result["iterations_completed"].asInt() << "\n";
+    std::cout << "Exploitabilité finale: " << result["final_exploitability"].asDouble() << "\n";
+    std::cout << "Message: " << result["status"].asString() << "\n";
     
-    // Tailles de mise autorisées (en % du pot)
-    state.allowed_bet_sizes = {0.33, 0.5, 0.75, 1.0}; // 33%, 50%, 75%, 100% pot
-    if (config.isMember("allowed_bet_sizes")) {
-        state.allowed_bet_sizes.clear();
-        for (const auto& size : config["allowed_bet_sizes"]) {
-            state.allowed_bet_sizes.push_back(size.asDouble());
-        }
+    std::cout << "\nStratégie du joueur 0:\n";
+    const Json::Value& strategy = result["strategy"]["player_0"];
+    for (Json::ArrayIndex i = 0; i < strategy.size(); ++i) {
+        std::cout << "Action " << i << ": " << strategy[i].asDouble() << "\n";
     }
-    
-    return state;
 }
 
-int run_simulation(const std::string& task_type, const Json::Value& params, const std::string& output_format) {
+int run_simulation(const std::string& task_type, const Json::Value& params, const std::string& output_format,
+                   const ProgressOptions& progress_options, const ExportOptions& export_options,
+                   SolutionCache* solution_cache, const DistributedOptions& distributed_options) {
     try {
         // Parser la configuration
         CFRConfig solver_config = parse_solver_config(params["solver_config"]);
         GameState initial_state = parse_game_config(params["game_config"]);
         
+        // Spot déjà résolu (ou isomorphe): résultat immédiat, ou reprise à chaud
+        std::string spot;
+        SolutionCache::Lookup cached;
+        if (solution_cache) {
+            spot = canonical_spot(task_type, params);
+            cached = solution_cache->lookup(spot, params);
+            if (cached.status == SolutionCache::Status::HIT) {
+                print_cached_result(cached, output_format);
+                return 0;
+            }
+        }
+        
         // Créer l'abstraction
         auto abstraction = std::make_shared<BasicAbstraction>();
         
         // Créer le solveur approprié
         std::unique_ptr<CFRSolver> solver;
-        if (task_type == "preflop") {
-            solver = std::make_unique<VanillaCFR>(abstraction, solver_config);
-        } else if (task_type == "postflop") {
-            // Pour le postflop, utiliser MCCFR si disponible
-            solver = std::make_unique<VanillaCFR>(abstraction, solver_config);
+        if (!distributed_options.address.empty()) {
+            create_exhaustive_solver(task_type, abstraction, solver_config, params["game_config"]); // Valide la tâche et les options
+            solver = std::make_unique<DistributedCFR>(abstraction, solver_config, distributed_options, task_type, params);
+            // Les workers repartent de zéro: pas de reprise depuis le cache
+            cached.status = SolutionCache::Status::MISS;
         } else {
-            throw std::runtime_error("Type de tâche non supporté: " + task_type);
+            solver = create_task_solver(task_type, abstraction, solver_config, params["game_config"]);
+        }
+        if (cached.status == SolutionCache::Status::WARM) {
+            solver->load_checkpoint(cached.checkpoint_path);
         }
         
         // Exécuter la simulation
         std::cout << "Démarrage de la simulation " << task_type << "..." << std::endl;
+        std::unique_ptr<ProgressReporter> reporter;
+        if (progress_options.fd >= 0) {
+            reporter = std::make_unique<ProgressReporter>(*solver, progress_options.fd,
+                                                          std::chrono::milliseconds(progress_options.interval_ms));
+        }
+        
+        // Deltas de stratégie, écrits entre deux itérations par le thread du solveur
+        StrategyDiffTracker diff_tracker(progress_options.strategy_diff_threshold);
+        std::unique_ptr<FILE, int (*)(FILE*)> diff_file(nullptr, std::fclose);
+        Json::StreamWriterBuilder diff_writer = strategy_diff_writer();
+        auto write_diff = [&](int iteration) {
+            Json::Value frame = diff_tracker.diff(*solver, iteration);
+            if (!frame.isNull()) {
+                std::string line = Json::writeString(diff_writer, frame) + "\n";
+                std::fwrite(line.data(), 1, line.size(), diff_file.get());
+                std::fflush(diff_file.get());
+            }
+        };
+        if (progress_options.strategy_diff_fd >= 0) {
+            diff_file.reset(fdopen(dup(progress_options.strategy_diff_fd), "w"));
+            if (!diff_file) {
+                throw std::runtime_error("Flux de diff de stratégie indisponible");
+            }
+            solver->set_iteration_callback(progress_options.strategy_diff_every, write_diff);
+        }
+        
         auto result = solver->solve(initial_state);
+        if (reporter) {
+            reporter->stop();
+        }
+        if (diff_file) {
+            // Dernière trame: état final, quelle que soit la cadence
+            solver->set_iteration_callback(0, nullptr);
+            write_diff(result.iterations_completed);
+        }
+        
+        if (!export_options.strategy_file.empty()) {
+            StrategyExportOptions format = export_options.format;
+            Json::Value metadata;
+            metadata["task_type"] = task_type;
+            metadata["solver_config"] = params["solver_config"];
+            metadata["game_config"] = params["game_config"];
+            Json::StreamWriterBuilder metadata_writer;
+            metadata_writer["indentation"] = "";
+            format.metadata = Json::writeString(metadata_writer, metadata);
+            write_strategy_file(*solver, export_options.strategy_file, format);
+            std::cout << "Stratégie exportée vers " << export_options.strategy_file << std::endl;
+        }
         
         // Obtenir la stratégie finale
         auto strategy = solver->get_strategy(initial_state, 0);
+        Json::Value output = simulation_result_json(task_type, params, result, strategy);
+        if (solution_cache && !solver->stop_requested()) {
+            solution_cache->store(spot, *solver, task_type, params, output);
+            output["solution_cache"] = solution_cache_status_name(cached.status);
+        }
         
         // Formater la sortie
         if (output_format == "json") {
-            Json::Value output;
-            output["success"] = true;
-            output["task_type"] = task_type;
-            output["result"] = Json::Value();
-            output["result"]["iterations_completed"] = result.iterations_completed;
-            output["result"]["final_exploitability"] = result.final_exploitability;
-            output["result"]["convergence_time"] = result.convergence_time_seconds;
-            output["result"]["converged"] = result.converged;
-            output["result"]["status"] = result.status_message;
-            
-            // Ajouter la stratégie
-            Json::Value strategy_json(Json::arrayValue);
-            for (size_t i = 0; i < strategy.size(); ++i) {
-                strategy_json.append(strategy[i]);
-            }
-            output["result"]["strategy"]["player_0"] = strategy_json;
-            
-            // Ajouter les métadonnées
-            output["result"]["metadata"]["solver_config"] = params["solver_config"];
-            output["result"]["metadata"]["game_config"] = params["game_config"];
-            
             Json::StreamWriterBuilder builder;
             std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
             writer->write(output, &std::cout);
@@ -179,6 +248,14 @@ int run_simulation(const std::string& task_type, const Json::Value& params, cons
             std::cout << "Exploitabilité finale: " << result.final_exploitability << "\n";
             std::cout << "Temps de convergence: " << result.convergence_time_seconds << "s\n";
             std::cout << "Message: " << result.status_message << "\n";
+            if (solution_cache) {
+                std::cout << "Cache de solutions: " << solution_cache_status_name(cached.status)
+                          << (cached.status == SolutionCache::Status::WARM
+                              ? " (reprise à l'itération " + std::to_string(cached.iterations) + ")" : "") << "\n";
+            }
+            std::cout << "Infosets: " << result.num_infosets << " (" 
+                      << result.infoset_memory_bytes / (1024 * 1024) << " Mo, pages de 2 Mo: "
+                      << result.huge_page_bytes / (1024 * 1024) << " Mo)\n";
             
             std::cout << "\nStratégie du joueur 0:\n";
             for (size_t i = 0; i < strategy.size(); ++i) {
@@ -190,9 +267,7 @@ int run_simulation(const std::string& task_type, const Json::Value& params, cons
         
     } catch (const std::exception& e) {
         if (output_format == "json") {
-            Json::Value error_output;
-            error_output["success"] = false;
-            error_output["error"] = e.what();
+            Json::Value error_output = simulation_error_json(e.what());
             
             Json::StreamWriterBuilder builder;
             std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
@@ -205,6 +280,137 @@ int run_simulation(const std::string& task_type, const Json::Value& params, cons
     }
 }
 
+int run_batch_simulation(const Json::Value& params, const std::string& output_format) {
+    try {
+        if (output_format == "json") {
+            // Un document JSON par ligne (NDJSON), émis dès la fin de chaque spot
+            // puis un bilan; les messages du solveur passent sur stderr
+            int out_fd = detach_stdout();
+            FILE* out_file = fdopen(out_fd, "w");
+            if (!out_file) {
+                throw std::runtime_error("Sortie JSON indisponible");
+            }
+            Json::StreamWriterBuilder builder;
+            builder["indentation"] = "";
+            auto write_line = [&](const Json::Value& document) {
+                std::string line = Json::writeString(builder, document) + "\n";
+                std::fwrite(line.data(), 1, line.size(), out_file);
+                std::fflush(out_file);
+            };
+            
+            size_t failures = run_batch(params, write_line);
+            Json::Value summary;
+            summary["success"] = failures == 0;
+            summary["task_type"] = "batch";
+            summary["spots"] = params["spots"].size();
+            summary["failed_spots"] = static_cast<Json::UInt64>(failures);
+            write_line(summary);
+            std::fclose(out_file);
+            return failures == 0 ? 0 : 1;
+        }
+        
+        size_t failures = run_batch(params, [](const Json::Value& output) {
+            std::cout << "Spot " << output["spot_id"].asString() << ": ";
+            if (output["success"].asBool()) {
+                std::cout << output["result"]["status"].asString() << ", "
+                          << output["result"]["iterations_completed"].asInt() << " itérations, exploitabilité "
+                          << output["result"]["final_exploitability"].asDouble() << "\n";
+            } else {
+                std::cout << "Erreur: " << output["error"].asString() << "\n";
+            }
+        });
+        std::cout << "\n=== Lot terminé: " << params["spots"].size() - failures << "/" << params["spots"].size()
+                  << " spots résolus ===" << std::endl;
+        return failures == 0 ? 0 : 1;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+int dump_strategy_file(const std::string& path) {
+    try {
+        StrategyFile file(path, true);
+        Json::StreamWriterBuilder builder;
+        std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+        writer->write(strategy_file_to_json(file), &std::cout);
+        std::cout << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+int query_strategy_file(const std::string& path) {
+    try {
+        StrategyStore store(path);
+        Json::StreamWriterBuilder writer;
+        writer["indentation"] = "";
+        Json::CharReaderBuilder reader_builder;
+        std::unique_ptr<Json::CharReader> reader(reader_builder.newCharReader());
+        
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+            Json::Value request;
+            Json::Value response;
+            std::string errors;
+            try {
+                if (!reader->parse(line.data(), line.data() + line.size(), &request, &errors)) {
+                    throw std::runtime_error("Requête JSON invalide: " + errors);
+                }
+                response = strategy_answer_json(store.query(parse_strategy_query(request)));
+            } catch (const std::exception& e) {
+                response = Json::Value();
+                response["error"] = e.what();
+            }
+            std::cout << Json::writeString(writer, response) << std::endl;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+void write_metrics_file(const std::string& path) {
+    if (path.empty()) {
+        return;
+    }
+    try {
+        metrics::write_prometheus_file(path);
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur: " << e.what() << std::endl;
+    }
+}
+
+void write_trace_file(const std::string& path) {
+    if (path.empty()) {
+        return;
+    }
+    try {
+        trace::write_file(path);
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur: " << e.what() << std::endl;
+    }
+}
+
+int merge_checkpoints(const std::string& output, const std::vector<std::string>& inputs) {
+    try {
+        CheckpointMergeSummary summary = merge_checkpoint_files(inputs, output);
+        std::cout << inputs.size() << " checkpoints fusionnés dans " << output << ": " << summary.infosets
+                  << " infosets, " << summary.iterations << " itérations" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
 int interactive_mode() {
     std::cout << "=== Mode Interactif du Solveur GTO ===" << std::endl;
     std::cout << "Bonjour depuis le PokerSolverBackend !" << std::endl;
@@ -247,12 +453,44 @@ int main(int argc, char* argv[]) {
     std::string task_type;
     std::string params_file;
     std::string output_format = "text";
+    bool serve = false;
+    std::string trace_file;
+    std::string strategy_json_file;
+    std::string strategy_query_file;
+    ProgressOptions progress_options;
+    ExportOptions export_options;
+    DaemonOptions daemon_options;
+    DistributedOptions distributed_options;
+    std::string worker_address;
+    std::string merged_checkpoint;
     
     // Options de ligne de commande
     struct option long_options[] = {
         {"task-type", required_argument, 0, 't'},
         {"params-file", required_argument, 0, 'p'},
         {"output-format", required_argument, 0, 'o'},
+        {"serve", no_argument, 0, 's'},
+        {"socket", required_argument, 0, 'u'},
+        {"workers", required_argument, 0, 'w'},
+        {"cached-trees", required_argument, 0, 'c'},
+        {"metrics-file", required_argument, 0, 'm'},
+        {"trace", required_argument, 0, 'T'},
+        {"progress-fd", required_argument, 0, 'P'},
+        {"progress-interval", required_argument, 0, 'I'},
+        {"strategy-diff-fd", required_argument, 0, 'D'},
+        {"strategy-diff-every", required_argument, 0, 'E'},
+        {"strategy-diff-threshold", required_argument, 0, 'H'},
+        {"export-strategy", required_argument, 0, 'X'},
+        {"strategy-bits", required_argument, 0, 'B'},
+        {"strategy-prune", required_argument, 0, 'R'},
+        {"strategy-to-json", required_argument, 0, 'J'},
+        {"query-strategy", required_argument, 0, 'Q'},
+        {"solution-cache", required_argument, 0, 'C'},
+        {"solution-cache-mb", required_argument, 0, 'M'},
+        {"coordinator", required_argument, 0, 'G'},
+        {"distributed-workers", required_argument, 0, 'N'},
+        {"worker", required_argument, 0, 'W'},
+        {"merge-checkpoints", required_argument, 0, 'K'},
         {"help", no_argument, 0, 'h'},
         {0, 0, 0, 0}
     };
@@ -260,7 +498,7 @@ int main(int argc, char* argv[]) {
     int option_index = 0;
     int c;
     
-    while ((c = getopt_long(argc, argv, "t:p:o:h", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "t:p:o:su:w:c:m:T:P:I:D:E:H:X:B:R:J:Q:C:M:G:N:W:K:h", long_options, &option_index)) != -1) {
         switch (c) {
             case 't':
                 task_type = optarg;
@@ -271,6 +509,88 @@ int main(int argc, char* argv[]) {
             case 'o':
                 output_format = optarg;
                 break;
+            case 's':
+                serve = true;
+                break;
+            case 'u':
+                daemon_options.socket_path = optarg;
+                break;
+            case 'w':
+                daemon_options.workers = std::atoi(optarg);
+                break;
+            case 'c':
+                daemon_options.cached_trees = static_cast<size_t>(std::max(0, std::atoi(optarg)));
+                break;
+            case 'm':
+                daemon_options.metrics_file = optarg;
+                break;
+            case 'T':
+                trace_file = optarg;
+                break;
+            case 'P':
+                progress_options.fd = std::atoi(optarg);
+                if (fcntl(progress_options.fd, F_GETFD) < 0) {
+                    std::cerr << "Erreur: --progress-fd " << optarg << " n'est pas un descripteur ouvert" << std::endl;
+                    return 1;
+                }
+                break;
+            case 'I':
+                progress_options.interval_ms = std::max(1, std::atoi(optarg));
+                break;
+            case 'D':
+                progress_options.strategy_diff_fd = std::atoi(optarg);
+                if (fcntl(progress_options.strategy_diff_fd, F_GETFD) < 0) {
+                    std::cerr << "Erreur: --strategy-diff-fd " << optarg << " n'est pas un descripteur ouvert" << std::endl;
+                    return 1;
+                }
+                break;
+            case 'E':
+                progress_options.strategy_diff_every = std::max(1, std::atoi(optarg));
+                break;
+            case 'H':
+                progress_options.strategy_diff_threshold = std::atof(optarg);
+                break;
+            case 'X':
+                export_options.strategy_file = optarg;
+                break;
+            case 'B':
+                export_options.format.value_bits = std::atoi(optarg);
+                if (export_options.format.value_bits != 8 && export_options.format.value_bits != 16) {
+                    std::cerr << "Erreur: --strategy-bits doit valoir 8 ou 16" << std::endl;
+                    return 1;
+                }
+                break;
+            case 'R':
+                export_options.format.prune_threshold = std::atof(optarg);
+                break;
+            case 'J':
+                strategy_json_file = optarg;
+                break;
+            case 'Q':
+                strategy_query_file = optarg;
+                break;
+            case 'C':
+                daemon_options.solution_cache_dir = optarg;
+                break;
+            case 'M':
+                daemon_options.solution_cache_mb = static_cast<size_t>(std::max(0, std::atoi(optarg)));
+                break;
+            case 'G':
+                distributed_options.address = optarg;
+                break;
+            case 'N':
+                distributed_options.workers = std::atoi(optarg);
+                if (distributed_options.workers < 1) {
+                    std::cerr << "Erreur: --distributed-workers doit valoir au moins 1" << std::endl;
+                    return 1;
+                }
+                break;
+            case 'W':
+                worker_address = optarg;
+                break;
+            case 'K':
+                merged_checkpoint = optarg;
+                break;
             case 'h':
                 print_usage(argv[0]);
                 return 0;
@@ -282,15 +602,64 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    if (!trace_file.empty()) {
+        trace::start();
+    }
+    
+    if (!merged_checkpoint.empty()) {
+        int status = merge_checkpoints(merged_checkpoint, std::vector<std::string>(argv + optind, argv + argc));
+        write_trace_file(trace_file);
+        return status;
+    }
+    
+    if (!strategy_json_file.empty()) {
+        return dump_strategy_file(strategy_json_file);
+    }
+    
+    if (!strategy_query_file.empty()) {
+        return query_strategy_file(strategy_query_file);
+    }
+    
+    if (!worker_address.empty()) {
+        int status = run_distributed_worker(worker_address);
+        write_metrics_file(daemon_options.metrics_file);
+        write_trace_file(trace_file);
+        return status;
+    }
+    
+    if (serve) {
+        int status;
+        {
+            SolverDaemon daemon(daemon_options);
+            status = daemon.run();
+        }
+        write_trace_file(trace_file);
+        return status;
+    }
+    
     // Si les paramètres de ligne de commande sont fournis, mode CLI
     if (!task_type.empty() && !params_file.empty()) {
+        int status;
         try {
             Json::Value params = load_params_file(params_file);
-            return run_simulation(task_type, params, output_format);
+            if (task_type == "batch") {
+                status = run_batch_simulation(params, output_format);
+            } else {
+                std::unique_ptr<SolutionCache> solution_cache;
+                if (!daemon_options.solution_cache_dir.empty()) {
+                    solution_cache = std::make_unique<SolutionCache>(daemon_options.solution_cache_dir,
+                                                                     uint64_t(daemon_options.solution_cache_mb) << 20);
+                }
+                status = run_simulation(task_type, params, output_format, progress_options, export_options,
+                                        solution_cache.get(), distributed_options);
+            }
         } catch (const std::exception& e) {
             std::cerr << "Erreur: " << e.what() << std::endl;
-            return 1;
+            status = 1;
         }
+        write_metrics_file(daemon_options.metrics_file);
+        write_trace_file(trace_file);
+        return status;
     }
     
     // Sinon, mode interactif
@@ -0,0 +1,51 @@
+#include "action_translation.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace poker {
+
+double pseudo_harmonic_probability(double a, double b, double x) {
+    if (x <= a) return 1.0;
+    if (x >= b) return 0.0;
+    return (b - x) * (1.0 + a) / ((b - a) * (1.0 + x));
+}
+
+BetTranslation translate_bet(const std::vector<Action>& actions, double amount, double pot) {
+    // Montants des relances et leurs indices dans actions, triés par montant
+    std::vector<std::pair<double, size_t>> raises;
+    for (size_t i = 0; i < actions.size(); ++i) {
+        if (actions[i].type == ActionType::RAISE) {
+            raises.emplace_back(actions[i].amount, i);
+        }
+    }
+    if (raises.empty()) {
+        throw std::runtime_error("Aucune relance possible pour un montant de " + std::to_string(amount));
+    }
+    if (!std::is_sorted(raises.begin(), raises.end())) {
+        std::sort(raises.begin(), raises.end());
+    }
+
+    auto upper = std::lower_bound(raises.begin(), raises.end(), std::make_pair(amount, size_t(0)),
+                                  [](const auto& a, const auto& b) { return a.first < b.first; });
+    if (upper == raises.begin()) {
+        return {upper->second, upper->second, 1.0};
+    }
+    if (upper == raises.end()) {
+        return {raises.back().second, raises.back().second, 1.0};
+    }
+    auto lower = std::prev(upper);
+    // Action == tolère 0.01 jeton: un montant d'historique arrondi reste exact
+    if (upper->first - amount < 0.01) {
+        return {upper->second, upper->second, 1.0};
+    }
+    if (amount - lower->first < 0.01) {
+        return {lower->second, lower->second, 1.0};
+    }
+
+    double scale = pot > 0.0 ? pot : 1.0;
+    double p = pseudo_harmonic_probability(lower->first / scale, upper->first / scale, amount / scale);
+    return {lower->second, upper->second, p};
+}
+
+} // namespace poker
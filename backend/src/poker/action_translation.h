@@ -0,0 +1,31 @@
+#pragma once
+
+#include "game_tree.h"
+#include <cstddef>
+#include <vector>
+
+namespace poker {
+
+// Traduction d'une relance hors abstraction (montant absent de
+// allowed_bet_sizes) vers les relances abstraites voisines, par le mapping
+// pseudo-harmonique (Ganzfried et Sandholm): pour des tailles en fraction
+// du pot A < x < B, x est traduit en A avec la probabilité
+//   f(x) = (B - x)(1 + A) / ((B - A)(1 + x))
+// et en B sinon. f(A) = 1, f(B) = 0, et la traduction résiste aux
+// exploitations par des tailles juste au-dessus ou au-dessous d'une taille
+// abstraite. Hors de l'intervalle des tailles abstraites, x est ramené à la
+// plus petite ou à la plus grande (tapis).
+struct BetTranslation {
+    size_t lower;              // Indices dans la liste d'actions du nœud
+    size_t upper;              // lower == upper: relance exacte ou ramenée
+    double lower_probability;  // Probabilité de jouer lower (1 si lower == upper)
+};
+
+// Probabilité de A pour x, tailles en fraction du pot (A < B)
+double pseudo_harmonic_probability(double a, double b, double x);
+
+// Relances voisines de amount parmi actions, recherche dichotomique sur les
+// montants. Lève std::runtime_error si actions ne contient aucune relance.
+BetTranslation translate_bet(const std::vector<Action>& actions, double amount, double pot);
+
+} // namespace poker
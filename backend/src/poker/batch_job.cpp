@@ -0,0 +1,122 @@
+#include "batch_job.h"
+#include "solve_job.h"
+#include "trace.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace poker {
+
+namespace {
+
+// Configuration par défaut complétée (ou remplacée membre à membre) par celle du spot
+Json::Value merge_config(const Json::Value& defaults, const Json::Value& overrides) {
+    Json::Value merged = defaults.isObject() ? defaults : Json::Value(Json::objectValue);
+    if (overrides.isObject()) {
+        for (const auto& name : overrides.getMemberNames()) {
+            merged[name] = overrides[name];
+        }
+    }
+    return merged;
+}
+
+struct UniqueSpot {
+    std::string task_type;
+    Json::Value params;                 // {"solver_config", "game_config"}
+    std::vector<size_t> spot_indices;   // Spots du lot qui ont ces paramètres
+};
+
+} // namespace
+
+size_t run_batch(const Json::Value& params, const std::function<void(const Json::Value&)>& on_result) {
+    const Json::Value& spots = params["spots"];
+    if (!spots.isArray() || spots.empty()) {
+        throw std::runtime_error("La tâche batch nécessite une liste \"spots\" non vide");
+    }
+
+    // Regrouper les spots identiques; jsoncpp écrit les membres triés: la clé est canonique
+    Json::StreamWriterBuilder writer;
+    writer["indentation"] = "";
+    std::vector<UniqueSpot> unique_spots;
+    std::map<std::string, size_t> spot_by_key;
+    std::vector<std::string> spot_ids(spots.size());
+    for (Json::ArrayIndex i = 0; i < spots.size(); ++i) {
+        const Json::Value& spot = spots[i];
+        spot_ids[i] = spot.get("id", std::to_string(i)).asString();
+
+        UniqueSpot candidate;
+        candidate.task_type = spot.get("task_type", params.get("task_type", "postflop")).asString();
+        candidate.params["solver_config"] = merge_config(params["solver_config"], spot["solver_config"]);
+        candidate.params["game_config"] = merge_config(params["game_config"], spot["game_config"]);
+
+        std::string key = candidate.task_type + '\n' + Json::writeString(writer, candidate.params);
+        auto found = spot_by_key.find(key);
+        if (found == spot_by_key.end()) {
+            found = spot_by_key.emplace(key, unique_spots.size()).first;
+            unique_spots.push_back(std::move(candidate));
+        }
+        unique_spots[found->second].spot_indices.push_back(i);
+    }
+
+    unsigned hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t num_threads = params.isMember("threads") ? std::max(1, params["threads"].asInt()) : hardware_threads;
+    num_threads = std::min(num_threads, unique_spots.size());
+    std::cout << "Lot de " << spots.size() << " spots (" << unique_spots.size() << " distincts) sur "
+              << num_threads << " threads" << std::endl;
+
+    auto abstraction = std::make_shared<BasicAbstraction>();
+    std::atomic<size_t> next_spot(0);
+    std::mutex result_mutex;
+    size_t failures = 0;
+
+    auto worker = [&](size_t index) {
+        trace::set_thread_name("batch worker " + std::to_string(index));
+        for (size_t u = next_spot++; u < unique_spots.size(); u = next_spot++) {
+            const UniqueSpot& spot = unique_spots[u];
+            trace::Span spot_span("spot", "batch");
+            spot_span.arg("spot_index", static_cast<int64_t>(spot.spot_indices.front()));
+            Json::Value output;
+            bool success = true;
+            try {
+                CFRConfig config = parse_solver_config(spot.params["solver_config"]);
+                std::string spot_dir = "spot_" + std::to_string(spot.spot_indices.front());
+                config.checkpoint_dir = config.checkpoint_dir.empty() ? spot_dir : config.checkpoint_dir + "/" + spot_dir;
+                GameState initial_state = parse_game_config(spot.params["game_config"]);
+                std::unique_ptr<CFRSolver> solver = create_task_solver(spot.task_type, abstraction, config,
+                                                                           spot.params["game_config"]);
+                CFRResult result = solver->solve(initial_state);
+                output = simulation_result_json(spot.task_type, spot.params, result,
+                                                solver->get_strategy(initial_state, 0));
+            } catch (const std::exception& e) {
+                output = simulation_error_json(e.what());
+                success = false;
+            }
+
+            std::lock_guard<std::mutex> lock(result_mutex);
+            for (size_t index : spot.spot_indices) {
+                output["spot_id"] = spot_ids[index];
+                output["spot_index"] = static_cast<Json::UInt64>(index);
+                on_result(output);
+                failures += success ? 0 : 1;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < num_threads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return failures;
+}
+
+} // namespace poker
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <json/json.h>
+#include <functional>
+
+namespace poker {
+
+// Tâche "batch": plusieurs spots d'un même fichier de paramètres, résolus en
+// parallèle sur un pool de threads commun.
+//
+//   {"threads": 4,
+//    "solver_config": {...}, "game_config": {...},   // valeurs par défaut
+//    "spots": [{"id": "100bb", "task_type": "postflop",
+//               "solver_config": {...}, "game_config": {"stack_size": 100}}, ...]}
+//
+// Les membres des configurations d'un spot remplacent ceux des valeurs par
+// défaut. Tous les spots partagent la même abstraction (tables de buckets);
+// les spots identiques (même type, mêmes configurations) ne sont résolus
+// qu'une fois. Les arbres de spots différents ne sont pas partagés: leurs
+// regrets n'ont pas le même sens. Les checkpoints d'un spot sont écrits
+// dans "spot_<spot_index>" sous solver_config.checkpoint_dir (répertoire
+// courant par défaut): deux spots résolus en même temps n'écrivent jamais
+// le même fichier.
+//
+// on_result reçoit, dès la fin de chaque spot, le document de
+// --output-format json complété de "spot_id" et "spot_index" (appels
+// sérialisés, dans l'ordre de fin). Retourne le nombre de spots en échec.
+// Lève std::runtime_error si "spots" est absent ou vide.
+size_t run_batch(const Json::Value& params, const std::function<void(const Json::Value&)>& on_result);
+
+} // namespace poker
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace poker {
+
+// CRC32 (polynôme IEEE 802.3), utilisé pour valider les fichiers binaires
+uint32_t crc32(const void* data, size_t size, uint32_t crc = 0);
+
+// Hachage FNV-1a 64 bits, stable entre les exécutions et les machines
+uint64_t fnv1a_64(const void* data, size_t size, uint64_t hash = 0xcbf29ce484222325ULL);
+inline uint64_t fnv1a_64(const std::string& str) { return fnv1a_64(str.data(), str.size()); }
+
+// Entiers à longueur variable (LEB128) et codage zigzag pour les entiers signés
+void put_varint(std::string& out, uint64_t value);
+// Avance ptr; lève std::runtime_error si la séquence dépasse end
+uint64_t get_varint(const char*& ptr, const char* end);
+
+inline uint64_t zigzag_encode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+inline int64_t zigzag_decode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Arrondit un offset au multiple supérieur de l'alignement (puissance de 2)
+inline uint64_t align_up(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace poker
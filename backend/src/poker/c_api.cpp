@@ -0,0 +1,184 @@
+#include "c_api.h"
+#include "solve_job.h"
+#include <json/json.h>
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace poker;
+
+struct poker_solver {
+    std::string task_type;
+    Json::Value params;
+    CFRConfig config;
+    GameState root;
+    std::shared_ptr<GameAbstraction> abstraction;
+    std::unique_ptr<CFRSolver> solver;
+    std::string result_json;
+    std::string strategy_json;
+};
+
+namespace {
+
+thread_local std::string last_error;
+
+std::string write_compact(const Json::Value& value) {
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return Json::writeString(builder, value);
+}
+
+// Exécute body en convertissant les exceptions en code d'erreur
+template <typename Body>
+int guarded(Body body) {
+    try {
+        last_error.clear();
+        return body();
+    } catch (const std::exception& e) {
+        last_error = e.what();
+    } catch (...) {
+        last_error = "Erreur inconnue";
+    }
+    return -1;
+}
+
+void require(const void* pointer, const char* name) {
+    if (!pointer) {
+        throw std::runtime_error(std::string(name) + " NULL");
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+int poker_solver_abi_version(void) {
+    return POKER_SOLVER_ABI_VERSION;
+}
+
+const char* poker_last_error(void) {
+    return last_error.c_str();
+}
+
+poker_solver* poker_solver_create(const char* task_type, const char* params_json) {
+    std::unique_ptr<poker_solver> handle;
+    int status = guarded([&] {
+        if (!task_type || !params_json) {
+            throw std::runtime_error("task_type et params_json sont requis");
+        }
+        Json::CharReaderBuilder builder;
+        std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+        Json::Value params;
+        std::string errors;
+        std::string text(params_json);
+        if (!reader->parse(text.data(), text.data() + text.size(), &params, &errors)) {
+            throw std::runtime_error("Erreur de parsing JSON: " + errors);
+        }
+
+        handle = std::make_unique<poker_solver>();
+        handle->task_type = task_type;
+        handle->params = params;
+        handle->config = parse_solver_config(params["solver_config"]);
+        handle->root = parse_game_config(params["game_config"]);
+        handle->abstraction = std::make_shared<BasicAbstraction>();
+        handle->solver = create_task_solver(handle->task_type, handle->abstraction, handle->config,
+                                            params["game_config"]);
+        return 0;
+    });
+    return status == 0 ? handle.release() : nullptr;
+}
+
+void poker_solver_destroy(poker_solver* solver) {
+    delete solver;
+}
+
+int poker_solver_load_checkpoint(poker_solver* solver, const char* path) {
+    return guarded([&] {
+        require(solver, "solver");
+        require(path, "path");
+        solver->solver->read_checkpoint(path);
+        return 0;
+    });
+}
+
+int poker_solver_run(poker_solver* solver, int iterations) {
+    return guarded([&] {
+        require(solver, "solver");
+        CFRSolver& cfr = *solver->solver;
+        cfr.clear_stop_request();
+        cfr.set_stopping_criteria(cfr.current_iteration() + std::max(0, iterations),
+                                  solver->config.target_exploitability);
+        CFRResult result = cfr.solve(solver->root);
+        std::vector<double> strategy = cfr.get_strategy(solver->root, solver->root.current_player);
+        solver->result_json = write_compact(simulation_result_json(solver->task_type, solver->params, result, strategy));
+        return result.iterations_completed;
+    });
+}
+
+void poker_solver_stop(poker_solver* solver) {
+    if (solver) {
+        solver->solver->request_stop();
+    }
+}
+
+int poker_solver_strategy(poker_solver* solver, const char* history, double* probabilities, int capacity) {
+    return guarded([&] {
+        require(solver, "solver");
+        GameState state = apply_action_history(solver->root, history ? history : "", *solver->abstraction);
+        if (state.is_terminal()) {
+            throw std::runtime_error("L'historique mène à un état terminal");
+        }
+        std::vector<double> strategy = solver->solver->get_strategy(state, state.current_player);
+        if (probabilities) {
+            std::copy_n(strategy.begin(), std::min<size_t>(strategy.size(), std::max(0, capacity)), probabilities);
+        }
+        return static_cast<int>(strategy.size());
+    });
+}
+
+const char* poker_solver_strategy_json(poker_solver* solver, const char* history) {
+    int status = guarded([&] {
+        require(solver, "solver");
+        GameState state = apply_action_history(solver->root, history ? history : "", *solver->abstraction);
+        if (state.is_terminal()) {
+            throw std::runtime_error("L'historique mène à un état terminal");
+        }
+        Json::Value output;
+        output["player"] = state.current_player;
+        output["actions"] = Json::Value(Json::arrayValue);
+        for (const auto& action : solver->abstraction->get_abstracted_actions(state)) {
+            output["actions"].append(action.to_string());
+        }
+        output["strategy"] = Json::Value(Json::arrayValue);
+        for (double probability : solver->solver->get_strategy(state, state.current_player)) {
+            output["strategy"].append(probability);
+        }
+        solver->strategy_json = write_compact(output);
+        return 0;
+    });
+    return status == 0 ? solver->strategy_json.c_str() : nullptr;
+}
+
+const char* poker_solver_result_json(poker_solver* solver) {
+    int status = guarded([&] {
+        require(solver, "solver");
+        if (solver->result_json.empty()) {
+            throw std::runtime_error("Aucune résolution effectuée");
+        }
+        return 0;
+    });
+    return status == 0 ? solver->result_json.c_str() : nullptr;
+}
+
+int poker_solver_export(poker_solver* solver, const char* path) {
+    return guarded([&] {
+        require(solver, "solver");
+        require(path, "path");
+        solver->solver->write_checkpoint(path);
+        return 0;
+    });
+}
+
+} // extern "C"
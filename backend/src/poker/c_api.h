@@ -0,0 +1,83 @@
+#ifndef POKER_SOLVER_C_API_H
+#define POKER_SOLVER_C_API_H
+
+/*
+ * Interface C stable de libpokersolver, pour une utilisation dans le même
+ * processus (ctypes, cffi, autres langages) sans lancer PokerSolver.
+ *
+ * Les paramètres sont le même document JSON que --params-file
+ * ({"solver_config": {...}, "game_config": {...}}). Les fonctions qui
+ * échouent retournent -1 ou NULL; poker_last_error() donne alors le message
+ * (propre au thread appelant). Un solveur ne doit être utilisé que par un
+ * thread à la fois, sauf poker_solver_stop() qui peut interrompre
+ * poker_solver_run() depuis un autre thread.
+ *
+ * Les chaînes retournées appartiennent à la bibliothèque: celles d'un
+ * solveur restent valides jusqu'à l'appel suivant sur ce solveur.
+ *
+ * Exemple (Python):
+ *   lib = ctypes.CDLL("libpokersolver.so")
+ *   lib.poker_solver_create.restype = ctypes.c_void_p
+ *   solver = lib.poker_solver_create(b"preflop", json.dumps(params).encode())
+ *   lib.poker_solver_run(ctypes.c_void_p(solver), 100)
+ */
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#define POKER_API __declspec(dllexport)
+#else
+#define POKER_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Incrémentée à chaque changement incompatible de cette interface */
+#define POKER_SOLVER_ABI_VERSION 1
+
+typedef struct poker_solver poker_solver;
+
+POKER_API int poker_solver_abi_version(void);
+
+/* Message de la dernière erreur du thread appelant ("" si aucune) */
+POKER_API const char* poker_last_error(void);
+
+/* task_type: "preflop" ou "postflop". NULL en cas d'erreur. */
+POKER_API poker_solver* poker_solver_create(const char* task_type, const char* params_json);
+POKER_API void poker_solver_destroy(poker_solver* solver);
+
+/* Reprend l'état d'un checkpoint (format de checkpoint.h) avant de continuer.
+ * Retourne 0, ou -1 si le fichier est absent, corrompu ou d'un autre solveur. */
+POKER_API int poker_solver_load_checkpoint(poker_solver* solver, const char* path);
+
+/* Exécute iterations itérations de plus. Retourne le nombre total
+ * d'itérations effectuées, ou -1. */
+POKER_API int poker_solver_run(poker_solver* solver, int iterations);
+
+/* Interrompt poker_solver_run() à la fin de l'itération en cours */
+POKER_API void poker_solver_stop(poker_solver* solver);
+
+/* Stratégie moyenne au nœud atteint par history (voir apply_action_history:
+ * "c r3 x", vide pour la racine), pour le joueur qui doit agir. Écrit au
+ * plus capacity probabilités et retourne le nombre d'actions du nœud (à
+ * comparer à capacity, comme snprintf), ou -1. */
+POKER_API int poker_solver_strategy(poker_solver* solver, const char* history,
+                                    double* probabilities, int capacity);
+
+/* Même nœud en JSON: {"player", "actions": [...], "strategy": [...]} */
+POKER_API const char* poker_solver_strategy_json(poker_solver* solver, const char* history);
+
+/* Document JSON du dernier poker_solver_run() (celui de --output-format json) */
+POKER_API const char* poker_solver_result_json(poker_solver* solver);
+
+/* Exporte tous les infosets dans un checkpoint (format de checkpoint.h).
+ * Retourne 0, ou -1 si le fichier ne peut pas être écrit. */
+POKER_API int poker_solver_export(poker_solver* solver, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POKER_SOLVER_C_API_H */
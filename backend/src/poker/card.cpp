@@ -1,4 +1,5 @@
 #include "card.h"
+#include <algorithm>
 #include <stdexcept>
 #include <sstream>
 
@@ -107,4 +108,26 @@ std::string board_to_string(const Board& board) {
     return oss.str();
 }
 
+std::vector<Card> parse_cards(const std::string& str) {
+    std::string compact;
+    for (char c : str) {
+        if (c != ' ' && c != ',' && c != '\t') {
+            compact += c;
+        }
+    }
+    if (compact.size() % 2 != 0) {
+        throw std::invalid_argument("Invalid card string: " + str);
+    }
+    
+    std::vector<Card> cards;
+    for (size_t i = 0; i < compact.size(); i += 2) {
+        Card card(compact.substr(i, 2));
+        if (std::find(cards.begin(), cards.end(), card) != cards.end()) {
+            throw std::invalid_argument("Duplicate card: " + card.to_string());
+        }
+        cards.push_back(card);
+    }
+    return cards;
+}
+
 } // namespace poker
@@ -46,6 +46,9 @@ using Board = std::vector<Card>;
 std::vector<Card> all_cards();
 std::string hand_to_string(const Hand& hand);
 std::string board_to_string(const Board& board);
+// "As Kd 7h" ou "AsKd7h" (espaces et virgules ignorés); lève
+// std::invalid_argument pour une carte invalide ou répétée
+std::vector<Card> parse_cards(const std::string& str);
 
 } // namespace poker
 
@@ -1,11 +1,17 @@
 #include "cfr_solver.h"
 #include "evaluator.h"
+#include "binary_io.h"
 #include <sstream>
 #include <chrono>
 #include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
 #include <fstream>
 #include <iostream>
 #include <limits> // Pour std::numeric_limits
+#include <thread>
+#include <sys/stat.h>
 
 namespace poker {
 
@@ -15,38 +21,626 @@ std::string CFRConfig::to_string() const {
         << ", target_exploitability=" << target_exploitability
         << ", use_chance_sampling=" << use_chance_sampling
         << ", use_discounting=" << use_discounting
+        << ", num_threads=" << num_threads
+        << ", seed=" << seed
+        << ", use_baselines=" << use_baselines
         << "}";
     return oss.str();
 }
 
+uint64_t CFRConfig::hash() const {
+    // max_iterations, target_exploitability et la politique de checkpoint peuvent
+    // changer d'une exécution à l'autre sans invalider les regrets accumulés.
+    uint64_t h = fnv1a_64(&use_chance_sampling, sizeof(use_chance_sampling));
+    h = fnv1a_64(&use_discounting, sizeof(use_discounting), h);
+    h = fnv1a_64(&alpha, sizeof(alpha), h);
+    h = fnv1a_64(&beta, sizeof(beta), h);
+    // Ajoutés seulement s'ils sont actifs: empreintes des checkpoints existants inchangées
+    if (use_baselines) {
+        h = fnv1a_64(&use_baselines, sizeof(use_baselines), h);
+        h = fnv1a_64(&baseline_learning_rate, sizeof(baseline_learning_rate), h);
+    }
+    return h;
+}
+
 std::string CFRResult::to_string() const {
     std::ostringstream oss;
     oss << "CFRResult{iterations=" << iterations_completed
         << ", exploitability=" << final_exploitability
         << ", time=" << convergence_time_seconds << "s"
         << ", converged=" << converged
+        << ", infosets=" << num_infosets
+        << ", memory=" << infoset_memory_bytes
+        << ", huge_pages=" << huge_page_bytes
         << "}";
     return oss.str();
 }
 
+namespace {
+
+uint64_t random_seed() {
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32) | device();
+}
+
+// Flux des parties aléatoires hors itération (sampled_rollout sans générateur)
+constexpr uint32_t ROLLOUT_STREAM = 1;
+
+} // namespace
+
 // CFRSolver base implementation
 CFRSolver::CFRSolver(std::shared_ptr<GameAbstraction> abstraction, const CFRConfig& config)
-    : abstraction_(abstraction), config_(config), current_iteration_(0) {}
+    : abstraction_(abstraction), config_(config), current_iteration_(0),
+      seed_(config.seed ? config.seed : random_seed()), node_memory_bytes_(0),
+      last_memory_usage_(SIZE_MAX), memory_limited_traversal_(false), rollout_rng_(seed_, 0, ROLLOUT_STREAM),
+      stop_requested_(false), iteration_callback_every_(0), progress_iteration_(0),
+      progress_exploitability_(std::numeric_limits<double>::quiet_NaN()), progress_infosets_(0),
+      progress_memory_bytes_(0), concurrent_traversal_(false) {
+    infoset_store_.use_huge_pages(config_.infoset_huge_pages);
+    if (!config_.infoset_storage_dir.empty()) {
+        try {
+            infoset_store_.use_backing_file(config_.infoset_storage_dir,
+                                            config_.infoset_resident_mb * 1024 * 1024);
+        } catch (const std::exception& e) {
+            std::cerr << "Erreur: " << e.what() << " (stockage en mémoire utilisé)" << std::endl;
+        }
+    }
+}
 
-std::shared_ptr<GameNode> CFRSolver::get_or_create_node(const GameState& state, int player) {
+GameNode* CFRSolver::get_or_create_node(const GameState& state, int player, double* reserved_values) {
     std::string key = state_to_key(state, player);
     
+    // Mode multithread: recherche sans verrou, puis création sous verrou
+    // (un autre thread a pu créer le nœud entre-temps)
+    uint64_t hash = 0;
+    std::unique_lock<std::mutex> creation_lock;
+    if (concurrent_traversal_) {
+        hash = fnv1a_64(key);
+        if (GameNode* node = concurrent_nodes_->find(hash, key)) {
+            return node;
+        }
+        creation_lock = std::unique_lock<std::mutex>(node_creation_mutex_);
+    }
+    
+    auto it = node_map_.find(key);
+    if (it != node_map_.end()) {
+        infoset_store_.touch(it->second->regret_sum.data());
+        return it->second.get();
+    }
+    if (memory_limited_traversal_) {
+        return nullptr;
+    }
+    
+    size_t mapped_bytes = 0;
+    auto allocate_values = [this, &key, &mapped_bytes, reserved_values](size_t num_actions) -> double* {
+        if (resume_checkpoint_) {
+            const CheckpointIndexEntry* entry = resume_checkpoint_->find(key);
+            if (entry && entry->num_actions == num_actions) {
+                if (!infoset_store_.file_backed()) {
+                    // Pages copiées à l'écriture (MAP_PRIVATE): comptées comme mémoire du nœud
+                    mapped_bytes = 2 * num_actions * sizeof(double);
+                    return resume_checkpoint_->values(*entry);
+                }
+                // Hors mémoire: copier dans le fichier de stockage pour que les
+                // valeurs suivent l'ordre de traversée et restent évictables
+                double* values = reserved_values ? reserved_values : infoset_store_.allocate(2 * num_actions);
+                std::copy_n(resume_checkpoint_->values(*entry), 2 * num_actions, values);
+                return values;
+            }
+        }
+        return reserved_values ? reserved_values : infoset_store_.allocate(2 * num_actions);
+    };
+    
+    auto node = std::allocate_shared<GameNode>(std::pmr::polymorphic_allocator<GameNode>(&node_pool_),
+                                               state, player, allocate_values);
+    if (uses_action_baselines()) {
+        node->baseline.assign(node->actions.size() * state.num_players, 0.0);
+    }
+    auto inserted = node_map_.emplace(key, node).first;
+    if (concurrent_traversal_) {
+        concurrent_nodes_->insert(hash, &inserted->first, node.get());
+    }
+    metrics::increment(metrics::Counter::INFOSETS_CREATED);
+    
+    // Bloc de contrôle (avec son allocateur) et nœud consécutifs dans le pool;
+    // entrée de la table: pointeur suivant, clé, shared_ptr et hash mis en cache
+    node_memory_bytes_ += align_up(sizeof(GameNode) + 3 * sizeof(void*), alignof(std::max_align_t)) + node->heap_bytes() +
+                          heap_allocation_size(sizeof(void*) + sizeof(key) + sizeof(node) + sizeof(size_t)) +
+                          (key.size() > 15 ? heap_allocation_size(key.size() + 1) : 0) + mapped_bytes;
+    
+    if (config_.memory_limit_mb && infoset_memory_bytes() > memory_limit_bytes()) {
+        if (config_.memory_limit_policy == MemoryLimitPolicy::FAIL) {
+            throw MemoryLimitExceeded("Limite mémoire de " + std::to_string(config_.memory_limit_mb) +
+                                      " Mo dépassée pendant l'itération " + std::to_string(current_iteration_));
+        }
+        // SPILL attend la fin de l'itération pour décharger; d'ici là, plus de nouveaux nœuds
+        memory_limited_traversal_ = true;
+    }
+    return node.get();
+}
+
+void CFRSolver::link_children(GameNode& node, const GameState& state, const std::vector<Action>& actions) {
+    // Limite mémoire atteinte: pas de nouvelles réservations, les enfants
+    // existants restent accessibles par leur clé. Mode multithread: pas de
+    // liens, le vecteur children serait modifié pendant sa lecture.
+    if (!node.children.empty() || memory_limited_traversal_ || concurrent_traversal_) {
+        return;
+    }
+    
+    // Les nœuds enfants ne sont créés qu'à leur première visite (MCCFR n'en
+    // visite qu'une partie); seules leurs valeurs sont réservées ici
+    std::vector<size_t> num_values(actions.size(), 0);
+    size_t total = 0;
+    for (size_t i = 0; i < actions.size(); ++i) {
+        GameState next_state = state.apply_action(actions[i]);
+        if (!next_state.is_terminal()) {
+            num_values[i] = 2 * next_state.get_legal_actions().size();
+            total += num_values[i];
+        }
+    }
+    
+    double* block = total ? infoset_store_.allocate(total) : nullptr;
+    node.children.resize(actions.size(), GameNode::Child{nullptr, nullptr});
+    for (size_t i = 0; i < actions.size(); ++i) {
+        if (num_values[i]) {
+            node.children[i].values = block;
+            block += num_values[i];
+        }
+    }
+    node_memory_bytes_ += heap_allocation_size(node.children.capacity() * sizeof(GameNode::Child));
+}
+
+GameNode* CFRSolver::child_node(GameNode& node, size_t i, const GameState& next_state) {
+    if (i >= node.children.size() || concurrent_traversal_) {
+        return nullptr;
+    }
+    GameNode::Child& child = node.children[i];
+    if (!child.node && child.values) {
+        child.node = get_or_create_node(next_state, next_state.current_player, child.values);
+        // Infoset déjà existant (transposition) ou repris: précharger ses vraies valeurs
+        if (child.node && !child.node->regret_sum.empty()) {
+            child.values = child.node->regret_sum.data();
+        }
+    }
+    return child.node;
+}
+
+void CFRSolver::reset_nodes() {
+    // Les nœuds du pool doivent être détruits avant la libération du pool
+    concurrent_nodes_.reset();
+    std::unordered_map<std::string, std::shared_ptr<GameNode>>().swap(node_map_);
+    node_pool_.release();
+    infoset_store_.clear();
+    node_memory_bytes_ = 0;
+    last_memory_usage_ = SIZE_MAX;
+}
+
+void CFRSolver::reset_values() {
+    finish_checkpoints();
+    if (resume_checkpoint_) {
+        // Des infosets ne vivent encore que dans le checkpoint repris
+        reset_nodes();
+        resume_checkpoint_.reset();
+    } else {
+        for (auto& [key, node] : node_map_) {
+            std::fill(node->regret_sum.begin(), node->regret_sum.end(), 0.0);
+            std::fill(node->strategy_sum.begin(), node->strategy_sum.end(), 0.0);
+        }
+    }
+    current_iteration_ = 0;
+    progress_iteration_ = 0;
+    progress_exploitability_ = std::numeric_limits<double>::quiet_NaN();
+    memory_limited_traversal_ = false;
+    memory_limit_message_.clear();
+    stop_requested_ = false;
+}
+
+void CFRSolver::set_stopping_criteria(int max_iterations, double target_exploitability) {
+    config_.max_iterations = max_iterations;
+    config_.target_exploitability = target_exploitability;
+}
+
+void CFRSolver::begin_concurrent_traversal() {
+    // Index reconstruit depuis node_map_ s'il est trop chargé ou si des nœuds
+    // ont été créés hors du mode multithread
+    if (!concurrent_nodes_ || concurrent_nodes_->size() != node_map_.size() || concurrent_nodes_->needs_rebuild()) {
+        concurrent_nodes_ = std::make_unique<ConcurrentNodeIndex>(node_map_.size());
+        for (const auto& [key, node] : node_map_) {
+            concurrent_nodes_->insert(fnv1a_64(key), &key, node.get());
+        }
+    }
+    concurrent_traversal_ = true;
+}
+
+int CFRSolver::traversal_threads() const {
+    if (config_.num_threads <= 1) {
+        return 1;
+    }
+    const char* option = nullptr;
+    if (config_.profile_hardware_counters) {
+        option = "profile_hardware_counters";
+    } else if (!config_.infoset_storage_dir.empty()) {
+        option = "infoset_storage_dir";
+    } else if (config_.memory_limit_mb && config_.memory_limit_policy != MemoryLimitPolicy::FAIL) {
+        option = "memory_limit_policy";
+    }
+    if (option) {
+        std::cerr << "Avertissement: num_threads ignoré avec " << option
+                  << " (résolution sur un seul thread)" << std::endl;
+        return 1;
+    }
+    return config_.num_threads;
+}
+
+int CFRSolver::parallel_block_end(int first, int last, int measure_every) const {
+    auto next_multiple = [first](int every) { return (first + every - 1) / every * every; };
+    if (measure_every > 0) {
+        last = std::min(last, next_multiple(measure_every));
+    }
+    if (config_.checkpoint_frequency > 0) {
+        last = std::min(last, next_multiple(config_.checkpoint_frequency));
+    }
+    if (iteration_callback_) {
+        last = std::min(last, next_multiple(iteration_callback_every_));
+    }
+    return last;
+}
+
+size_t CFRSolver::infoset_memory_bytes() const {
+    // Les blocs de l'arène sont mis à zéro à la demande: seule la partie allouée est résidente
+    size_t store_bytes = infoset_store_.file_backed() ? config_.infoset_resident_mb * 1024 * 1024
+                                                      : infoset_store_.allocated_bytes();
+    return node_memory_bytes_ + node_map_.bucket_count() * sizeof(void*) + store_bytes;
+}
+
+std::vector<double> CFRSolver::sampled_rollout(GameState state, CounterRng& rng) {
+    while (!state.is_terminal()) {
+        std::vector<Action> actions = abstraction_->get_abstracted_actions(state);
+        if (actions.empty()) {
+            return std::vector<double>(state.num_players, 0.0);
+        }
+        state = state.apply_action(actions[rng.below(static_cast<uint32_t>(actions.size()))]);
+    }
+    return state.get_payoffs();
+}
+
+bool CFRSolver::enforce_memory_limit(int iteration) {
+    if (!config_.memory_limit_mb) {
+        return false;
+    }
+    
+    // L'itération suivante devrait croître d'autant que la précédente. La première
+    // itération après le démarrage ou un débordement construit l'arbre visité et
+    // n'est pas représentative: pas de projection tant qu'aucune mesure n'existe.
+    size_t usage = infoset_memory_bytes();
+    size_t growth = (last_memory_usage_ != SIZE_MAX && usage > last_memory_usage_) ? usage - last_memory_usage_ : 0;
+    last_memory_usage_ = usage;
+    if (usage + growth <= memory_limit_bytes() && !memory_limited_traversal_) {
+        return false;
+    }
+    
+    switch (config_.memory_limit_policy) {
+        case MemoryLimitPolicy::FAIL:
+            fail_on_memory_limit(iteration);
+            return true;
+        case MemoryLimitPolicy::SPILL:
+            spill_infosets(iteration);
+            return false;
+        case MemoryLimitPolicy::SAMPLE:
+            memory_limited_traversal_ = true;
+            if (memory_limit_message_.empty()) {
+                memory_limit_message_ = "Limite mémoire atteinte: traversées échantillonnées au-delà de " +
+                                        std::to_string(node_map_.size()) + " infosets";
+                std::cerr << "Avertissement: " << memory_limit_message_ << std::endl;
+            }
+            return false;
+    }
+    return false;
+}
+
+void CFRSolver::fail_on_memory_limit(int completed_iteration) {
+    finish_checkpoints();
+    current_iteration_ = completed_iteration;
+    
+    std::string filename =
+        checkpoint_path("checkpoint_" + std::to_string(completed_iteration) + "_memory_limit.bin");
+    save_checkpoint(filename);
+    
+    memory_limit_message_ = "Limite mémoire atteinte (" + std::to_string(infoset_memory_bytes() / (1024 * 1024)) +
+                            " Mo utilisés, limite " + std::to_string(config_.memory_limit_mb) +
+                            " Mo), reprise possible depuis " + filename;
+    std::cerr << "Erreur: " << memory_limit_message_ << std::endl;
+}
+
+void CFRSolver::spill_infosets(int iteration) {
+    finish_checkpoints();
+    
+    std::string name = "spill_" + std::to_string(iteration) + ".bin";
+    std::string filename = config_.infoset_storage_dir.empty() ? checkpoint_path(name)
+                                                               : config_.infoset_storage_dir + "/" + name;
+    size_t usage = infoset_memory_bytes();
+    
+    std::shared_ptr<MappedCheckpoint> spilled;
+    try {
+        // Format brut: le fichier est mappé tel quel et sert de stockage à la reprise des nœuds
+        CheckpointSnapshot snapshot = make_checkpoint_snapshot();
+        write_checkpoint_file(snapshot, filename);
+        spilled = std::make_shared<MappedCheckpoint>(filename, false);
+        std::remove(filename.c_str()); // Le mapping garde le contenu accessible
+    } catch (const std::exception& e) {
+        std::remove(filename.c_str());
+        std::cerr << "Erreur: Débordement sur disque impossible (" << e.what() 
+                  << "), traversées échantillonnées" << std::endl;
+        memory_limited_traversal_ = true;
+        return;
+    }
+    
+    // Les nœuds sont recréés à la prochaine visite: seuls les infosets froids restent sur disque
+    reset_nodes();
+    resume_checkpoint_ = spilled;
+    memory_limited_traversal_ = false;
+    
+    std::cout << "Débordement sur disque: " << spilled->num_infosets() << " infosets, "
+              << usage / (1024 * 1024) << " Mo libérés" << std::endl;
+}
+
+void CFRSolver::fill_memory_stats(CFRResult& result) const {
+    result.num_infosets = node_map_.size();
+    result.infoset_memory_bytes = infoset_memory_bytes();
+    result.huge_page_bytes = infoset_store_.huge_page_bytes();
+    if (config_.infoset_huge_pages && result.huge_page_bytes == 0 && infoset_store_.allocated_bytes() > 0) {
+        std::cerr << "Avertissement: Pages de 2 Mo demandées mais non obtenues pour les infosets" << std::endl;
+    }
+}
+
+void CFRSolver::start_profiling() {
+    profiler_.reset();
+    if (config_.profile_hardware_counters) {
+        profiler_ = std::make_unique<PhaseProfiler>();
+        if (!profiler_->profile().error.empty()) {
+            std::cerr << "Avertissement: Profilage matériel partiel: " << profiler_->profile().error << std::endl;
+        }
+    }
+}
+
+void CFRSolver::finish_profiling(CFRResult& result) {
+    if (profiler_) {
+        result.hardware_profile = profiler_->profile();
+        profiler_.reset();
+    }
+}
+
+std::string CFRSolver::status_message(bool converged) const {
+    if (!memory_limit_message_.empty()) {
+        return memory_limit_message_;
+    }
+    if (stop_requested_ && !converged) {
+        return "Stopped";
+    }
+    return converged ? "Converged" : "Max iterations reached";
+}
+
+void CFRSolver::end_iteration(int iteration) {
+    progress_iteration_.store(iteration, std::memory_order_relaxed);
+    progress_infosets_.store(node_map_.size(), std::memory_order_relaxed);
+    progress_memory_bytes_.store(infoset_memory_bytes(), std::memory_order_relaxed);
+    if (iteration_callback_ && iteration % iteration_callback_every_ == 0) {
+        iteration_callback_(iteration);
+    }
+}
+
+void CFRSolver::set_iteration_callback(int every, IterationCallback callback) {
+    iteration_callback_every_ = std::max(1, every);
+    iteration_callback_ = std::move(callback);
+}
+
+void CFRSolver::for_each_infoset(const std::function<void(const std::string& key, const GameNode& node)>& visit) const {
+    for (const auto& [key, node] : node_map_) {
+        visit(key, *node);
+    }
+}
+
+CFRSolver::Progress CFRSolver::progress() const {
+    return Progress{progress_iteration_.load(std::memory_order_relaxed),
+                    progress_exploitability_.load(std::memory_order_relaxed),
+                    progress_infosets_.load(std::memory_order_relaxed),
+                    progress_memory_bytes_.load(std::memory_order_relaxed)};
+}
+
+void CFRSolver::report_progress(const char* label, int iteration, double exploitability) const {
+    progress_exploitability_.store(exploitability, std::memory_order_relaxed);
+    std::cout << label << iteration << ": Exploitability = " << exploitability << std::endl;
+    if (progress_callback_) {
+        progress_callback_(iteration, exploitability);
+    }
+}
+
+double CFRSolver::measure_exploitability(const GameState& root_state) const {
+    metrics::ScopedTimer timer(metrics::Timer::EXPLOITABILITY);
+    trace::Span span("exploitability", "cfr");
+    PhaseProfiler::Scope phase(profiler_.get(), ProfilePhase::EXPLOITABILITY);
+    return calculate_exploitability(root_state);
+}
+
+double CFRSolver::final_exploitability(const GameState& root_state) const {
+    if (stop_requested_) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return measure_exploitability(root_state);
+}
+
+std::vector<double> CFRSolver::find_average_strategy(const std::string& key) const {
     auto it = node_map_.find(key);
     if (it != node_map_.end()) {
-        return it->second;
+        return it->second->get_average_strategy();
+    }
+    
+    if (resume_checkpoint_) {
+        // Infoset repris mais pas encore visité: lire directement les valeurs mappées
+        const CheckpointIndexEntry* entry = resume_checkpoint_->find(key);
+        if (entry && entry->num_actions > 0) {
+            const double* strategy_sum = resume_checkpoint_->values(*entry) + entry->num_actions;
+            double normalizing_sum = 0.0;
+            for (uint32_t i = 0; i < entry->num_actions; ++i) {
+                normalizing_sum += strategy_sum[i];
+            }
+            
+            std::vector<double> strategy(entry->num_actions, 1.0 / entry->num_actions);
+            if (normalizing_sum > 0) {
+                for (uint32_t i = 0; i < entry->num_actions; ++i) {
+                    strategy[i] = strategy_sum[i] / normalizing_sum;
+                }
+            }
+            return strategy;
+        }
+    }
+    
+    return {};
+}
+
+CheckpointSnapshot CFRSolver::make_checkpoint_snapshot() const {
+    CheckpointSnapshot snapshot;
+    snapshot.solver_type = static_cast<uint32_t>(solver_type());
+    snapshot.config_hash = config_.hash();
+    snapshot.iteration = static_cast<uint64_t>(current_iteration_);
+    snapshot.solver_state = save_solver_state();
+    
+    snapshot.index.reserve(node_map_.size());
+    for (const auto& pair : node_map_) {
+        const GameNode& node = *pair.second;
+        snapshot.add_infoset(pair.first, node.regret_sum.data(), node.strategy_sum.data(),
+                             node.regret_sum.size());
+    }
+    
+    // Infosets repris qui n'ont pas encore été liés à un nœud
+    if (resume_checkpoint_) {
+        for (size_t i = 0; i < resume_checkpoint_->num_infosets(); ++i) {
+            const CheckpointIndexEntry& entry = resume_checkpoint_->entry(i);
+            std::string key = resume_checkpoint_->key_of(entry);
+            if (node_map_.count(key)) continue;
+            
+            const double* values = resume_checkpoint_->values(entry);
+            snapshot.add_infoset(key, values, values + entry.num_actions, entry.num_actions);
+        }
+    }
+    
+    return snapshot;
+}
+
+bool CFRSolver::save_checkpoint(const std::string& filename) const {
+    try {
+        write_checkpoint(filename);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void CFRSolver::write_checkpoint(const std::string& filename) const {
+    metrics::ScopedTimer timer(metrics::Timer::CHECKPOINT);
+    trace::Span span("checkpoint", "checkpoint");
+    CheckpointSnapshot snapshot = make_checkpoint_snapshot();
+    // Sauvegarde explicite: toujours autonome (pas de base delta)
+    write_checkpoint_file(snapshot, filename, checkpoint_encoding());
+    std::cout << "Checkpoint sauvegardé: " << filename << std::endl;
+}
+
+CheckpointEncoding CFRSolver::checkpoint_encoding() const {
+    CheckpointEncoding encoding;
+    encoding.compact = config_.compact_checkpoints;
+    encoding.quantization_step = config_.checkpoint_quantization_step;
+    encoding.keyframe_interval = config_.checkpoint_keyframe_interval;
+    return encoding;
+}
+
+bool CFRSolver::load_checkpoint(const std::string& filename) {
+    try {
+        read_checkpoint(filename);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void CFRSolver::read_checkpoint(const std::string& filename) {
+    auto checkpoint = std::make_shared<MappedCheckpoint>(filename, config_.verify_checkpoint_checksums);
+    
+    if (checkpoint->header().solver_type != static_cast<uint32_t>(solver_type())) {
+        throw std::runtime_error("Le checkpoint " + filename + " a été produit par un autre type de solveur");
     }
+    if (checkpoint->header().config_hash != config_.hash()) {
+        std::cerr << "Avertissement: Le checkpoint " << filename 
+                  << " a été produit avec une configuration différente" << std::endl;
+    }
+    
+    current_iteration_ = static_cast<int>(checkpoint->header().iteration);
+    restore_solver_state(checkpoint->solver_state());
+    
+    // Aucune désérialisation: les nœuds seront recréés avec leur vrai GameState
+    // lors des traversées et liés aux valeurs mappées (voir get_or_create_node)
+    reset_nodes();
+    resume_checkpoint_ = checkpoint;
     
-    auto node = std::make_shared<GameNode>(state, player);
-    node_map_[key] = node;
-    return node;
+    std::cout << "Checkpoint chargé: " << filename << " (" 
+              << checkpoint->num_infosets() << " infosets)" << std::endl;
+}
+
+void CFRSolver::checkpoint_if_due(int iteration) {
+    if (config_.checkpoint_frequency <= 0 || iteration % config_.checkpoint_frequency != 0) {
+        return;
+    }
+    
+    metrics::ScopedTimer timer(metrics::Timer::CHECKPOINT);
+    trace::Span span("checkpoint", "checkpoint");
+    std::string filename = checkpoint_path("checkpoint_" + std::to_string(iteration) + ".bin");
+    
+    // Le snapshot est pris ici, entre deux itérations; seule l'écriture est différée.
+    // Le writer conserve la trame précédente, base du codage delta en mode compact.
+    if (!checkpoint_writer_) {
+        checkpoint_writer_ = std::make_unique<CheckpointWriter>(checkpoint_encoding(), config_.async_checkpoints);
+    }
+    checkpoint_writer_->submit(make_checkpoint_snapshot(), filename);
+}
+
+std::string CFRSolver::checkpoint_path(const std::string& name) const {
+    if (config_.checkpoint_dir.empty()) {
+        return name;
+    }
+    // Chaque niveau manquant, du plus haut au plus bas
+    for (size_t slash = config_.checkpoint_dir.find('/', 1); ; slash = config_.checkpoint_dir.find('/', slash + 1)) {
+        ::mkdir(config_.checkpoint_dir.substr(0, slash).c_str(), 0755);
+        if (slash == std::string::npos) {
+            break;
+        }
+    }
+    return config_.checkpoint_dir + "/" + name;
+}
+
+void CFRSolver::set_checkpoint_dir(const std::string& directory) {
+    if (directory == config_.checkpoint_dir) {
+        return;
+    }
+    // Les bases d'un delta sont cherchées dans le répertoire du delta
+    finish_checkpoints();
+    checkpoint_writer_.reset();
+    config_.checkpoint_dir = directory;
+}
+
+void CFRSolver::finish_checkpoints() {
+    if (checkpoint_writer_) {
+        metrics::ScopedTimer timer(metrics::Timer::CHECKPOINT);
+        trace::Span span("checkpoint", "checkpoint");
+        checkpoint_writer_->flush();
+    }
 }
 
 std::string CFRSolver::state_to_key(const GameState& state, int player) const {
+    return infoset_key(state, player);
+}
+
+std::string infoset_key(const GameState& state, int player) {
     std::ostringstream oss;
     oss << "p" << player << "_s" << state.street << "_pot" << state.pot 
         << "_cp" << state.current_player << "_board" << board_to_string(state.board);
@@ -64,6 +658,9 @@ VanillaCFR::VanillaCFR(std::shared_ptr<GameAbstraction> abstraction, const CFRCo
     : CFRSolver(abstraction, config) {}
 
 CFRResult VanillaCFR::solve(const GameState& initial_state) {
+    metrics::ScopedTimer solve_timer(metrics::Timer::SOLVE);
+    trace::Span solve_span("solve", "cfr");
+    start_profiling();
     auto start_time = std::chrono::high_resolution_clock::now();
     
     CFRResult result;
@@ -78,21 +675,40 @@ CFRResult VanillaCFR::solve(const GameState& initial_state) {
         }
     }
     
-    for (int iteration = 1; iteration <= config_.max_iterations; ++iteration) {
+    for (int iteration = current_iteration_ + 1; iteration <= config_.max_iterations; ++iteration) {
+        if (stop_requested()) {
+            break;
+        }
         current_iteration_ = iteration;
+        trace::Span iteration_span("iteration", "cfr");
+        iteration_span.arg("iteration", iteration);
+        size_t infosets_before = node_map_.size();
         
         // Initialiser les probabilités d'atteinte
         std::vector<double> reach_probs(initial_state.num_players, 1.0);
         
         // Exécuter une itération de CFR
         std::vector<Hand> hands = all_hands; // Copie pour cette itération
-        cfr(initial_state, hands, reach_probs, iteration);
+        try {
+            PhaseProfiler::Scope phase(profiler_.get(), ProfilePhase::TRAVERSAL);
+            cfr(initial_state, hands, reach_probs, iteration);
+        } catch (const MemoryLimitExceeded&) {
+            fail_on_memory_limit(iteration - 1);
+            break;
+        }
+        metrics::increment(metrics::Counter::ITERATIONS);
+        if (node_map_.size() > infosets_before) {
+            // Itération qui a étendu l'arbre (construction paresseuse)
+            iteration_span.rename("tree_build");
+            iteration_span.arg("new_infosets", static_cast<int64_t>(node_map_.size() - infosets_before));
+        }
+        iteration_span.end();
+        end_iteration(iteration);
         
         // Vérifier la convergence périodiquement
         if (iteration % 50 == 0) {
-            double exploitability = calculate_exploitability(initial_state);
-            std::cout << "Iteration " << iteration << ": Exploitability = " 
-                      << exploitability << std::endl;
+            double exploitability = measure_exploitability(initial_state);
+            report_progress("Iteration ", iteration, exploitability);
             
             if (exploitability <= config_.target_exploitability) {
                 result.converged = true;
@@ -101,36 +717,48 @@ CFRResult VanillaCFR::solve(const GameState& initial_state) {
         }
         
         // Checkpoint périodique
-        if (config_.checkpoint_frequency > 0 && iteration % config_.checkpoint_frequency == 0) {
-            save_checkpoint("checkpoint_" + std::to_string(iteration) + ".bin");
+        checkpoint_if_due(iteration);
+        
+        if (enforce_memory_limit(iteration)) {
+            break;
         }
     }
     
+    finish_checkpoints();
+    
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
     
     result.iterations_completed = current_iteration_;
-    result.final_exploitability = calculate_exploitability(initial_state);
+    result.final_exploitability = final_exploitability(initial_state);
     result.convergence_time_seconds = duration.count() / 1000.0;
-    result.status_message = result.converged ? "Converged" : "Max iterations reached";
+    result.status_message = status_message(result.converged);
+    fill_memory_stats(result);
+    finish_profiling(result);
     
     return result;
 }
 
 std::vector<double> VanillaCFR::cfr(const GameState& state, std::vector<Hand>& hands,
-                                   std::vector<double>& reach_probabilities, int iteration) {
+                                   std::vector<double>& reach_probabilities, int iteration,
+                                   GameNode* cached_node) {
     
     if (state.is_terminal()) {
+        PhaseProfiler::Scope phase(profiler_.get(), ProfilePhase::TERMINAL_EVALUATION);
         return get_terminal_values(state, hands);
     }
     
     int player = state.current_player;
-    auto node = get_or_create_node(state, player);
+    GameNode* node = visit_node(cached_node, state, player);
+    if (!node) {
+        return sampled_rollout(state);
+    }
     
     std::vector<Action> actions = abstraction_->get_abstracted_actions(state);
     if (actions.empty()) {
         return std::vector<double>(state.num_players, 0.0);
     }
+    link_children(*node, state, actions);
     
     std::vector<double> strategy = node->get_strategy();
     std::vector<double> action_values(actions.size());
@@ -144,7 +772,9 @@ std::vector<double> VanillaCFR::cfr(const GameState& state, std::vector<Hand>& h
         std::vector<double> next_reach_probs = reach_probabilities;
         next_reach_probs[player] *= strategy[i];
         
-        std::vector<double> action_result = cfr(next_state, hands, next_reach_probs, iteration);
+        node->prefetch_child(i + 1);
+        GameNode* child = child_node(*node, i, next_state);
+        std::vector<double> action_result = cfr(next_state, hands, next_reach_probs, iteration, child);
         action_values[i] = action_result[player];
         
         // Accumuler les valeurs pondérées par la stratégie
@@ -153,36 +783,88 @@ std::vector<double> VanillaCFR::cfr(const GameState& state, std::vector<Hand>& h
         }
     }
     
+    update_node(*node, strategy, action_values, node_values[player], reach_probabilities[player], iteration);
+    return node_values;
+}
+
+void VanillaCFR::update_node(GameNode& node, const std::vector<double>& strategy,
+                             const std::vector<double>& action_values, double node_value,
+                             double reach_probability, int iteration) {
+    PhaseProfiler::Scope phase(profiler_.get(), ProfilePhase::REGRET_UPDATE);
+    
     // Calculer les regrets
-    std::vector<double> regrets(actions.size());
-    for (size_t i = 0; i < actions.size(); ++i) {
-        regrets[i] = action_values[i] - node_values[player];
+    std::vector<double> regrets(action_values.size());
+    for (size_t i = 0; i < action_values.size(); ++i) {
+        regrets[i] = action_values[i] - node_value;
     }
     
     // Mettre à jour les regrets avec ou sans discounting
     if (config_.use_discounting) {
         update_regrets_with_discounting(node, regrets, iteration);
     } else {
-        node->update_regret(regrets);
+        node.update_regret(regrets);
     }
     
     // Mettre à jour la somme des stratégies
-    double reach_prob = reach_probabilities[player];
     std::vector<double> weighted_strategy(strategy.size());
     for (size_t i = 0; i < strategy.size(); ++i) {
-        weighted_strategy[i] = reach_prob * strategy[i];
+        weighted_strategy[i] = reach_probability * strategy[i];
+    }
+    node.update_strategy_sum(weighted_strategy);
+}
+
+std::vector<double> VanillaCFR::traverse_subtree(const GameState& state, const std::vector<double>& reach_probabilities,
+                                                 int iteration) {
+    // Les valeurs terminales ne dépendent pas des mains (get_terminal_values)
+    std::vector<Hand> hands;
+    std::vector<double> reach = reach_probabilities;
+    PhaseProfiler::Scope phase(profiler_.get(), ProfilePhase::TRAVERSAL);
+    return cfr(state, hands, reach, iteration);
+}
+
+std::vector<double> VanillaCFR::current_strategy(const GameState& state) {
+    GameNode* node = get_or_create_node(state, state.current_player);
+    if (!node) {
+        throw MemoryLimitExceeded("Limite mémoire atteinte au nœud racine");
+    }
+    return node->get_strategy();
+}
+
+std::vector<double> VanillaCFR::update_from_children(const GameState& state,
+                                                     const std::vector<double>& reach_probabilities,
+                                                     const std::vector<double>& strategy,
+                                                     const std::vector<std::vector<double>>& child_values,
+                                                     int iteration) {
+    int player = state.current_player;
+    GameNode* node = get_or_create_node(state, player);
+    if (!node) {
+        throw MemoryLimitExceeded("Limite mémoire atteinte au nœud racine");
     }
-    node->update_strategy_sum(weighted_strategy);
     
+    std::vector<double> action_values(child_values.size());
+    std::vector<double> node_values(state.num_players, 0.0);
+    for (size_t i = 0; i < child_values.size(); ++i) {
+        action_values[i] = child_values[i][player];
+        for (int p = 0; p < state.num_players; ++p) {
+            node_values[p] += strategy[i] * child_values[i][p];
+        }
+    }
+    update_node(*node, strategy, action_values, node_values[player], reach_probabilities[player], iteration);
     return node_values;
 }
 
+void VanillaCFR::complete_iteration(int iteration) {
+    current_iteration_ = iteration;
+    metrics::increment(metrics::Counter::ITERATIONS);
+    end_iteration(iteration);
+}
+
 std::vector<double> VanillaCFR::get_terminal_values(const GameState& state, const std::vector<Hand>& hands) const {
     // Simplification: retourner les payoffs du state
     return state.get_payoffs();
 }
 
-void VanillaCFR::update_regrets_with_discounting(std::shared_ptr<GameNode> node,
+void VanillaCFR::update_regrets_with_discounting(GameNode& node,
                                                  const std::vector<double>& regrets, int iteration) {
     double discount_factor = std::pow(iteration, -config_.alpha);
     std::vector<double> discounted_regrets(regrets.size());
@@ -191,13 +873,13 @@ void VanillaCFR::update_regrets_with_discounting(std::shared_ptr<GameNode> node,
         discounted_regrets[i] = regrets[i] * discount_factor;
     }
     
-    node->update_regret(discounted_regrets);
+    node.update_regret(discounted_regrets);
 }
 
 std::vector<double> VanillaCFR::get_strategy(const GameState& state, int player) const {
-    auto node = node_map_.find(state_to_key(state, player));
-    if (node != node_map_.end()) {
-        return node->second->get_average_strategy();
+    std::vector<double> strategy = find_average_strategy(state_to_key(state, player));
+    if (!strategy.empty()) {
+        return strategy;
     }
     
     // Stratégie uniforme par défaut
@@ -228,16 +910,8 @@ double CFRSolver::best_response_traversal(const GameState& state, int br_player,
         }
         return max_value;
     } else {
-        auto node_iter = this->node_map_.find(this->state_to_key(state, current_player));
-        std::vector<double> opponent_strategy;
-
-        if (node_iter != this->node_map_.end() && !node_iter->second->actions.empty()) {
-            opponent_strategy = node_iter->second->get_average_strategy();
-            if (opponent_strategy.size() != actions.size()) {
-                opponent_strategy.assign(actions.size(), 1.0 / actions.size());
-            }
-        } else {
-            if (actions.empty()) return state.get_payoffs()[br_player];
+        std::vector<double> opponent_strategy = this->find_average_strategy(this->state_to_key(state, current_player));
+        if (opponent_strategy.size() != actions.size()) {
             opponent_strategy.assign(actions.size(), 1.0 / actions.size());
         }
         
@@ -336,109 +1010,8 @@ double VanillaCFR::calculate_strategy_value(const GameState& state, int player)
     return expected_value;
 }
 
-void VanillaCFR::save_checkpoint(const std::string& filename) const {
-    std::ofstream file(filename, std::ios::binary);
-    if (!file) {
-        std::cerr << "Erreur: Impossible de sauvegarder le checkpoint " << filename << std::endl;
-        return;
-    }
-    
-    // Sauvegarder l'itération actuelle
-    file.write(reinterpret_cast<const char*>(&current_iteration_), sizeof(current_iteration_));
-    
-    // Sauvegarder le nombre de nœuds
-    size_t num_nodes = node_map_.size();
-    file.write(reinterpret_cast<const char*>(&num_nodes), sizeof(num_nodes));
-    
-    // Sauvegarder chaque nœud
-    for (const auto& pair : node_map_) {
-        const std::string& key = pair.first;
-        const auto& node = pair.second;
-        
-        // Sauvegarder la clé
-        size_t key_size = key.size();
-        file.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
-        file.write(key.c_str(), key_size);
-        
-        // Sauvegarder les données du nœud
-        size_t regret_size = node->regret_sum.size();
-        file.write(reinterpret_cast<const char*>(&regret_size), sizeof(regret_size));
-        file.write(reinterpret_cast<const char*>(node->regret_sum.data()), 
-                   regret_size * sizeof(double));
-        
-        size_t strategy_size = node->strategy_sum.size();
-        file.write(reinterpret_cast<const char*>(&strategy_size), sizeof(strategy_size));
-        file.write(reinterpret_cast<const char*>(node->strategy_sum.data()), 
-                   strategy_size * sizeof(double));
-    }
-    
-    std::cout << "Checkpoint sauvegardé: " << filename << std::endl;
-}
-
-void VanillaCFR::load_checkpoint(const std::string& filename) {
-    std::ifstream file(filename, std::ios::binary);
-    if (!file) {
-        std::cerr << "Erreur: Impossible de charger le checkpoint " << filename << std::endl;
-        return;
-    }
-    
-    // Charger l'itération
-    file.read(reinterpret_cast<char*>(&current_iteration_), sizeof(current_iteration_));
-    
-    // Charger le nombre de nœuds
-    size_t num_nodes;
-    file.read(reinterpret_cast<char*>(&num_nodes), sizeof(num_nodes));
-    
-    // Effacer les nœuds existants
-    node_map_.clear();
-    
-    // Charger chaque nœud
-    for (size_t i = 0; i < num_nodes; ++i) {
-        // Charger la clé
-        size_t key_size;
-        file.read(reinterpret_cast<char*>(&key_size), sizeof(key_size));
-        std::string key(key_size, '\0');
-        file.read(&key[0], key_size);
-        
-        // Charger les données de regret
-        size_t regret_size;
-        file.read(reinterpret_cast<char*>(&regret_size), sizeof(regret_size));
-        std::vector<double> regret_sum(regret_size);
-        file.read(reinterpret_cast<char*>(regret_sum.data()), 
-                  regret_size * sizeof(double));
-        
-        // Charger les données de stratégie
-        size_t strategy_size;
-        file.read(reinterpret_cast<char*>(&strategy_size), sizeof(strategy_size));
-        std::vector<double> strategy_sum(strategy_size);
-        file.read(reinterpret_cast<char*>(strategy_sum.data()), 
-                  strategy_size * sizeof(double));
-        
-        // Reconstruire le GameNode
-        // Note: Nous créons un nœud temporaire car nous n'avons que la clé
-        // En pratique, le nœud sera recréé lors de la prochaine traversée CFR
-        // avec le bon GameState, mais nous restaurons les données apprises
-        try {
-            // Décoder la clé pour extraire les informations de base
-            // Format de clé typique: "player_actions_board_hand"
-            // Pour l'instant, créer un nœud placeholder qui sera remplacé
-            GameState placeholder_state;
-            placeholder_state.num_players = 2; // Valeur par défaut
-            
-            auto node = std::make_shared<GameNode>(placeholder_state, 0);
-            node->regret_sum = std::move(regret_sum);
-            node->strategy_sum = std::move(strategy_sum);
-            
-            // Stocker dans la map pour récupération ultérieure
-            node_map_[key] = node;
-            
-        } catch (const std::exception& e) {
-            std::cerr << "Erreur lors de la reconstruction du nœud " << key 
-                      << ": " << e.what() << std::endl;
-        }
-    }
-    
-    std::cout << "Checkpoint chargé: " << filename << std::endl;
+SolverType VanillaCFR::solver_type() const {
+    return SolverType::VANILLA_CFR;
 }
 
 // Déclaration de la fonction privée pour la classe VanillaCFR dans le .h serait nécessaire
@@ -448,65 +1021,199 @@ void VanillaCFR::load_checkpoint(const std::string& filename) {
 
 // ChanceSamplingCFR implementation
 ChanceSamplingCFR::ChanceSamplingCFR(std::shared_ptr<GameAbstraction> abstraction, const CFRConfig& config)
-    : CFRSolver(abstraction, config), rng_(std::random_device{}()) {}
+    : CFRSolver(abstraction, config) {}
 
 CFRResult ChanceSamplingCFR::solve(const GameState& initial_state) {
+    metrics::ScopedTimer solve_timer(metrics::Timer::SOLVE);
+    trace::Span solve_span("solve", "cfr");
+    start_profiling();
     auto start_time = std::chrono::high_resolution_clock::now();
     
     CFRResult result;
     result.converged = false;
-    
-    for (int iteration = 1; iteration <= config_.max_iterations; ++iteration) {
-        current_iteration_ = iteration;
-        
-        // Échantillonner une main pour cette itération
-        Hand sampled_hand = sample_hand(initial_state);
-        
-        for (int player = 0; player < initial_state.num_players; ++player) {
-            std::vector<double> reach_probs(initial_state.num_players, 1.0);
-            mccfr(initial_state, sampled_hand, reach_probs, iteration, player);
+    int threads = traversal_threads();
+    DealSampler sampler = make_deal_sampler(initial_state);
+    GameState dealt_root = initial_state;
+    Deal deal;
+    
+    for (int iteration = current_iteration_ + 1; iteration <= config_.max_iterations; ++iteration) {
+        if (stop_requested()) {
+            break;
+        }
+        if (threads > 1) {
+            // Bloc d'itérations concurrentes jusqu'à la prochaine mesure,
+            // checkpoint ou rappel, traités ensuite comme en séquentiel
+            int last = parallel_block_end(iteration, config_.max_iterations, 100);
+            trace::Span block_span("parallel_iterations", "cfr");
+            block_span.arg("first", iteration);
+            block_span.arg("last", last);
+            int first = iteration;
+            try {
+                iteration = parallel_iterations(initial_state, sampler, first, last, threads);
+            } catch (const MemoryLimitExceeded&) {
+                fail_on_memory_limit(first - 1);
+                break;
+            }
+            current_iteration_ = iteration;
+            block_span.end();
+            if (iteration < first) {
+                break;
+            }
+        } else {
+            current_iteration_ = iteration;
+            trace::Span iteration_span("iteration", "cfr");
+            iteration_span.arg("iteration", iteration);
+            size_t infosets_before = node_map_.size();
+            
+            try {
+                PhaseProfiler::Scope phase(profiler_.get(), ProfilePhase::TRAVERSAL);
+                sampled_iteration(sampler, iteration, dealt_root, deal);
+            } catch (const MemoryLimitExceeded&) {
+                fail_on_memory_limit(iteration - 1);
+                break;
+            }
+            metrics::increment(metrics::Counter::ITERATIONS);
+            if (node_map_.size() > infosets_before) {
+                // Itération qui a étendu l'arbre (construction paresseuse)
+                iteration_span.rename("tree_build");
+                iteration_span.arg("new_infosets", static_cast<int64_t>(node_map_.size() - infosets_before));
+            }
+            iteration_span.end();
         }
+        end_iteration(iteration);
         
         // Vérification de convergence moins fréquente
         if (iteration % 100 == 0) {
-            double exploitability = calculate_exploitability(initial_state);
-            std::cout << "MCCFR Iteration " << iteration << ": Exploitability = " 
-                      << exploitability << std::endl;
+            double exploitability = measure_exploitability(initial_state);
+            report_progress("MCCFR Iteration ", iteration, exploitability);
             
             if (exploitability <= config_.target_exploitability) {
                 result.converged = true;
                 break;
             }
         }
+        
+        checkpoint_if_due(iteration);
+        
+        if (enforce_memory_limit(iteration)) {
+            break;
+        }
     }
     
+    finish_checkpoints();
+    
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
     
     result.iterations_completed = current_iteration_;
-    result.final_exploitability = calculate_exploitability(initial_state);
+    result.final_exploitability = final_exploitability(initial_state);
     result.convergence_time_seconds = duration.count() / 1000.0;
-    result.status_message = result.converged ? "Converged" : "Max iterations reached";
+    result.status_message = status_message(result.converged);
+    fill_memory_stats(result);
+    finish_profiling(result);
     
     return result;
 }
 
-std::vector<double> ChanceSamplingCFR::mccfr(const GameState& state, const Hand& sampled_hand,
+int ChanceSamplingCFR::parallel_iterations(const GameState& initial_state, const DealSampler& sampler,
+                                           int first, int last, int threads) {
+    std::atomic<int> next_iteration(first);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    
+    // Les itérations sont distribuées à la demande: un thread ralenti par la
+    // création de nœuds n'en retient pas d'autres
+    auto worker = [&]() {
+        try {
+            GameState dealt_root = initial_state;
+            Deal deal;
+            for (;;) {
+                if (failed.load(std::memory_order_relaxed) || stop_requested()) {
+                    return;
+                }
+                int iteration = next_iteration.fetch_add(1, std::memory_order_relaxed);
+                if (iteration > last) {
+                    return;
+                }
+                sampled_iteration(sampler, iteration, dealt_root, deal);
+                metrics::increment(metrics::Counter::ITERATIONS);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            failed = true;
+        }
+    };
+    
+    begin_concurrent_traversal();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    end_concurrent_traversal();
+    
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    // Une itération réclamée est toujours menée à son terme
+    return std::min(next_iteration.load(), last + 1) - 1;
+}
+
+void ChanceSamplingCFR::sampled_iteration(const DealSampler& sampler, int iteration, GameState& dealt_root,
+                                          Deal& deal) {
+    CounterRng rng = iteration_rng(iteration);
+    sampler.deal(rng, deal);
+    dealt_root.player_hands = deal.hands;
+    for (int player = 0; player < dealt_root.num_players; ++player) {
+        std::vector<double> reach_probs(dealt_root.num_players, 1.0);
+        mccfr(dealt_root, deal, reach_probs, iteration, player, rng);
+    }
+}
+
+DealSampler ChanceSamplingCFR::make_deal_sampler(const GameState& state) const {
+    DealSampler sampler(state.board, state.num_players);
+    for (size_t player = 0; player < ranges_.size(); ++player) {
+        sampler.set_range(static_cast<int>(player), ranges_[player]);
+    }
+    return sampler;
+}
+
+std::vector<double> ChanceSamplingCFR::mccfr(const GameState& state, const Deal& deal,
                                             std::vector<double>& reach_probabilities, 
-                                            int iteration, int player) {
+                                            int iteration, int player, CounterRng& rng,
+                                            GameNode* cached_node) {
     if (state.is_terminal()) {
+        PhaseProfiler::Scope phase(profiler_.get(), ProfilePhase::TERMINAL_EVALUATION);
+        if (deal.board.size() > state.board.size()) {
+            // Showdown sur le tableau complété par la donne (les clés
+            // d'infoset gardent le tableau de l'arbre)
+            GameState showdown = state;
+            showdown.board = deal.board;
+            return showdown.get_payoffs();
+        }
         return state.get_payoffs();
     }
     
     int current_player = state.current_player;
-    auto node = get_or_create_node(state, current_player);
+    GameNode* node = visit_node(cached_node, state, current_player);
+    if (!node) {
+        return sampled_rollout(state, rng);
+    }
     
     std::vector<Action> actions = abstraction_->get_abstracted_actions(state);
     if (actions.empty()) {
         return std::vector<double>(state.num_players, 0.0);
     }
+    link_children(*node, state, actions);
     
-    std::vector<double> strategy = node->get_strategy();
+    bool concurrent = concurrent_traversal();
+    std::vector<double> strategy = concurrent ? node->get_strategy_relaxed() : node->get_strategy();
     
     if (current_player == player) {
         // Mettre à jour le joueur
@@ -518,9 +1225,16 @@ std::vector<double> ChanceSamplingCFR::mccfr(const GameState& state, const Hand&
             std::vector<double> next_reach_probs = reach_probabilities;
             next_reach_probs[player] *= strategy[i];
             
-            std::vector<double> action_result = mccfr(next_state, sampled_hand, 
-                                                     next_reach_probs, iteration, player);
+            node->prefetch_child(i + 1);
+            GameNode* child = child_node(*node, i, next_state);
+            std::vector<double> action_result = mccfr(next_state, deal, 
+                                                     next_reach_probs, iteration, player, rng, child);
             action_values[i] = action_result[player];
+            if (!node->baseline.empty()) {
+                // Valeurs de toutes les actions connues ici: la référence
+                // de l'infoset apprend aussi des traversées de son joueur
+                node->update_baseline(i, action_result, config_.baseline_learning_rate);
+            }
             
             for (int p = 0; p < state.num_players; ++p) {
                 node_values[p] += strategy[i] * action_result[p];
@@ -528,53 +1242,82 @@ std::vector<double> ChanceSamplingCFR::mccfr(const GameState& state, const Hand&
         }
         
         // Calculer et mettre à jour les regrets
+        PhaseProfiler::Scope phase(profiler_.get(), ProfilePhase::REGRET_UPDATE);
         std::vector<double> regrets(actions.size());
         for (size_t i = 0; i < actions.size(); ++i) {
             regrets[i] = action_values[i] - node_values[player];
         }
-        node->update_regret(regrets);
+        if (concurrent) {
+            node->add_regret_relaxed(regrets);
+        } else {
+            node->update_regret(regrets);
+        }
         
         return node_values;
     } else {
-        // Échantillonner une action pour les autres joueurs
-        int sampled_action = sample_action(strategy);
+        // Stratégie moyenne des autres joueurs: leurs actions sont
+        // échantillonnées selon leur stratégie, la somme non pondérée est
+        // donc proportionnelle à leur probabilité d'atteinte en moyenne
+        if (concurrent) {
+            node->add_strategy_sum_relaxed(strategy);
+        } else {
+            node->update_strategy_sum(strategy);
+        }
+        
+        // Échantillonner une action pour les autres joueurs, parmi les
+        // actions abstraites (le nœud porte toutes les actions légales)
+        strategy.resize(actions.size());
+        int sampled_action = sample_action(strategy, rng);
         GameState next_state = state.apply_action(actions[sampled_action]);
         
         std::vector<double> next_reach_probs = reach_probabilities;
         next_reach_probs[current_player] *= strategy[sampled_action];
         
-        return mccfr(next_state, sampled_hand, next_reach_probs, iteration, player);
+        GameNode* child = child_node(*node, sampled_action, next_state);
+        std::vector<double> values = mccfr(next_state, deal, next_reach_probs, iteration, player, rng, child);
+        if (node->baseline.empty()) {
+            return values;
+        }
+        return baseline_corrected_values(*node, strategy, sampled_action, values);
     }
 }
 
-Hand ChanceSamplingCFR::sample_hand(const GameState& state) {
-    auto cards = all_cards();
-    
-    // Enlever les cartes du board
-    for (const Card& card : state.board) {
-        cards.erase(std::remove(cards.begin(), cards.end(), card), cards.end());
-    }
-    
-    // Échantillonner deux cartes
-    std::shuffle(cards.begin(), cards.end(), rng_);
-    if (cards.size() >= 2) {
-        return {cards[0], cards[1]};
+std::vector<double> ChanceSamplingCFR::baseline_corrected_values(GameNode& node, const std::vector<double>& strategy,
+                                                                 size_t sampled_action,
+                                                                 const std::vector<double>& sampled_values) {
+    // Probabilités du tirage (sample_action): stratégie renormalisée sur
+    // les actions abstraites, uniforme si elle y est nulle
+    double total = 0.0;
+    for (double probability : strategy) {
+        total += probability;
+    }
+    
+    // v(I) = somme_b σ(b) B(b) + (v(a) - B(a)): le terme σ(a)/q(a) vaut 1
+    // puisque l'action est tirée selon σ
+    std::vector<double> values(sampled_values.size());
+    for (size_t p = 0; p < values.size(); ++p) {
+        int player = static_cast<int>(p);
+        double expected = 0.0;
+        for (size_t b = 0; b < strategy.size(); ++b) {
+            double probability = total > 0.0 ? strategy[b] / total : 1.0 / strategy.size();
+            expected += probability * node.baseline_value(b, player);
+        }
+        values[p] = expected + sampled_values[p] - node.baseline_value(sampled_action, player);
     }
-    
-    // Fallback
-    return {Card("As"), Card("Kh")};
+    // Référence apprise après son usage: la correction reste sans biais
+    node.update_baseline(sampled_action, sampled_values, config_.baseline_learning_rate);
+    return values;
 }
 
-int ChanceSamplingCFR::sample_action(const std::vector<double>& strategy) {
-    std::discrete_distribution<int> dist(strategy.begin(), strategy.end());
-    return dist(rng_);
+int ChanceSamplingCFR::sample_action(const std::vector<double>& strategy, CounterRng& rng) {
+    return static_cast<int>(rng.sample(strategy));
 }
 
 std::vector<double> ChanceSamplingCFR::get_strategy(const GameState& state, int player) const {
     // Même implémentation que VanillaCFR
-    auto node = node_map_.find(state_to_key(state, player));
-    if (node != node_map_.end()) {
-        return node->second->get_average_strategy();
+    std::vector<double> strategy = find_average_strategy(state_to_key(state, player));
+    if (!strategy.empty()) {
+        return strategy;
     }
     
     std::vector<Action> actions = abstraction_->get_abstracted_actions(state);
@@ -666,118 +1409,23 @@ double ChanceSamplingCFR::calculate_strategy_value(const GameState& state, int p
     return expected_value;
 }
 
-void ChanceSamplingCFR::save_checkpoint(const std::string& filename) const {
-    std::ofstream file(filename, std::ios::binary);
-    if (!file) {
-        std::cerr << "Erreur: Impossible de sauvegarder le checkpoint MCCFR " << filename << std::endl;
-        return;
-    }
-    
-    // Sauvegarder l'itération actuelle
-    file.write(reinterpret_cast<const char*>(&current_iteration_), sizeof(current_iteration_));
-    
-    // Sauvegarder l'état du générateur aléatoire
-    std::ostringstream rng_state;
-    rng_state << rng_;
-    std::string rng_state_str = rng_state.str();
-    size_t rng_state_size = rng_state_str.size();
-    file.write(reinterpret_cast<const char*>(&rng_state_size), sizeof(rng_state_size));
-    file.write(rng_state_str.c_str(), rng_state_size);
-    
-    // Sauvegarder le nombre de nœuds
-    size_t num_nodes = node_map_.size();
-    file.write(reinterpret_cast<const char*>(&num_nodes), sizeof(num_nodes));
-    
-    // Sauvegarder chaque nœud
-    for (const auto& pair : node_map_) {
-        const std::string& key = pair.first;
-        const auto& node = pair.second;
-        
-        // Sauvegarder la clé
-        size_t key_size = key.size();
-        file.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
-        file.write(key.c_str(), key_size);
-        
-        // Sauvegarder les données du nœud
-        size_t regret_size = node->regret_sum.size();
-        file.write(reinterpret_cast<const char*>(&regret_size), sizeof(regret_size));
-        file.write(reinterpret_cast<const char*>(node->regret_sum.data()), 
-                   regret_size * sizeof(double));
-        
-        size_t strategy_size = node->strategy_sum.size();
-        file.write(reinterpret_cast<const char*>(&strategy_size), sizeof(strategy_size));
-        file.write(reinterpret_cast<const char*>(node->strategy_sum.data()), 
-                   strategy_size * sizeof(double));
-    }
-    
-    std::cout << "Checkpoint MCCFR sauvegardé: " << filename << std::endl;
+SolverType ChanceSamplingCFR::solver_type() const {
+    return SolverType::CHANCE_SAMPLING_CFR;
 }
 
-void ChanceSamplingCFR::load_checkpoint(const std::string& filename) {
-    std::ifstream file(filename, std::ios::binary);
-    if (!file) {
-        std::cerr << "Erreur: Impossible de charger le checkpoint MCCFR " << filename << std::endl;
-        return;
-    }
-    
-    // Charger l'itération
-    file.read(reinterpret_cast<char*>(&current_iteration_), sizeof(current_iteration_));
-    
-    // Charger l'état du générateur aléatoire
-    size_t rng_state_size;
-    file.read(reinterpret_cast<char*>(&rng_state_size), sizeof(rng_state_size));
-    std::string rng_state_str(rng_state_size, '\0');
-    file.read(&rng_state_str[0], rng_state_size);
-    std::istringstream rng_state_stream(rng_state_str);
-    rng_state_stream >> rng_;
-    
-    // Charger le nombre de nœuds
-    size_t num_nodes;
-    file.read(reinterpret_cast<char*>(&num_nodes), sizeof(num_nodes));
-    
-    // Effacer les nœuds existants
-    node_map_.clear();
-    
-    // Charger chaque nœud
-    for (size_t i = 0; i < num_nodes; ++i) {
-        // Charger la clé
-        size_t key_size;
-        file.read(reinterpret_cast<char*>(&key_size), sizeof(key_size));
-        std::string key(key_size, '\0');
-        file.read(&key[0], key_size);
-        
-        // Charger les données de regret
-        size_t regret_size;
-        file.read(reinterpret_cast<char*>(&regret_size), sizeof(regret_size));
-        std::vector<double> regret_sum(regret_size);
-        file.read(reinterpret_cast<char*>(regret_sum.data()), 
-                  regret_size * sizeof(double));
-        
-        // Charger les données de stratégie
-        size_t strategy_size;
-        file.read(reinterpret_cast<char*>(&strategy_size), sizeof(strategy_size));
-        std::vector<double> strategy_sum(strategy_size);
-        file.read(reinterpret_cast<char*>(strategy_sum.data()), 
-                  strategy_size * sizeof(double));
-        
-        // Reconstruire le GameNode
-        try {
-            GameState placeholder_state;
-            placeholder_state.num_players = 2;
-            
-            auto node = std::make_shared<GameNode>(placeholder_state, 0);
-            node->regret_sum = std::move(regret_sum);
-            node->strategy_sum = std::move(strategy_sum);
-            
-            node_map_[key] = node;
-            
-        } catch (const std::exception& e) {
-            std::cerr << "Erreur lors de la reconstruction du nœud MCCFR " << key 
-                      << ": " << e.what() << std::endl;
-        }
+std::string ChanceSamplingCFR::save_solver_state() const {
+    // Les tirages ne dépendent que de la graine et du numéro d'itération:
+    // la reprise continue la même suite qu'une exécution sans interruption
+    return std::to_string(seed_);
+}
+
+void ChanceSamplingCFR::restore_solver_state(const std::string& state) {
+    std::istringstream seed_state(state);
+    uint64_t seed = 0;
+    // Les anciens checkpoints portent l'état d'un mt19937: ignoré, la graine courante reste
+    if (seed_state >> seed && (seed_state >> std::ws).eof()) {
+        seed_ = seed;
     }
-    
-    std::cout << "Checkpoint MCCFR chargé: " << filename << std::endl;
 }
 
 // CFRPlus implementation
@@ -786,6 +1434,9 @@ CFRPlus::CFRPlus(std::shared_ptr<GameAbstraction> abstraction, const CFRConfig&
 
 CFRResult CFRPlus::solve(const GameState& initial_state) {
     // Implémentation similaire à VanillaCFR mais avec CFR+
+    metrics::ScopedTimer solve_timer(metrics::Timer::SOLVE);
+    trace::Span solve_span("solve", "cfr");
+    start_profiling();
     auto start_time = std::chrono::high_resolution_clock::now();
     
     CFRResult result;
@@ -799,50 +1450,85 @@ CFRResult CFRPlus::solve(const GameState& initial_state) {
         }
     }
     
-    for (int iteration = 1; iteration <= config_.max_iterations; ++iteration) {
+    for (int iteration = current_iteration_ + 1; iteration <= config_.max_iterations; ++iteration) {
+        if (stop_requested()) {
+            break;
+        }
         current_iteration_ = iteration;
+        trace::Span iteration_span("iteration", "cfr");
+        iteration_span.arg("iteration", iteration);
+        size_t infosets_before = node_map_.size();
         
         std::vector<double> reach_probs(initial_state.num_players, 1.0);
         std::vector<Hand> hands = all_hands;
-        cfr_plus(initial_state, hands, reach_probs, iteration);
+        try {
+            PhaseProfiler::Scope phase(profiler_.get(), ProfilePhase::TRAVERSAL);
+            cfr_plus(initial_state, hands, reach_probs, iteration);
+        } catch (const MemoryLimitExceeded&) {
+            fail_on_memory_limit(iteration - 1);
+            break;
+        }
+        metrics::increment(metrics::Counter::ITERATIONS);
+        if (node_map_.size() > infosets_before) {
+            // Itération qui a étendu l'arbre (construction paresseuse)
+            iteration_span.rename("tree_build");
+            iteration_span.arg("new_infosets", static_cast<int64_t>(node_map_.size() - infosets_before));
+        }
+        iteration_span.end();
+        end_iteration(iteration);
         
         if (iteration % 50 == 0) {
-            double exploitability = calculate_exploitability(initial_state);
-            std::cout << "CFR+ Iteration " << iteration << ": Exploitability = " 
-                      << exploitability << std::endl;
+            double exploitability = measure_exploitability(initial_state);
+            report_progress("CFR+ Iteration ", iteration, exploitability);
             
             if (exploitability <= config_.target_exploitability) {
                 result.converged = true;
                 break;
             }
         }
+        
+        checkpoint_if_due(iteration);
+        
+        if (enforce_memory_limit(iteration)) {
+            break;
+        }
     }
     
+    finish_checkpoints();
+    
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
     
     result.iterations_completed = current_iteration_;
-    result.final_exploitability = calculate_exploitability(initial_state);
+    result.final_exploitability = final_exploitability(initial_state);
     result.convergence_time_seconds = duration.count() / 1000.0;
-    result.status_message = result.converged ? "Converged" : "Max iterations reached";
+    result.status_message = status_message(result.converged);
+    fill_memory_stats(result);
+    finish_profiling(result);
     
     return result;
 }
 
 std::vector<double> CFRPlus::cfr_plus(const GameState& state, std::vector<Hand>& hands,
-                                     std::vector<double>& reach_probabilities, int iteration) {
+                                     std::vector<double>& reach_probabilities, int iteration,
+                                     GameNode* cached_node) {
     // Implémentation similaire à VanillaCFR mais avec regret matching +
     if (state.is_terminal()) {
+        PhaseProfiler::Scope phase(profiler_.get(), ProfilePhase::TERMINAL_EVALUATION);
         return state.get_payoffs();
     }
     
     int player = state.current_player;
-    auto node = get_or_create_node(state, player);
+    GameNode* node = visit_node(cached_node, state, player);
+    if (!node) {
+        return sampled_rollout(state);
+    }
     
     std::vector<Action> actions = abstraction_->get_abstracted_actions(state);
     if (actions.empty()) {
         return std::vector<double>(state.num_players, 0.0);
     }
+    link_children(*node, state, actions);
     
     // Utiliser regret matching + pour la stratégie
     std::vector<double> strategy = regret_matching_plus(node->regret_sum);
@@ -855,7 +1541,9 @@ std::vector<double> CFRPlus::cfr_plus(const GameState& state, std::vector<Hand>&
         std::vector<double> next_reach_probs = reach_probabilities;
         next_reach_probs[player] *= strategy[i];
         
-        std::vector<double> action_result = cfr_plus(next_state, hands, next_reach_probs, iteration);
+        node->prefetch_child(i + 1);
+        GameNode* child = child_node(*node, i, next_state);
+        std::vector<double> action_result = cfr_plus(next_state, hands, next_reach_probs, iteration, child);
         action_values[i] = action_result[player];
         
         for (int p = 0; p < state.num_players; ++p) {
@@ -863,6 +1551,8 @@ std::vector<double> CFRPlus::cfr_plus(const GameState& state, std::vector<Hand>&
         }
     }
     
+    PhaseProfiler::Scope phase(profiler_.get(), ProfilePhase::REGRET_UPDATE);
+    
     // Calculer les regrets
     std::vector<double> regrets(actions.size());
     for (size_t i = 0; i < actions.size(); ++i) {
@@ -870,11 +1560,9 @@ std::vector<double> CFRPlus::cfr_plus(const GameState& state, std::vector<Hand>&
     }
     
     // CFR+: garder seulement les regrets positifs
-    std::vector<double> positive_regrets(regrets.size());
-    for (size_t i = 0; i < regrets.size(); ++i) {
-        positive_regrets[i] = std::max(0.0, node->regret_sum[i] + regrets[i]);
+    for (size_t i = 0; i < regrets.size() && i < node->regret_sum.size(); ++i) {
+        node->regret_sum[i] = std::max(0.0, node->regret_sum[i] + regrets[i]);
     }
-    node->regret_sum = positive_regrets;
     
     // Mettre à jour la somme des stratégies
     double reach_prob = reach_probabilities[player];
@@ -887,7 +1575,8 @@ std::vector<double> CFRPlus::cfr_plus(const GameState& state, std::vector<Hand>&
     return node_values;
 }
 
-std::vector<double> CFRPlus::regret_matching_plus(const std::vector<double>& regrets) const {
+std::vector<double> CFRPlus::regret_matching_plus(const ValueSpan& regrets) const {
+    metrics::increment(metrics::Counter::REGRET_MATCHING_CALLS);
     std::vector<double> strategy(regrets.size());
     double positive_regret_sum = 0.0;
     
@@ -908,9 +1597,9 @@ std::vector<double> CFRPlus::regret_matching_plus(const std::vector<double>& reg
 }
 
 std::vector<double> CFRPlus::get_strategy(const GameState& state, int player) const {
-    auto node = node_map_.find(state_to_key(state, player));
-    if (node != node_map_.end()) {
-        return node->second->get_average_strategy();
+    std::vector<double> strategy = find_average_strategy(state_to_key(state, player));
+    if (!strategy.empty()) {
+        return strategy;
     }
     
     std::vector<Action> actions = abstraction_->get_abstracted_actions(state);
@@ -1002,102 +1691,8 @@ double CFRPlus::calculate_strategy_value(const GameState& state, int player) con
     return expected_value;
 }
 
-void CFRPlus::save_checkpoint(const std::string& filename) const {
-    std::ofstream file(filename, std::ios::binary);
-    if (!file) {
-        std::cerr << "Erreur: Impossible de sauvegarder le checkpoint CFR+ " << filename << std::endl;
-        return;
-    }
-    
-    // Sauvegarder l'itération actuelle
-    file.write(reinterpret_cast<const char*>(&current_iteration_), sizeof(current_iteration_));
-    
-    // Sauvegarder le nombre de nœuds
-    size_t num_nodes = node_map_.size();
-    file.write(reinterpret_cast<const char*>(&num_nodes), sizeof(num_nodes));
-    
-    // Sauvegarder chaque nœud
-    for (const auto& pair : node_map_) {
-        const std::string& key = pair.first;
-        const auto& node = pair.second;
-        
-        // Sauvegarder la clé
-        size_t key_size = key.size();
-        file.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
-        file.write(key.c_str(), key_size);
-        
-        // Sauvegarder les données du nœud (regret_sum pour CFR+ contient déjà les regrets positifs)
-        size_t regret_size = node->regret_sum.size();
-        file.write(reinterpret_cast<const char*>(&regret_size), sizeof(regret_size));
-        file.write(reinterpret_cast<const char*>(node->regret_sum.data()), 
-                   regret_size * sizeof(double));
-        
-        size_t strategy_size = node->strategy_sum.size();
-        file.write(reinterpret_cast<const char*>(&strategy_size), sizeof(strategy_size));
-        file.write(reinterpret_cast<const char*>(node->strategy_sum.data()), 
-                   strategy_size * sizeof(double));
-    }
-    
-    std::cout << "Checkpoint CFR+ sauvegardé: " << filename << std::endl;
-}
-
-void CFRPlus::load_checkpoint(const std::string& filename) {
-    std::ifstream file(filename, std::ios::binary);
-    if (!file) {
-        std::cerr << "Erreur: Impossible de charger le checkpoint CFR+ " << filename << std::endl;
-        return;
-    }
-    
-    // Charger l'itération
-    file.read(reinterpret_cast<char*>(&current_iteration_), sizeof(current_iteration_));
-    
-    // Charger le nombre de nœuds
-    size_t num_nodes;
-    file.read(reinterpret_cast<char*>(&num_nodes), sizeof(num_nodes));
-    
-    // Effacer les nœuds existants
-    node_map_.clear();
-    
-    // Charger chaque nœud
-    for (size_t i = 0; i < num_nodes; ++i) {
-        // Charger la clé
-        size_t key_size;
-        file.read(reinterpret_cast<char*>(&key_size), sizeof(key_size));
-        std::string key(key_size, '\0');
-        file.read(&key[0], key_size);
-        
-        // Charger les données de regret
-        size_t regret_size;
-        file.read(reinterpret_cast<char*>(&regret_size), sizeof(regret_size));
-        std::vector<double> regret_sum(regret_size);
-        file.read(reinterpret_cast<char*>(regret_sum.data()), 
-                  regret_size * sizeof(double));
-        
-        // Charger les données de stratégie
-        size_t strategy_size;
-        file.read(reinterpret_cast<char*>(&strategy_size), sizeof(strategy_size));
-        std::vector<double> strategy_sum(strategy_size);
-        file.read(reinterpret_cast<char*>(strategy_sum.data()), 
-                  strategy_size * sizeof(double));
-        
-        // Reconstruire le GameNode
-        try {
-            GameState placeholder_state;
-            placeholder_state.num_players = 2;
-            
-            auto node = std::make_shared<GameNode>(placeholder_state, 0);
-            node->regret_sum = std::move(regret_sum);
-            node->strategy_sum = std::move(strategy_sum);
-            
-            node_map_[key] = node;
-            
-        } catch (const std::exception& e) {
-            std::cerr << "Erreur lors de la reconstruction du nœud CFR+ " << key 
-                      << ": " << e.what() << std::endl;
-        }
-    }
-    
-    std::cout << "Checkpoint CFR+ chargé: " << filename << std::endl;
+SolverType CFRPlus::solver_type() const {
+    return SolverType::CFR_PLUS;
 }
 
 // Factory implementation
@@ -1,12 +1,32 @@
 #pragma once
 
 #include "game_tree.h"
+#include "checkpoint.h"
+#include "concurrent_node_index.h"
+#include "counter_rng.h"
+#include "deal_sampler.h"
+#include "infoset_store.h"
+#include "metrics.h"
+#include "perf_profiler.h"
+#include "trace.h"
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <unordered_map>
 #include <random>
+#include <stdexcept>
 
 namespace poker {
 
+// Réaction à l'approche de CFRConfig::memory_limit_mb
+enum class MemoryLimitPolicy {
+    FAIL,   // Checkpoint puis arrêt avec un message d'erreur
+    SPILL,  // Infosets déchargés dans un fichier mappé, rechargés à la demande
+    SAMPLE  // Plus de nouveaux infosets: parties échantillonnées au-delà de l'arbre existant
+};
+
 // Configuration pour le solveur CFR
 struct CFRConfig {
     int max_iterations = 1000;
@@ -16,8 +36,44 @@ struct CFRConfig {
     double alpha = 1.5; // Pour le discounting
     double beta = 0.0;
     int checkpoint_frequency = 100; // Sauvegarder tous les N iterations
+    std::string checkpoint_dir; // Checkpoints périodiques et de limite mémoire (vide: répertoire courant), créé au besoin
+    bool async_checkpoints = true; // Écrire les checkpoints depuis un thread d'arrière-plan
+    bool verify_checkpoint_checksums = false; // CRC de toutes les sections à la reprise (lit tout le fichier)
+    bool compact_checkpoints = false; // Valeurs quantifiées, codées en delta et compressées
+    double checkpoint_quantization_step = 1e-6; // Erreur absolue maximale: la moitié du pas
+    int checkpoint_keyframe_interval = 10; // Checkpoint complet tous les N (borne la chaîne de deltas)
+    std::string infoset_storage_dir; // Non vide: regrets et stratégies dans un fichier mappé (hors mémoire)
+    size_t infoset_resident_mb = 0; // Budget de mémoire résidente du stockage hors mémoire (0 = noyau)
+    bool infoset_huge_pages = false; // Valeurs des infosets sur pages de 2 Mo (moins de défauts de TLB)
+    size_t memory_limit_mb = 0; // Budget mémoire des infosets (0 = illimité)
+    MemoryLimitPolicy memory_limit_policy = MemoryLimitPolicy::FAIL;
+    bool profile_hardware_counters = false; // Compteurs perf par phase (perf_profiler.h), ralentit le solveur
+    int num_threads = 1; // Solveurs par échantillonnage: itérations concurrentes, mises à jour sans verrou
+    // Graine des tirages (counter_rng.h); 0: graine aléatoire. Les tirages
+    // d'une itération sont les mêmes quel que soit num_threads; sur un seul
+    // thread, toute la résolution est reproductible au bit près.
+    uint64_t seed = 0;
+    // VR-MCCFR: valeurs de référence par action (variables de contrôle) aux
+    // nœuds échantillonnés, apprises par moyenne exponentielle
+    bool use_baselines = false;
+    double baseline_learning_rate = 0.5;
     
     std::string to_string() const;
+    
+    // Empreinte des paramètres qui influencent les regrets (stockée dans les checkpoints)
+    uint64_t hash() const;
+};
+
+// Levée pendant une itération quand memory_limit_mb est dépassé (politique FAIL)
+class MemoryLimitExceeded : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+enum class SolverType {
+    VANILLA_CFR,
+    CHANCE_SAMPLING_CFR, 
+    CFR_PLUS
 };
 
 // Résultats du solveur
@@ -28,6 +84,14 @@ struct CFRResult {
     bool converged;
     std::string status_message;
     
+    // Statistiques mémoire en fin de résolution
+    size_t num_infosets = 0;
+    size_t infoset_memory_bytes = 0;
+    size_t huge_page_bytes = 0; // Valeurs servies par des pages de 2 Mo (0 si non obtenues)
+    
+    // Compteurs par phase si CFRConfig::profile_hardware_counters
+    HardwareProfile hardware_profile;
+    
     std::string to_string() const;
 };
 
@@ -46,21 +110,203 @@ public:
     // Calculer l'exploitabilité actuelle
     virtual double calculate_exploitability(const GameState& root_state) const = 0;
     
-    // Sauvegarder/charger l'état du solveur
-    virtual void save_checkpoint(const std::string& filename) const = 0;
-    virtual void load_checkpoint(const std::string& filename) = 0;
+    // Sauvegarder/charger l'état du solveur (format commun, voir checkpoint.h).
+    // Les erreurs sont affichées sur stderr; false en cas d'échec.
+    bool save_checkpoint(const std::string& filename) const;
+    bool load_checkpoint(const std::string& filename);
+    
+    // Variantes qui lèvent std::runtime_error (fichier illisible ou corrompu,
+    // autre type de solveur, écriture impossible) au lieu d'afficher l'erreur
+    void write_checkpoint(const std::string& filename) const;
+    void read_checkpoint(const std::string& filename);
+    
+    virtual SolverType solver_type() const = 0;
+    
+    // Mémoire des infosets suivie pour memory_limit_mb (nœuds, clés, table, valeurs en mémoire)
+    size_t infoset_memory_bytes() const;
+    
+    // Demande l'arrêt de solve() à la fin de l'itération en cours (appelable
+    // depuis un autre thread). Reste active jusqu'au prochain reset_values()
+    // ou clear_stop_request().
+    void request_stop() { stop_requested_ = true; }
+    void clear_stop_request() { stop_requested_ = false; }
+    bool stop_requested() const { return stop_requested_; }
+    
+    // Appelée à chaque mesure d'exploitabilité pendant solve()
+    using ProgressCallback = std::function<void(int iteration, double exploitability)>;
+    void set_progress_callback(ProgressCallback callback) { progress_callback_ = std::move(callback); }
+    
+    // Appelée toutes les every itérations pendant solve(), entre deux
+    // itérations: les nœuds peuvent y être lus sans concurrence
+    using IterationCallback = std::function<void(int iteration)>;
+    void set_iteration_callback(int every, IterationCallback callback);
+    
+    // Infosets de l'arbre (hors checkpoint de reprise), dans un ordre quelconque
+    void for_each_infoset(const std::function<void(const std::string& key, const GameNode& node)>& visit) const;
+    
+    // Remet regrets, stratégies et compteur d'itérations à zéro en conservant
+    // les nœuds: un nouveau solve() sur le même arbre évite sa reconstruction
+    void reset_values();
+    
+    // Critères d'arrêt d'un solveur réutilisé
+    void set_stopping_criteria(int max_iterations, double target_exploitability);
+    // Répertoire des checkpoints d'un solveur réutilisé (CFRConfig::checkpoint_dir).
+    // Un changement de répertoire commence une nouvelle chaîne de deltas.
+    void set_checkpoint_dir(const std::string& directory);
+    int current_iteration() const { return current_iteration_; }
+    size_t num_infosets() const { return node_map_.size(); }
+    
+    // Avancement publié à la fin de chaque itération, lisible depuis un autre
+    // thread pendant solve() (voir progress_reporter.h)
+    struct Progress {
+        int iteration;
+        double exploitability; // Dernière mesure, NaN avant la première
+        size_t infosets;
+        size_t memory_bytes;
+    };
+    Progress progress() const;
     
 protected:
     std::shared_ptr<GameAbstraction> abstraction_;
     CFRConfig config_;
     int current_iteration_;
+    uint64_t seed_; // CFRConfig::seed, ou tirée au hasard si nulle
+    InfosetStore infoset_store_;
+    // Nœuds alloués à la suite dans l'ordre de création (parents avant enfants);
+    // déclaré avant node_map_ pour lui survivre
+    std::pmr::monotonic_buffer_resource node_pool_;
     std::unordered_map<std::string, std::shared_ptr<GameNode>> node_map_;
+    std::unique_ptr<CheckpointWriter> checkpoint_writer_;
+    
+    // Checkpoint de reprise mappé: ses valeurs servent de stockage aux infosets
+    // qu'il contient, liés aux nœuds au fil des traversées
+    std::shared_ptr<MappedCheckpoint> resume_checkpoint_;
+    
+    // Profilage matériel du solve() en cours (nullptr si désactivé)
+    std::unique_ptr<PhaseProfiler> profiler_;
+    
+    // Copie cohérente des infosets, à prendre entre deux itérations
+    CheckpointSnapshot make_checkpoint_snapshot() const;
+    CheckpointEncoding checkpoint_encoding() const;
+    
+    // Checkpoint périodique (checkpoint_frequency), asynchrone et compact si configuré
+    void checkpoint_if_due(int iteration);
+    
+    // Chemin de name dans checkpoint_dir, répertoire créé s'il manque (un
+    // échec de création se manifeste à l'écriture du fichier)
+    std::string checkpoint_path(const std::string& name) const;
     
-    // Obtenir ou créer un nœud
-    std::shared_ptr<GameNode> get_or_create_node(const GameState& state, int player);
+    // Attendre la fin des checkpoints en cours d'écriture
+    void finish_checkpoints();
+    
+    // Nœuds créés avec des valeurs de référence (GameNode::baseline)
+    virtual bool uses_action_baselines() const { return false; }
+    
+    // État additionnel propre au solveur, sauvegardé dans la section SOLVER_STATE
+    virtual std::string save_solver_state() const { return {}; }
+    virtual void restore_solver_state(const std::string& state) { (void)state; }
+    
+    // Obtenir ou créer un nœud. nullptr si le nœud n'existe pas et que la
+    // limite mémoire interdit d'en créer: la traversée passe alors par sampled_rollout.
+    // reserved_values: emplacement réservé par link_children pour ce nœud.
+    // Le nœud reste valide jusqu'au prochain reset_nodes().
+    GameNode* get_or_create_node(const GameState& state, int player, double* reserved_values = nullptr);
+    
+    // Nœud d'un état pendant une traversée: lien mis en cache par le parent
+    // s'il existe (pas de construction de clé), sinon recherche par clé
+    GameNode* visit_node(GameNode* cached, const GameState& state, int player) {
+        metrics::increment(metrics::Counter::NODES_VISITED);
+        if (profiler_) {
+            profiler_->count_node();
+        }
+        if (cached) {
+            infoset_store_.touch(cached->regret_sum.data());
+            return cached;
+        }
+        return get_or_create_node(state, player);
+    }
+    
+    // Réserve d'un bloc les valeurs des enfants non terminaux de node à sa
+    // première expansion: les frères sont contigus dans l'arène, après leur parent
+    void link_children(GameNode& node, const GameState& state, const std::vector<Action>& actions);
+    
+    // Enfant i de node (next_state = état après l'action i), créé dans son
+    // emplacement réservé à la première visite; nullptr si terminal
+    GameNode* child_node(GameNode& node, size_t i, const GameState& next_state);
+    
+    // Détruit tous les nœuds et libère leurs valeurs
+    void reset_nodes();
+    
+    // Résolution multithread (CFRConfig::num_threads). Entre begin et end,
+    // get_or_create_node est appelable depuis plusieurs threads: recherche
+    // sans verrou dans un index à insertions seules, création sous verrou.
+    // Les liens parent-enfant ne sont alors ni créés ni suivis (link_children
+    // et child_node sans effet). Le reste de l'état du solveur ne change
+    // qu'entre deux blocs d'itérations, depuis le thread de solve().
+    void begin_concurrent_traversal();
+    void end_concurrent_traversal() { concurrent_traversal_ = false; }
+    bool concurrent_traversal() const { return concurrent_traversal_; }
+    // num_threads si la configuration permet le mode multithread, 1 sinon
+    // (avertissement: profilage matériel, stockage hors mémoire et limite
+    // mémoire autre que FAIL supposent une traversée sur un seul thread)
+    int traversal_threads() const;
+    // Dernière itération d'un bloc parallèle commencé à first: le bloc
+    // s'arrête avant la prochaine mesure (toutes les measure_every
+    // itérations), le prochain checkpoint ou rappel d'itération, et à last
+    int parallel_block_end(int first, int last, int measure_every) const;
+    
+    // Gains d'une partie jouée uniformément au hasard jusqu'à un état terminal
+    std::vector<double> sampled_rollout(GameState state, CounterRng& rng);
+    std::vector<double> sampled_rollout(GameState state) { return sampled_rollout(std::move(state), rollout_rng_); }
+    
+    // Contrôle de memory_limit_mb entre deux itérations; true si le solveur doit s'arrêter
+    bool enforce_memory_limit(int iteration);
+    // Politique FAIL: checkpoint de l'état courant puis message d'arrêt
+    void fail_on_memory_limit(int completed_iteration);
+    // Statut final: message de limite mémoire s'il y en a un
+    std::string status_message(bool converged) const;
+    // Fin d'itération: publie l'avancement lu par progress() (quelques
+    // stockages atomiques) et appelle iteration_callback_ si elle est due
+    void end_iteration(int iteration);
+    // Mesure d'exploitabilité en cours de résolution (affichage et progress_callback_)
+    void report_progress(const char* label, int iteration, double exploitability) const;
+    // calculate_exploitability() chronométrée (métrique EXPLOITABILITY)
+    double measure_exploitability(const GameState& root_state) const;
+    // Exploitabilité finale; non calculée après une demande d'arrêt
+    double final_exploitability(const GameState& root_state) const;
+    // Statistiques mémoire du résultat
+    void fill_memory_stats(CFRResult& result) const;
+    // Ouvre les compteurs du thread appelant si profile_hardware_counters
+    void start_profiling();
+    // Copie le profil dans le résultat et ferme les compteurs
+    void finish_profiling(CFRResult& result);
     
     // Génération de clé unique pour un état de jeu
     virtual std::string state_to_key(const GameState& state, int player) const;
+    
+    // Stratégie moyenne d'un infoset connu (nœud ou checkpoint de reprise), vide sinon
+    std::vector<double> find_average_strategy(const std::string& key) const;
+
+private:
+    size_t node_memory_bytes_;     // Somme des empreintes des nœuds créés
+    size_t last_memory_usage_;     // Pour estimer la croissance d'une itération
+    bool memory_limited_traversal_;
+    std::string memory_limit_message_;
+    CounterRng rollout_rng_;
+    std::atomic<bool> stop_requested_;
+    ProgressCallback progress_callback_;
+    IterationCallback iteration_callback_;
+    int iteration_callback_every_;
+    std::atomic<int> progress_iteration_;
+    mutable std::atomic<double> progress_exploitability_;
+    std::atomic<size_t> progress_infosets_;
+    std::atomic<size_t> progress_memory_bytes_;
+    bool concurrent_traversal_;
+    std::unique_ptr<ConcurrentNodeIndex> concurrent_nodes_;
+    std::mutex node_creation_mutex_;
+    
+    size_t memory_limit_bytes() const { return config_.memory_limit_mb * 1024 * 1024; }
+    void spill_infosets(int iteration);
 
 protected:
     // Fonction auxiliaire pour le calcul de la meilleure réponse, utilisable par les sous-classes
@@ -77,19 +323,41 @@ public:
     std::vector<double> get_strategy(const GameState& state, int player) const override;
     double calculate_exploitability(const GameState& root_state) const override;
     
-    void save_checkpoint(const std::string& filename) const override;
-    void load_checkpoint(const std::string& filename) override;
+    SolverType solver_type() const override;
+    
+    // Résolution distribuée (distributed_cfr.h): le coordinateur tient le
+    // nœud racine, chaque worker les sous-arbres de ses premières actions.
+    
+    // Une itération sur le sous-arbre de state, pour les probabilités
+    // d'atteinte de state fournies par le coordinateur; valeurs par joueur
+    std::vector<double> traverse_subtree(const GameState& state, const std::vector<double>& reach_probabilities,
+                                         int iteration);
+    // Stratégie courante (regret matching) du nœud state
+    std::vector<double> current_strategy(const GameState& state);
+    // Mise à jour de state à partir des valeurs de ses enfants, calculées
+    // ailleurs avec strategy (celle de current_strategy); valeurs par joueur
+    std::vector<double> update_from_children(const GameState& state, const std::vector<double>& reach_probabilities,
+                                             const std::vector<double>& strategy,
+                                             const std::vector<std::vector<double>>& child_values, int iteration);
+    // Fin d'une itération distribuée: compteur et avancement (progress())
+    void complete_iteration(int iteration);
     
 private:
     // Algorithme CFR récursif
     std::vector<double> cfr(const GameState& state, std::vector<Hand>& hands, 
-                           std::vector<double>& reach_probabilities, int iteration);
+                           std::vector<double>& reach_probabilities, int iteration,
+                           GameNode* cached_node = nullptr);
+    
+    // Regrets et somme des stratégies d'un nœud après le calcul des valeurs de ses actions
+    void update_node(GameNode& node, const std::vector<double>& strategy,
+                     const std::vector<double>& action_values, double node_value,
+                     double reach_probability, int iteration);
     
     // Calcul de la valeur d'un nœud terminal
     std::vector<double> get_terminal_values(const GameState& state, const std::vector<Hand>& hands) const;
     
     // Mise à jour des regrets avec discounting
-    void update_regrets_with_discounting(std::shared_ptr<GameNode> node, 
+    void update_regrets_with_discounting(GameNode& node, 
                                        const std::vector<double>& regrets, int iteration);
     
     // Calcul de la valeur d'une stratégie (helper pour calculate_exploitability)
@@ -106,21 +374,52 @@ public:
     std::vector<double> get_strategy(const GameState& state, int player) const override;
     double calculate_exploitability(const GameState& root_state) const override;
     
-    void save_checkpoint(const std::string& filename) const override;
-    void load_checkpoint(const std::string& filename) override;
+    SolverType solver_type() const override;
+    
+    // Ranges des joueurs pour les donnes (deal_sampler.h); joueur absent ou
+    // range vide: toutes les mains. Vérifiées au début de solve().
+    void set_ranges(std::vector<HandRange> ranges) { ranges_ = std::move(ranges); }
+    
+protected:
+    std::string save_solver_state() const override;
+    void restore_solver_state(const std::string& state) override;
+    bool uses_action_baselines() const override { return config_.use_baselines; }
+    
+    // Donneur de l'itération: tableau de state, ranges_
+    DealSampler make_deal_sampler(const GameState& state) const;
+    
+    // MCCFR avec échantillonnage (mains de deal dans state, tableau complété
+    // au showdown); valeurs du nœud pour chaque joueur. Accessible aux
+    // sous-classes pour mesurer l'estimateur (tools/vr_mccfr_benchmark.cpp).
+    std::vector<double> mccfr(const GameState& state, const Deal& deal, 
+                             std::vector<double>& reach_probabilities, int iteration, int player,
+                             CounterRng& rng, GameNode* cached_node = nullptr);
     
 private:
-    std::mt19937 rng_;
+    // Tirages de l'itération iteration: les mêmes quel que soit le thread
+    // qui l'exécute (et d'une reprise de checkpoint à l'autre)
+    CounterRng iteration_rng(int iteration) const { return CounterRng(seed_, static_cast<uint64_t>(iteration)); }
+    
+    std::vector<HandRange> ranges_;
     
-    // MCCFR avec échantillonnage
-    std::vector<double> mccfr(const GameState& state, const Hand& sampled_hand, 
-                             std::vector<double>& reach_probabilities, int iteration, int player);
+    // Itérations first..last sur threads threads (CFRConfig::num_threads);
+    // dernière itération terminée (avant last après une demande d'arrêt)
+    int parallel_iterations(const GameState& initial_state, const DealSampler& sampler,
+                            int first, int last, int threads);
     
-    // Échantillonner une main aléatoire compatible avec l'état
-    Hand sample_hand(const GameState& state);
+    // Une itération: donne (mains placées dans dealt_root, copie de la
+    // racine réutilisée d'une itération à l'autre), puis une traversée par joueur
+    void sampled_iteration(const DealSampler& sampler, int iteration, GameState& dealt_root, Deal& deal);
     
     // Échantillonner une action selon la stratégie
-    int sample_action(const std::vector<double>& strategy);
+    int sample_action(const std::vector<double>& strategy, CounterRng& rng);
+    
+    // VR-MCCFR: estimation de la valeur du nœud à partir de celle de
+    // l'action tirée, corrigée par les valeurs de référence (espérance
+    // inchangée, variance due au tirage de l'action retirée), puis
+    // apprentissage de la référence de cette action
+    std::vector<double> baseline_corrected_values(GameNode& node, const std::vector<double>& strategy,
+                                                  size_t sampled_action, const std::vector<double>& sampled_values);
     
     // Calcul de la valeur d'une stratégie (helper pour calculate_exploitability)
     double calculate_strategy_value(const GameState& state, int player) const;
@@ -135,29 +434,29 @@ public:
     std::vector<double> get_strategy(const GameState& state, int player) const override;
     double calculate_exploitability(const GameState& root_state) const override;
     
-    void save_checkpoint(const std::string& filename) const override;
-    void load_checkpoint(const std::string& filename) override;
+    SolverType solver_type() const override;
     
 private:
     // CFR+ utilise des regrets cumulés légèrement différents
     std::vector<double> cfr_plus(const GameState& state, std::vector<Hand>& hands,
-                                std::vector<double>& reach_probabilities, int iteration);
+                                std::vector<double>& reach_probabilities, int iteration,
+                                GameNode* cached_node = nullptr);
     
     // Regret matching + (ne garde que les regrets positifs)
-    std::vector<double> regret_matching_plus(const std::vector<double>& regrets) const;
+    std::vector<double> regret_matching_plus(const ValueSpan& regrets) const;
     
     // Calcul de la valeur d'une stratégie (helper pour calculate_exploitability)
     double calculate_strategy_value(const GameState& state, int player) const;
 };
 
+// Clé d'infoset de state pour player (celle de CFRSolver::state_to_key),
+// aussi utilisée pour interroger une solution exportée
+std::string infoset_key(const GameState& state, int player);
+
 // Factory pour créer le bon type de solveur
 class CFRSolverFactory {
 public:
-    enum class SolverType {
-        VANILLA_CFR,
-        CHANCE_SAMPLING_CFR, 
-        CFR_PLUS
-    };
+    using SolverType = poker::SolverType;
     
     static std::unique_ptr<CFRSolver> create_solver(
         SolverType type,
@@ -0,0 +1,597 @@
+#include "checkpoint.h"
+#include "binary_io.h"
+#include "compression.h"
+#include "metrics.h"
+#include "trace.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+#include <limits>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace poker {
+
+namespace {
+
+constexpr uint64_t SECTION_ALIGNMENT = 8;
+constexpr uint64_t VALUES_ALIGNMENT = 4096; // Une page: VALUES peut être mappée telle quelle
+
+struct PendingSection {
+    CheckpointSection id;
+    const void* data;
+    uint64_t size;
+    uint64_t alignment;
+    uint32_t flags;
+    uint64_t raw_size;
+};
+
+void write_all(int fd, const void* data, size_t size, const std::string& filename) {
+    const char* ptr = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::write(fd, ptr, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Écriture du checkpoint impossible: " + filename +
+                                     " (" + std::strerror(errno) + ")");
+        }
+        ptr += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+int compare_keys(const std::string& keys_a, const CheckpointIndexEntry& a,
+                 const std::string& keys_b, const CheckpointIndexEntry& b) {
+    if (a.key_hash != b.key_hash) return a.key_hash < b.key_hash ? -1 : 1;
+    return keys_a.compare(a.key_offset, a.key_length, keys_b, b.key_offset, b.key_length);
+}
+
+std::string directory_of(const std::string& filename) {
+    size_t slash = filename.find_last_of('/');
+    return slash == std::string::npos ? std::string() : filename.substr(0, slash + 1);
+}
+
+std::string basename_of(const std::string& filename) {
+    size_t slash = filename.find_last_of('/');
+    return slash == std::string::npos ? filename : filename.substr(slash + 1);
+}
+
+// Quantifie les valeurs dans l'ordre trié de l'index et réécrit index et clés
+// avec des offsets cumulés, pour que la trame serve de base au checkpoint suivant
+QuantizedFrame quantize_snapshot(const CheckpointSnapshot& snapshot, double step) {
+    QuantizedFrame frame;
+    frame.quantization_step = step;
+    frame.index.reserve(snapshot.index.size());
+    frame.keys.reserve(snapshot.keys.size());
+    frame.quantized.reserve(snapshot.values.size());
+
+    const double limit = static_cast<double>(std::numeric_limits<int64_t>::max() / 2);
+    for (const auto& source : snapshot.index) {
+        CheckpointIndexEntry entry = source;
+        entry.key_offset = frame.keys.size();
+        entry.value_offset = frame.quantized.size();
+        frame.index.push_back(entry);
+        frame.keys.append(snapshot.keys, source.key_offset, source.key_length);
+
+        for (uint64_t k = 0; k < 2ULL * source.num_actions; ++k) {
+            double scaled = snapshot.values[source.value_offset + k] / step;
+            if (!(std::fabs(scaled) < limit)) {
+                throw std::runtime_error("Valeur hors de la plage de quantification du checkpoint "
+                                         "(augmenter checkpoint_quantization_step)");
+            }
+            frame.quantized.push_back(std::llround(scaled));
+        }
+    }
+    return frame;
+}
+
+void write_sections(const std::string& filename, CheckpointHeader& header,
+                    const std::vector<PendingSection>& sections) {
+    const uint32_t num_sections = static_cast<uint32_t>(sections.size());
+    header.num_sections = num_sections;
+
+    std::vector<CheckpointSectionEntry> table(num_sections);
+    uint64_t offset = align_up(sizeof(CheckpointHeader) + num_sections * sizeof(CheckpointSectionEntry),
+                               SECTION_ALIGNMENT);
+    for (uint32_t i = 0; i < num_sections; ++i) {
+        offset = align_up(offset, sections[i].alignment);
+        table[i] = CheckpointSectionEntry{};
+        table[i].id = static_cast<uint32_t>(sections[i].id);
+        table[i].flags = sections[i].flags;
+        table[i].offset = offset;
+        table[i].size = sections[i].size;
+        table[i].raw_size = sections[i].raw_size;
+        table[i].crc = crc32(sections[i].data, sections[i].size);
+        offset += sections[i].size;
+    }
+
+    header.header_crc = 0;
+    header.header_crc = crc32(&header, sizeof(header));
+    header.header_crc = crc32(table.data(), table.size() * sizeof(CheckpointSectionEntry), header.header_crc);
+
+    const std::string tmp_filename = filename + ".tmp";
+    int fd = ::open(tmp_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Impossible de créer le checkpoint " + tmp_filename +
+                                 " (" + std::strerror(errno) + ")");
+    }
+
+    try {
+        write_all(fd, &header, sizeof(header), tmp_filename);
+        write_all(fd, table.data(), table.size() * sizeof(CheckpointSectionEntry), tmp_filename);
+
+        static const char padding[VALUES_ALIGNMENT] = {};
+        uint64_t position = sizeof(header) + table.size() * sizeof(CheckpointSectionEntry);
+        for (uint32_t i = 0; i < num_sections; ++i) {
+            write_all(fd, padding, table[i].offset - position, tmp_filename);
+            write_all(fd, sections[i].data, sections[i].size, tmp_filename);
+            position = table[i].offset + sections[i].size;
+        }
+
+        if (::fsync(fd) != 0) {
+            throw std::runtime_error("fsync du checkpoint impossible: " + tmp_filename);
+        }
+    } catch (...) {
+        ::close(fd);
+        ::unlink(tmp_filename.c_str());
+        throw;
+    }
+
+    ::close(fd);
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        ::unlink(tmp_filename.c_str());
+        throw std::runtime_error("Impossible de renommer le checkpoint vers " + filename);
+    }
+}
+
+} // namespace
+
+void CheckpointSnapshot::add_infoset(const std::string& key, const double* regret_sum,
+                                     const double* strategy_sum, size_t num_actions) {
+    CheckpointIndexEntry entry{};
+    entry.key_hash = fnv1a_64(key);
+    entry.key_offset = keys.size();
+    entry.key_length = static_cast<uint32_t>(key.size());
+    entry.num_actions = static_cast<uint32_t>(num_actions);
+    entry.value_offset = values.size();
+    index.push_back(entry);
+
+    keys += key;
+    values.insert(values.end(), regret_sum, regret_sum + num_actions);
+    values.insert(values.end(), strategy_sum, strategy_sum + num_actions);
+}
+
+void write_checkpoint_file(CheckpointSnapshot& snapshot, const std::string& filename,
+                           const CheckpointEncoding& encoding, QuantizedFrame* previous) {
+    metrics::ScopedTimer timer(metrics::Timer::CHECKPOINT_WRITE);
+    trace::Span span("checkpoint_write", "checkpoint");
+    // Ordre déterministe indépendant de l'itération sur la table de hachage
+    std::sort(snapshot.index.begin(), snapshot.index.end(),
+              [&snapshot](const CheckpointIndexEntry& a, const CheckpointIndexEntry& b) {
+                  return compare_keys(snapshot.keys, a, snapshot.keys, b) < 0;
+              });
+
+    CheckpointHeader header{};
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.solver_type = snapshot.solver_type;
+    header.config_hash = snapshot.config_hash;
+    header.iteration = snapshot.iteration;
+
+    if (!encoding.compact) {
+        write_sections(filename, header, {
+            {CheckpointSection::SOLVER_STATE, snapshot.solver_state.data(), snapshot.solver_state.size(),
+             SECTION_ALIGNMENT, 0, snapshot.solver_state.size()},
+            {CheckpointSection::INDEX, snapshot.index.data(), snapshot.index.size() * sizeof(CheckpointIndexEntry),
+             SECTION_ALIGNMENT, 0, snapshot.index.size() * sizeof(CheckpointIndexEntry)},
+            {CheckpointSection::KEYS, snapshot.keys.data(), snapshot.keys.size(),
+             SECTION_ALIGNMENT, 0, snapshot.keys.size()},
+            {CheckpointSection::VALUES, snapshot.values.data(), snapshot.values.size() * sizeof(double),
+             VALUES_ALIGNMENT, 0, snapshot.values.size() * sizeof(double)},
+        });
+        return;
+    }
+
+    if (!(encoding.quantization_step > 0.0)) {
+        throw std::runtime_error("checkpoint_quantization_step doit être strictement positif");
+    }
+    QuantizedFrame frame = quantize_snapshot(snapshot, encoding.quantization_step);
+    frame.filename = filename;
+    frame.iteration = snapshot.iteration;
+
+    // Delta uniquement contre une base de même pas, et trame complète
+    // régulière pour borner la chaîne de fichiers nécessaire à la reprise
+    const bool delta = previous && !previous->filename.empty() &&
+                       previous->quantization_step == encoding.quantization_step &&
+                       previous->chain_length + 1 < encoding.keyframe_interval &&
+                       previous->chain_length + 1 <= MAX_DELTA_CHAIN_LENGTH;
+
+    std::string index_bytes;
+    for (const auto& entry : frame.index) {
+        put_varint(index_bytes, entry.key_length);
+        put_varint(index_bytes, entry.num_actions);
+    }
+
+    // Jointure sur l'ordre (hash, clé) commun aux deux trames: un infoset
+    // absent de la base ou de taille différente est stocké en valeur absolue
+    std::string value_bytes;
+    size_t base_pos = 0;
+    for (const auto& entry : frame.index) {
+        const int64_t* base_values = nullptr;
+        if (delta) {
+            while (base_pos < previous->index.size() &&
+                   compare_keys(previous->keys, previous->index[base_pos], frame.keys, entry) < 0) {
+                ++base_pos;
+            }
+            if (base_pos < previous->index.size() &&
+                compare_keys(previous->keys, previous->index[base_pos], frame.keys, entry) == 0 &&
+                previous->index[base_pos].num_actions == entry.num_actions) {
+                base_values = previous->quantized.data() + previous->index[base_pos].value_offset;
+            }
+        }
+        const int64_t* values = frame.quantized.data() + entry.value_offset;
+        for (uint64_t k = 0; k < 2ULL * entry.num_actions; ++k) {
+            put_varint(value_bytes, zigzag_encode(base_values ? values[k] - base_values[k] : values[k]));
+        }
+    }
+
+    std::string encoding_bytes(sizeof(CheckpointEncodingInfo), '\0');
+    CheckpointEncodingInfo info{encoding.quantization_step, delta ? previous->iteration : 0,
+                                delta ? previous->header_crc : 0, 0};
+    std::memcpy(&encoding_bytes[0], &info, sizeof(info));
+    if (delta) {
+        // Nom relatif: la chaîne reste valide si le répertoire est déplacé
+        encoding_bytes += basename_of(previous->filename);
+    }
+
+    const std::string index_block = compress_block(index_bytes.data(), index_bytes.size());
+    const std::string keys_block = compress_block(frame.keys.data(), frame.keys.size());
+    const std::string values_block = compress_block(value_bytes.data(), value_bytes.size());
+    const uint32_t values_flags = SECTION_COMPRESSED | SECTION_QUANTIZED | (delta ? uint32_t(SECTION_DELTA) : 0u);
+
+    write_sections(filename, header, {
+        {CheckpointSection::SOLVER_STATE, snapshot.solver_state.data(), snapshot.solver_state.size(),
+         SECTION_ALIGNMENT, 0, snapshot.solver_state.size()},
+        {CheckpointSection::ENCODING, encoding_bytes.data(), encoding_bytes.size(),
+         SECTION_ALIGNMENT, 0, encoding_bytes.size()},
+        {CheckpointSection::INDEX, index_block.data(), index_block.size(),
+         SECTION_ALIGNMENT, SECTION_COMPRESSED | SECTION_VARINT_INDEX, index_bytes.size()},
+        {CheckpointSection::KEYS, keys_block.data(), keys_block.size(),
+         SECTION_ALIGNMENT, SECTION_COMPRESSED, frame.keys.size()},
+        {CheckpointSection::VALUES, values_block.data(), values_block.size(),
+         SECTION_ALIGNMENT, values_flags, value_bytes.size()},
+    });
+
+    if (previous) {
+        frame.chain_length = delta ? previous->chain_length + 1 : 0;
+        frame.header_crc = header.header_crc;
+        *previous = std::move(frame);
+    }
+}
+
+// MappedCheckpoint implementation
+MappedCheckpoint::MappedCheckpoint(const std::string& filename, bool verify_sections)
+    : MappedCheckpoint(filename, verify_sections, 0) {}
+
+MappedCheckpoint::MappedCheckpoint(const std::string& filename, bool verify_sections, int chain_depth)
+    : filename_(filename), base_(nullptr), size_(0), header_{}, index_(nullptr), num_entries_(0),
+      keys_(nullptr), keys_size_(0), values_(nullptr), num_values_(0) {
+    
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Impossible d'ouvrir le checkpoint " + filename);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(CheckpointHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Checkpoint tronqué (en-tête): " + filename);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    
+    // PROT_WRITE + MAP_PRIVATE: le solveur met à jour les valeurs en place sans toucher au fichier
+    base_ = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base_ == MAP_FAILED) {
+        base_ = nullptr;
+        throw std::runtime_error("mmap du checkpoint impossible: " + filename + " (" + std::strerror(errno) + ")");
+    }
+    
+    try {
+        const char* bytes = static_cast<const char*>(base_);
+        std::memcpy(&header_, bytes, sizeof(header_));
+        if (std::memcmp(header_.magic, CHECKPOINT_MAGIC, sizeof(header_.magic)) != 0) {
+            throw std::runtime_error("Fichier de checkpoint invalide (magic): " + filename);
+        }
+        if (header_.version < 1 || header_.version > CHECKPOINT_VERSION) {
+            throw std::runtime_error("Version de checkpoint non supportée (" +
+                                     std::to_string(header_.version) + "): " + filename);
+        }
+        
+        size_t table_size = static_cast<size_t>(header_.num_sections) * sizeof(CheckpointSectionEntry);
+        if (sizeof(CheckpointHeader) + table_size > size_) {
+            throw std::runtime_error("Checkpoint tronqué (table des sections): " + filename);
+        }
+        std::vector<CheckpointSectionEntry> table(header_.num_sections);
+        std::memcpy(table.data(), bytes + sizeof(CheckpointHeader), table_size);
+        
+        CheckpointHeader zeroed = header_;
+        zeroed.header_crc = 0;
+        uint32_t actual_crc = crc32(&zeroed, sizeof(zeroed));
+        actual_crc = crc32(table.data(), table_size, actual_crc);
+        if (actual_crc != header_.header_crc) {
+            throw std::runtime_error("En-tête de checkpoint corrompu (CRC): " + filename);
+        }
+        
+        bool compact = false;
+        for (const auto& section : table) {
+            if (section.offset > size_ || section.size > size_ - section.offset) {
+                throw std::runtime_error("Checkpoint tronqué (section " + std::to_string(section.id) + "): " + filename);
+            }
+            const char* data = bytes + section.offset;
+            if ((verify_sections || section.flags != 0) && crc32(data, section.size) != section.crc) {
+                throw std::runtime_error("Section de checkpoint corrompue (CRC, section " +
+                                         std::to_string(section.id) + "): " + filename);
+            }
+            if (section.flags != 0 || section.id == static_cast<uint32_t>(CheckpointSection::ENCODING)) {
+                compact = true;
+                continue; // Décodé par decode_compact
+            }
+            
+            switch (static_cast<CheckpointSection>(section.id)) {
+                case CheckpointSection::SOLVER_STATE:
+                    solver_state_.assign(data, section.size);
+                    break;
+                case CheckpointSection::INDEX:
+                    index_ = reinterpret_cast<const CheckpointIndexEntry*>(data);
+                    num_entries_ = section.size / sizeof(CheckpointIndexEntry);
+                    // Les recherches dichotomiques toucheront tout l'index: lecture anticipée
+                    ::madvise(const_cast<char*>(data) - (section.offset % VALUES_ALIGNMENT),
+                              section.size + (section.offset % VALUES_ALIGNMENT), MADV_WILLNEED);
+                    break;
+                case CheckpointSection::KEYS:
+                    keys_ = data;
+                    keys_size_ = section.size;
+                    break;
+                case CheckpointSection::VALUES:
+                    values_ = reinterpret_cast<double*>(const_cast<char*>(data));
+                    num_values_ = section.size / sizeof(double);
+                    break;
+                default:
+                    // Sections inconnues ignorées pour la compatibilité ascendante
+                    break;
+            }
+        }
+        
+        if (compact) {
+            decode_compact(table, verify_sections, chain_depth);
+            // Tout est décodé dans des tampons propres: le fichier n'est plus nécessaire
+            ::munmap(base_, size_);
+            base_ = nullptr;
+        }
+    } catch (...) {
+        if (base_) {
+            ::munmap(base_, size_);
+            base_ = nullptr;
+        }
+        throw;
+    }
+}
+
+void MappedCheckpoint::decode_compact(const std::vector<CheckpointSectionEntry>& table, bool verify_sections,
+                                      int chain_depth) {
+    const char* bytes = static_cast<const char*>(base_);
+    auto section_of = [&](CheckpointSection id) -> const CheckpointSectionEntry& {
+        for (const auto& section : table) {
+            if (section.id == static_cast<uint32_t>(id)) return section;
+        }
+        throw std::runtime_error("Section " + std::to_string(static_cast<uint32_t>(id)) +
+                                 " manquante dans le checkpoint: " + filename_);
+    };
+    auto decode = [&](const CheckpointSectionEntry& section) {
+        std::string raw;
+        if (section.flags & SECTION_COMPRESSED) {
+            raw.resize(section.raw_size);
+            decompress_block(bytes + section.offset, section.size, &raw[0], raw.size());
+        } else {
+            raw.assign(bytes + section.offset, section.size);
+        }
+        return raw;
+    };
+    
+    // Version 2: pas de base_header_crc, la base n'est identifiée que par son itération
+    const size_t info_size = header_.version >= 3 ? sizeof(CheckpointEncodingInfo)
+                                                  : offsetof(CheckpointEncodingInfo, base_header_crc);
+    const CheckpointSectionEntry& encoding_section = section_of(CheckpointSection::ENCODING);
+    if (encoding_section.size < info_size) {
+        throw std::runtime_error("Section ENCODING tronquée: " + filename_);
+    }
+    CheckpointEncodingInfo info{};
+    std::memcpy(&info, bytes + encoding_section.offset, info_size);
+    std::string base_name(bytes + encoding_section.offset + info_size, encoding_section.size - info_size);
+    
+    // Index: longueurs de clé et nombres d'actions; hashes et offsets recalculés
+    owned_keys_ = decode(section_of(CheckpointSection::KEYS));
+    const std::string index_bytes = decode(section_of(CheckpointSection::INDEX));
+    const char* ptr = index_bytes.data();
+    const char* end = ptr + index_bytes.size();
+    uint64_t key_offset = 0;
+    uint64_t value_offset = 0;
+    while (ptr < end) {
+        CheckpointIndexEntry entry{};
+        uint64_t key_length = get_varint(ptr, end);
+        uint64_t num_actions = get_varint(ptr, end);
+        if (key_length > owned_keys_.size() - key_offset || num_actions > UINT32_MAX) {
+            throw std::runtime_error("Index de checkpoint incohérent: " + filename_);
+        }
+        entry.key_offset = key_offset;
+        entry.key_length = static_cast<uint32_t>(key_length);
+        entry.num_actions = static_cast<uint32_t>(num_actions);
+        entry.key_hash = fnv1a_64(owned_keys_.data() + key_offset, key_length);
+        entry.value_offset = value_offset;
+        owned_index_.push_back(entry);
+        key_offset += key_length;
+        value_offset += 2 * num_actions;
+    }
+    
+    const CheckpointSectionEntry& values_section = section_of(CheckpointSection::VALUES);
+    const std::string value_bytes = decode(values_section);
+    quantized_.reserve(std::min<uint64_t>(value_offset, value_bytes.size()));
+    ptr = value_bytes.data();
+    end = ptr + value_bytes.size();
+    while (ptr < end) {
+        quantized_.push_back(zigzag_decode(get_varint(ptr, end)));
+    }
+    if (quantized_.size() != value_offset) {
+        throw std::runtime_error("Section VALUES incohérente avec l'index: " + filename_);
+    }
+    
+    if (values_section.flags & SECTION_DELTA) {
+        // La base est elle-même décodée récursivement; un fichier qui se
+        // désigne lui-même ou une chaîne trop longue s'arrête ici
+        if (chain_depth >= MAX_DELTA_CHAIN_LENGTH) {
+            throw std::runtime_error("Chaîne de deltas de plus de " + std::to_string(MAX_DELTA_CHAIN_LENGTH) +
+                                     " checkpoints: " + filename_);
+        }
+        MappedCheckpoint base(directory_of(filename_) + base_name, verify_sections, chain_depth + 1);
+        if (base.header_.iteration != info.base_iteration || base.header_.solver_type != header_.solver_type ||
+            (header_.version >= 3 && base.header_.header_crc != info.base_header_crc) || base.quantized_.empty()) {
+            throw std::runtime_error("Checkpoint de base incompatible (" + base_name + "): " + filename_);
+        }
+        for (const auto& entry : owned_index_) {
+            const CheckpointIndexEntry* base_entry =
+                base.find(std::string(owned_keys_.data() + entry.key_offset, entry.key_length));
+            if (!base_entry || base_entry->num_actions != entry.num_actions) {
+                continue; // Stocké en valeur absolue
+            }
+            for (uint64_t k = 0; k < 2ULL * entry.num_actions; ++k) {
+                quantized_[entry.value_offset + k] += base.quantized_[base_entry->value_offset + k];
+            }
+        }
+    }
+    
+    owned_values_.resize(quantized_.size());
+    for (size_t i = 0; i < quantized_.size(); ++i) {
+        owned_values_[i] = static_cast<double>(quantized_[i]) * info.quantization_step;
+    }
+    
+    index_ = owned_index_.data();
+    num_entries_ = owned_index_.size();
+    keys_ = owned_keys_.data();
+    keys_size_ = owned_keys_.size();
+    values_ = owned_values_.data();
+    num_values_ = owned_values_.size();
+}
+
+MappedCheckpoint::~MappedCheckpoint() {
+    if (base_) {
+        ::munmap(base_, size_);
+    }
+}
+
+bool MappedCheckpoint::entry_in_bounds(const CheckpointIndexEntry& entry) const {
+    // Vérification à l'accès plutôt qu'au chargement pour garder une reprise en O(1)
+    return entry.key_offset <= keys_size_ && entry.key_length <= keys_size_ - entry.key_offset &&
+           entry.value_offset <= num_values_ && 2ULL * entry.num_actions <= num_values_ - entry.value_offset;
+}
+
+std::string MappedCheckpoint::key_of(const CheckpointIndexEntry& entry) const {
+    if (!entry_in_bounds(entry)) {
+        throw std::runtime_error("Index de checkpoint incohérent: " + filename_);
+    }
+    return std::string(keys_ + entry.key_offset, entry.key_length);
+}
+
+const CheckpointIndexEntry* MappedCheckpoint::find(const std::string& key) const {
+    uint64_t hash = fnv1a_64(key);
+    const CheckpointIndexEntry* end = index_ + num_entries_;
+    const CheckpointIndexEntry* it = std::lower_bound(index_, end, hash,
+        [](const CheckpointIndexEntry& entry, uint64_t h) { return entry.key_hash < h; });
+    
+    for (; it != end && it->key_hash == hash; ++it) {
+        if (entry_in_bounds(*it) && it->key_length == key.size() &&
+            std::memcmp(keys_ + it->key_offset, key.data(), key.size()) == 0) {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+// CheckpointWriter implementation
+CheckpointWriter::CheckpointWriter(const CheckpointEncoding& encoding, bool asynchronous)
+    : encoding_(encoding), asynchronous_(asynchronous), busy_(false), stopping_(false) {
+    if (asynchronous_) {
+        thread_ = std::thread(&CheckpointWriter::run, this);
+    }
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void CheckpointWriter::submit(CheckpointSnapshot snapshot, const std::string& filename) {
+    if (!asynchronous_) {
+        Job job{std::move(snapshot), filename};
+        write(job);
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !pending_; });
+    pending_.reset(new Job{std::move(snapshot), filename});
+    lock.unlock();
+    cv_.notify_all();
+}
+
+void CheckpointWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !pending_ && !busy_; });
+}
+
+void CheckpointWriter::write(Job& job) {
+    try {
+        write_checkpoint_file(job.snapshot, job.filename, encoding_,
+                              encoding_.compact ? &previous_frame_ : nullptr);
+        std::cout << ("Checkpoint sauvegardé: " + job.filename + "\n") << std::flush;
+    } catch (const std::exception& e) {
+        // Le prochain checkpoint ne doit pas dépendre d'une base absente
+        previous_frame_ = QuantizedFrame{};
+        std::cerr << ("Erreur: " + std::string(e.what()) + "\n") << std::flush;
+    }
+}
+
+void CheckpointWriter::run() {
+    trace::set_thread_name("checkpoint writer");
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return pending_ || stopping_; });
+        if (!pending_) {
+            return; // stopping_ et plus rien à écrire
+        }
+
+        std::unique_ptr<Job> job = std::move(pending_);
+        busy_ = true;
+        lock.unlock();
+        cv_.notify_all();
+
+        write(*job);
+        job.reset();
+
+        lock.lock();
+        busy_ = false;
+        cv_.notify_all();
+    }
+}
+
+} // namespace poker
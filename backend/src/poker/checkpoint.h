@@ -0,0 +1,233 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace poker {
+
+// Format de checkpoint binaire versionné, commun à tous les solveurs.
+//
+// Disposition du fichier:
+//   CheckpointHeader (64 octets)
+//   CheckpointSectionEntry x num_sections
+//   sections (alignées sur 8 octets, VALUES alignée sur une page)
+//
+// Le fichier est écrit dans "<nom>.tmp" puis renommé, de sorte qu'un
+// checkpoint visible sur le disque est toujours complet. INDEX étant trié
+// par key_hash et VALUES aligné sur une page, un checkpoint brut peut être
+// mappé et interrogé sans désérialisation (voir MappedCheckpoint).
+//
+// En mode compact (CheckpointEncoding), les valeurs sont quantifiées et
+// codées en delta par rapport au checkpoint précédent, l'index est codé en
+// varints et chaque section est compressée (compression.h). Un checkpoint
+// compact doit être décodé à la reprise et nécessite sa chaîne de bases.
+
+constexpr char CHECKPOINT_MAGIC[8] = {'G', 'T', 'O', 'C', 'K', 'P', 'T', '\0'};
+// 2: encodages compacts (flags de section); 3: un delta porte le CRC
+// d'en-tête de sa base (disposition brute inchangée depuis la version 2)
+constexpr uint32_t CHECKPOINT_VERSION = 3;
+
+// Deltas au plus entre un checkpoint compact et sa trame complète: borne la
+// récursion de la lecture, quel que soit keyframe_interval
+constexpr int MAX_DELTA_CHAIN_LENGTH = 256;
+
+enum class CheckpointSection : uint32_t {
+    SOLVER_STATE = 1, // État propre au solveur (ex: générateur aléatoire MCCFR)
+    INDEX = 2,        // CheckpointIndexEntry par infoset, triées par key_hash
+    KEYS = 3,         // Clés des infosets concaténées
+    VALUES = 4,       // Par infoset: regret_sum[n] puis strategy_sum[n] (double)
+    ENCODING = 5      // CheckpointEncodingInfo suivi du nom du checkpoint de base (mode compact)
+};
+
+// Flags de CheckpointSectionEntry::flags
+enum CheckpointSectionFlags : uint32_t {
+    SECTION_COMPRESSED = 1u << 0,   // Bloc compressé; raw_size = taille décodée
+    SECTION_VARINT_INDEX = 1u << 1, // INDEX: varint(key_length), varint(num_actions) par infoset
+    SECTION_QUANTIZED = 1u << 2,    // VALUES: zigzag varint de round(valeur / quantization_step)
+    SECTION_DELTA = 1u << 3         // VALUES: différences avec le checkpoint de base
+};
+
+struct CheckpointEncodingInfo {
+    double quantization_step;
+    uint64_t base_iteration;        // 0 si pas de base (checkpoint complet)
+    // Depuis la version 3: header_crc de la base, qui identifie le fichier
+    // (itération, configuration et CRC de chaque section). Un delta n'est
+    // décodé que contre la base exacte dont il a été tiré.
+    uint32_t base_header_crc;
+    uint32_t reserved;
+};
+
+struct CheckpointHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t solver_type;   // Valeur de SolverType
+    uint64_t config_hash;   // CFRConfig::hash() au moment de la sauvegarde
+    uint64_t iteration;
+    uint32_t num_sections;
+    uint32_t header_crc;    // CRC32 de l'en-tête (ce champ à zéro) et de la table des sections
+    uint8_t reserved[24];
+};
+static_assert(sizeof(CheckpointHeader) == 64, "CheckpointHeader doit faire 64 octets");
+
+struct CheckpointSectionEntry {
+    uint32_t id;
+    uint32_t flags;         // Encodage de la section (0 = brut)
+    uint64_t offset;        // Depuis le début du fichier
+    uint64_t size;          // Taille stockée
+    uint64_t raw_size;      // Taille décodée
+    uint32_t crc;           // CRC32 des octets stockés
+    uint32_t reserved;
+};
+static_assert(sizeof(CheckpointSectionEntry) == 40, "CheckpointSectionEntry doit faire 40 octets");
+
+struct CheckpointIndexEntry {
+    uint64_t key_hash;      // fnv1a_64 de la clé
+    uint64_t key_offset;    // Dans la section KEYS
+    uint32_t key_length;
+    uint32_t num_actions;
+    uint64_t value_offset;  // En doubles, dans la section VALUES
+};
+static_assert(sizeof(CheckpointIndexEntry) == 32, "CheckpointIndexEntry doit faire 32 octets");
+
+// Copie cohérente de l'état d'un solveur, prise entre deux itérations
+struct CheckpointSnapshot {
+    uint32_t solver_type = 0;
+    uint64_t config_hash = 0;
+    uint64_t iteration = 0;
+    std::vector<CheckpointIndexEntry> index;
+    std::string keys;
+    std::vector<double> values;
+    std::string solver_state;
+
+    // Ajoute un infoset; les entrées sont triées par write_checkpoint_file
+    void add_infoset(const std::string& key, const double* regret_sum,
+                     const double* strategy_sum, size_t num_actions);
+};
+
+struct CheckpointEncoding {
+    bool compact = false;            // Quantification + delta + index varint + compression
+    double quantization_step = 1e-6; // Erreur absolue maximale: quantization_step / 2
+    int keyframe_interval = 10;      // Un checkpoint complet tous les N checkpoints compacts
+};
+
+// Dernier checkpoint compact écrit, base du codage delta du suivant
+struct QuantizedFrame {
+    std::string filename;
+    uint64_t iteration = 0;
+    double quantization_step = 0.0;
+    int chain_length = 0;                    // Deltas écrits depuis le dernier checkpoint complet
+    uint32_t header_crc = 0;                 // header_crc du fichier écrit
+    std::vector<CheckpointIndexEntry> index; // Trié par (key_hash, clé), offsets cumulés
+    std::string keys;
+    std::vector<int64_t> quantized;          // Valeurs absolues quantifiées
+};
+
+// Écrit le snapshot de manière atomique (fichier temporaire + rename).
+// En mode compact, previous (s'il est fourni) sert de base delta puis est
+// remplacé par la trame écrite. Lève std::runtime_error en cas d'échec.
+void write_checkpoint_file(CheckpointSnapshot& snapshot, const std::string& filename,
+                           const CheckpointEncoding& encoding = CheckpointEncoding{},
+                           QuantizedFrame* previous = nullptr);
+
+// Checkpoint mappé en mémoire (MAP_PRIVATE). Les tableaux de la section
+// VALUES servent directement de stockage vivant à la reprise: les écritures
+// restent privées au processus (copy-on-write) et ne modifient jamais le
+// fichier, et seules les pages effectivement visitées sont lues du disque.
+// Un checkpoint compact est décodé en mémoire et expose la même interface.
+class MappedCheckpoint {
+public:
+    // Valide l'en-tête et la table des sections (CRC). verify_sections vérifie
+    // aussi le CRC de chaque section brute, ce qui lit le fichier en entier
+    // (les sections encodées sont toujours vérifiées avant décodage).
+    // Lève std::runtime_error si le fichier est absent, tronqué ou corrompu.
+    MappedCheckpoint(const std::string& filename, bool verify_sections);
+    ~MappedCheckpoint();
+    
+    MappedCheckpoint(const MappedCheckpoint&) = delete;
+    MappedCheckpoint& operator=(const MappedCheckpoint&) = delete;
+    
+    const CheckpointHeader& header() const { return header_; }
+    const std::string& solver_state() const { return solver_state_; }
+    
+    size_t num_infosets() const { return num_entries_; }
+    const CheckpointIndexEntry& entry(size_t i) const { return index_[i]; }
+    std::string key_of(const CheckpointIndexEntry& entry) const;
+    
+    // Recherche dichotomique par hash dans l'index mappé, nullptr si absent
+    const CheckpointIndexEntry* find(const std::string& key) const;
+    
+    // regret_sum[num_actions] suivi de strategy_sum[num_actions]
+    double* values(const CheckpointIndexEntry& entry) const { return values_ + entry.value_offset; }
+    
+    bool is_compact() const { return !quantized_.empty() || !owned_values_.empty(); }
+    
+private:
+    std::string filename_;
+    void* base_;
+    size_t size_;
+    CheckpointHeader header_;
+    std::string solver_state_;
+    const CheckpointIndexEntry* index_;
+    size_t num_entries_;
+    const char* keys_;
+    size_t keys_size_;
+    double* values_;
+    size_t num_values_;
+    
+    // Sections décodées d'un checkpoint compact
+    std::vector<CheckpointIndexEntry> owned_index_;
+    std::string owned_keys_;
+    std::vector<double> owned_values_;
+    std::vector<int64_t> quantized_; // Base des checkpoints delta qui en dépendent
+    
+    // chain_depth: rang dans une chaîne de deltas en cours de décodage
+    MappedCheckpoint(const std::string& filename, bool verify_sections, int chain_depth);
+    
+    bool entry_in_bounds(const CheckpointIndexEntry& entry) const;
+    void decode_compact(const std::vector<CheckpointSectionEntry>& table, bool verify_sections, int chain_depth);
+};
+
+// Écrit les checkpoints périodiques et conserve la trame de base du codage
+// delta. En mode asynchrone, l'écriture se fait depuis un thread
+// d'arrière-plan pour ne pas bloquer la boucle d'itérations; au plus un
+// snapshot en attente: si le précédent n'a pas encore été pris en charge,
+// submit() attend qu'il le soit.
+class CheckpointWriter {
+public:
+    CheckpointWriter(const CheckpointEncoding& encoding, bool asynchronous);
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    void submit(CheckpointSnapshot snapshot, const std::string& filename);
+
+    // Attend la fin de toutes les écritures planifiées
+    void flush();
+
+private:
+    struct Job {
+        CheckpointSnapshot snapshot;
+        std::string filename;
+    };
+
+    void run();
+    void write(Job& job);
+
+    CheckpointEncoding encoding_;
+    QuantizedFrame previous_frame_;
+    bool asynchronous_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unique_ptr<Job> pending_;
+    bool busy_;
+    bool stopping_;
+    std::thread thread_;
+};
+
+} // namespace poker
@@ -0,0 +1,251 @@
+#include "checkpoint_merge.h"
+#include "binary_io.h"
+#include "cfr_solver.h"
+#include "checkpoint.h"
+#include "trace.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace poker {
+
+namespace {
+
+// Disposition de write_checkpoint_file pour un checkpoint brut
+constexpr uint64_t SECTION_ALIGNMENT = 8;
+constexpr uint64_t VALUES_ALIGNMENT = 4096;
+constexpr uint32_t NUM_SECTIONS = 4;
+constexpr size_t WRITE_BUFFER_BYTES = 1u << 20;
+
+std::runtime_error write_error(const std::string& filename) {
+    return std::runtime_error("Écriture du checkpoint impossible: " + filename + " (" + std::strerror(errno) + ")");
+}
+
+void pwrite_all(int fd, const void* data, size_t size, uint64_t offset, const std::string& filename) {
+    const char* ptr = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::pwrite(fd, ptr, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw write_error(filename);
+        }
+        ptr += written;
+        size -= static_cast<size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+}
+
+// Section de la sortie remplie séquentiellement depuis sa position, CRC au fil de l'eau
+class SectionWriter {
+public:
+    SectionWriter(int fd, uint64_t offset, const std::string& filename)
+        : fd_(fd), offset_(offset), filename_(filename) {}
+
+    void append(const void* data, size_t size) {
+        buffer_.append(static_cast<const char*>(data), size);
+        crc_ = crc32(data, size, crc_);
+        if (buffer_.size() >= WRITE_BUFFER_BYTES) {
+            flush();
+        }
+    }
+
+    void flush() {
+        pwrite_all(fd_, buffer_.data(), buffer_.size(), offset_, filename_);
+        offset_ += buffer_.size();
+        buffer_.clear();
+    }
+
+    uint32_t crc() const { return crc_; }
+
+private:
+    int fd_;
+    uint64_t offset_;
+    const std::string& filename_;
+    std::string buffer_;
+    uint32_t crc_ = 0;
+};
+
+// Position d'une entrée dans son index trié par (key_hash, clé)
+struct Cursor {
+    const MappedCheckpoint* checkpoint = nullptr;
+    size_t position = 0;
+    std::string key;
+
+    bool done() const { return position == checkpoint->num_infosets(); }
+    const CheckpointIndexEntry& entry() const { return checkpoint->entry(position); }
+    void load_key() {
+        if (!done()) key = checkpoint->key_of(entry());
+    }
+    bool before(const Cursor& other) const {
+        uint64_t hash = entry().key_hash;
+        uint64_t other_hash = other.entry().key_hash;
+        return hash != other_hash ? hash < other_hash : key < other.key;
+    }
+};
+
+// Infosets de toutes les entrées dans l'ordre (key_hash, clé), une fois
+// chacun: visit(clé, hash, curseurs positionnés sur cet infoset)
+template <typename Visit>
+void for_each_merged_infoset(const std::vector<std::unique_ptr<MappedCheckpoint>>& checkpoints, Visit visit) {
+    std::vector<Cursor> cursors;
+    for (const auto& checkpoint : checkpoints) {
+        cursors.push_back({checkpoint.get(), 0, std::string()});
+        cursors.back().load_key();
+    }
+    std::vector<Cursor*> matching;
+    for (;;) {
+        const Cursor* first = nullptr;
+        for (const Cursor& cursor : cursors) {
+            if (!cursor.done() && (!first || cursor.before(*first))) {
+                first = &cursor;
+            }
+        }
+        if (!first) {
+            return;
+        }
+        matching.clear();
+        for (Cursor& cursor : cursors) {
+            if (!cursor.done() && cursor.entry().key_hash == first->entry().key_hash && cursor.key == first->key) {
+                matching.push_back(&cursor);
+            }
+        }
+        visit(first->key, first->entry().key_hash, matching);
+        for (Cursor* cursor : matching) {
+            ++cursor->position;
+            cursor->load_key();
+        }
+    }
+}
+
+} // namespace
+
+CheckpointMergeSummary merge_checkpoint_files(const std::vector<std::string>& inputs, const std::string& output) {
+    trace::Span span("checkpoint_merge", "checkpoint");
+    if (inputs.empty()) {
+        throw std::runtime_error("Aucun checkpoint à fusionner");
+    }
+
+    CheckpointMergeSummary summary;
+    std::vector<std::unique_ptr<MappedCheckpoint>> checkpoints;
+    for (const std::string& input : inputs) {
+        checkpoints.push_back(std::make_unique<MappedCheckpoint>(input, false));
+        const CheckpointHeader& header = checkpoints.back()->header();
+        const CheckpointHeader& first = checkpoints.front()->header();
+        if (header.solver_type != static_cast<uint32_t>(SolverType::CHANCE_SAMPLING_CFR)) {
+            throw std::runtime_error("Le checkpoint " + input + " ne vient pas de ChanceSamplingCFR: seuls des "
+                                     "regrets non pondérés s'additionnent");
+        }
+        if (header.config_hash != first.config_hash) {
+            throw std::runtime_error("Le checkpoint " + input + " a été produit avec une autre configuration que " +
+                                     inputs.front());
+        }
+        summary.iterations += header.iteration;
+    }
+
+    // Premier passage sur les index seuls: tailles des sections
+    uint64_t keys_size = 0;
+    uint64_t num_values = 0;
+    for_each_merged_infoset(checkpoints, [&](const std::string& key, uint64_t, const std::vector<Cursor*>& found) {
+        uint32_t num_actions = found.front()->entry().num_actions;
+        for (const Cursor* cursor : found) {
+            if (cursor->entry().num_actions != num_actions) {
+                throw std::runtime_error("Nombre d'actions différent selon les checkpoints pour l'infoset " + key);
+            }
+        }
+        ++summary.infosets;
+        keys_size += key.size();
+        num_values += 2ULL * num_actions;
+    });
+
+    CheckpointHeader header{};
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.solver_type = checkpoints.front()->header().solver_type;
+    header.config_hash = checkpoints.front()->header().config_hash;
+    header.iteration = summary.iterations;
+    header.num_sections = NUM_SECTIONS;
+
+    const CheckpointSection ids[NUM_SECTIONS] = {CheckpointSection::SOLVER_STATE, CheckpointSection::INDEX,
+                                                 CheckpointSection::KEYS, CheckpointSection::VALUES};
+    const uint64_t sizes[NUM_SECTIONS] = {0, summary.infosets * sizeof(CheckpointIndexEntry), keys_size,
+                                          num_values * sizeof(double)};
+    CheckpointSectionEntry table[NUM_SECTIONS] = {};
+    uint64_t offset = align_up(sizeof(CheckpointHeader) + sizeof(table), SECTION_ALIGNMENT);
+    for (uint32_t i = 0; i < NUM_SECTIONS; ++i) {
+        offset = align_up(offset, ids[i] == CheckpointSection::VALUES ? VALUES_ALIGNMENT : SECTION_ALIGNMENT);
+        table[i].id = static_cast<uint32_t>(ids[i]);
+        table[i].offset = offset;
+        table[i].size = sizes[i];
+        table[i].raw_size = sizes[i];
+        offset += sizes[i];
+    }
+
+    const std::string tmp_filename = output + ".tmp";
+    int fd = ::open(tmp_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Impossible de créer le checkpoint " + tmp_filename + " (" + std::strerror(errno) + ")");
+    }
+    try {
+        // Second passage: valeurs additionnées, écrites dans l'ordre de l'index
+        SectionWriter index(fd, table[1].offset, tmp_filename);
+        SectionWriter keys(fd, table[2].offset, tmp_filename);
+        SectionWriter values(fd, table[3].offset, tmp_filename);
+        uint64_t key_offset = 0;
+        uint64_t value_offset = 0;
+        std::vector<double> sums;
+        for_each_merged_infoset(checkpoints, [&](const std::string& key, uint64_t hash,
+                                                 const std::vector<Cursor*>& found) {
+            uint32_t num_actions = found.front()->entry().num_actions;
+            sums.assign(2 * num_actions, 0.0);
+            for (const Cursor* cursor : found) {
+                const double* source = cursor->checkpoint->values(cursor->entry());
+                for (size_t i = 0; i < sums.size(); ++i) {
+                    sums[i] += source[i];
+                }
+            }
+
+            CheckpointIndexEntry entry{};
+            entry.key_hash = hash;
+            entry.key_offset = key_offset;
+            entry.key_length = static_cast<uint32_t>(key.size());
+            entry.num_actions = num_actions;
+            entry.value_offset = value_offset;
+            index.append(&entry, sizeof(entry));
+            keys.append(key.data(), key.size());
+            values.append(sums.data(), sums.size() * sizeof(double));
+            key_offset += key.size();
+            value_offset += sums.size();
+        });
+        index.flush();
+        keys.flush();
+        values.flush();
+        table[1].crc = index.crc();
+        table[2].crc = keys.crc();
+        table[3].crc = values.crc();
+
+        header.header_crc = crc32(&header, sizeof(header));
+        header.header_crc = crc32(table, sizeof(table), header.header_crc);
+        pwrite_all(fd, &header, sizeof(header), 0, tmp_filename);
+        pwrite_all(fd, table, sizeof(table), sizeof(header), tmp_filename);
+        // Fichier complet jusqu'à la fin de VALUES, même vide
+        if (::ftruncate(fd, static_cast<off_t>(offset)) != 0 || ::fsync(fd) != 0) {
+            throw write_error(tmp_filename);
+        }
+    } catch (...) {
+        ::close(fd);
+        ::unlink(tmp_filename.c_str());
+        throw;
+    }
+    ::close(fd);
+    if (std::rename(tmp_filename.c_str(), output.c_str()) != 0) {
+        ::unlink(tmp_filename.c_str());
+        throw std::runtime_error("Impossible de renommer le checkpoint vers " + output);
+    }
+    return summary;
+}
+
+} // namespace poker
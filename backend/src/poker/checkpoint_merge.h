@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace poker {
+
+// Fusion des checkpoints de résolutions indépendantes d'un même arbre
+// (MCCFR lancé avec des graines différentes sur plusieurs machines, sans
+// communication pendant la résolution). Regrets et sommes des stratégies
+// sont additionnés infoset par infoset: chaque exécution y contribue en
+// proportion de ses itérations, comme si tous les échantillons venaient
+// d'une seule résolution de sum(itérations) itérations. Un infoset absent
+// d'une exécution (jamais échantillonné) n'y contribue pas.
+//
+// Les index triés des entrées sont parcourus ensemble (fusion k-aire) et la
+// sortie, un checkpoint brut (checkpoint.h) repris par load_checkpoint, est
+// écrite au fil de l'eau: la mémoire ne dépend pas du nombre d'infosets,
+// les entrées brutes étant mappées (un checkpoint compact est en revanche
+// décodé en mémoire). L'état propre au solveur (générateur aléatoire) de
+// chaque exécution n'est pas repris.
+//
+// Seuls les checkpoints de ChanceSamplingCFR (MCCFR sans pondération des
+// regrets) s'additionnent ainsi: le discounting de VanillaCFR pondère chaque
+// itération selon son numéro, CFR+ tronque les regrets à zéro, et
+// l'itération de la sortie (somme des entrées) décalerait leur calendrier.
+struct CheckpointMergeSummary {
+    uint64_t iterations = 0;   // Somme des itérations des entrées
+    uint64_t infosets = 0;     // Infosets distincts
+};
+
+// Lève std::runtime_error si une entrée est illisible, ne vient pas de
+// ChanceSamplingCFR, si les entrées viennent de configurations différentes,
+// ou si un infoset n'a pas le même nombre d'actions partout
+CheckpointMergeSummary merge_checkpoint_files(const std::vector<std::string>& inputs, const std::string& output);
+
+} // namespace poker
@@ -0,0 +1,136 @@
+#include "compression.h"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace poker {
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t MAX_OFFSET = 65535;
+constexpr int HASH_BITS = 16;
+
+inline uint32_t read32(const char* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t hash_sequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Longueurs >= 15 : le quartet vaut 15 et le reste suit en octets de 255
+void put_length(std::string& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(static_cast<char>(255));
+        length -= 255;
+    }
+    out.push_back(static_cast<char>(length));
+}
+
+void emit_sequence(std::string& out, const char* literals, size_t literal_length,
+                   size_t offset, size_t match_length) {
+    size_t match_code = match_length ? match_length - MIN_MATCH : 0;
+    uint8_t token = static_cast<uint8_t>((literal_length < 15 ? literal_length : 15) << 4 |
+                                         (match_code < 15 ? match_code : 15));
+    out.push_back(static_cast<char>(token));
+    if (literal_length >= 15) put_length(out, literal_length - 15);
+    out.append(literals, literal_length);
+
+    if (match_length == 0) return; // Dernière séquence: littéraux seuls
+
+    out.push_back(static_cast<char>(offset & 0xFF));
+    out.push_back(static_cast<char>(offset >> 8));
+    if (match_code >= 15) put_length(out, match_code - 15);
+}
+
+size_t read_length(const uint8_t*& src, const uint8_t* end) {
+    size_t length = 0;
+    uint8_t byte;
+    do {
+        if (src >= end) throw std::runtime_error("Bloc compressé tronqué");
+        byte = *src++;
+        length += byte;
+    } while (byte == 255);
+    return length;
+}
+
+} // namespace
+
+std::string compress_block(const char* data, size_t size) {
+    std::string out;
+    out.reserve(size / 2 + 16);
+
+    std::vector<size_t> table(size_t(1) << HASH_BITS, SIZE_MAX);
+    size_t anchor = 0;
+    size_t i = 0;
+
+    while (i + MIN_MATCH <= size) {
+        uint32_t sequence = read32(data + i);
+        uint32_t h = hash_sequence(sequence);
+        size_t candidate = table[h];
+        table[h] = i;
+
+        if (candidate != SIZE_MAX && i - candidate <= MAX_OFFSET && read32(data + candidate) == sequence) {
+            size_t length = MIN_MATCH;
+            while (i + length < size && data[candidate + length] == data[i + length]) {
+                ++length;
+            }
+            emit_sequence(out, data + anchor, i - anchor, i - candidate, length);
+            i += length;
+            anchor = i;
+        } else {
+            // Accélération sur les données incompressibles
+            i += 1 + ((i - anchor) >> 6);
+        }
+    }
+
+    emit_sequence(out, data + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+void decompress_block(const char* src_data, size_t src_size, char* dst, size_t raw_size) {
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(src_data);
+    const uint8_t* end = src + src_size;
+    size_t out = 0;
+
+    while (src < end) {
+        uint8_t token = *src++;
+
+        size_t literal_length = token >> 4;
+        if (literal_length == 15) literal_length += read_length(src, end);
+        if (literal_length > static_cast<size_t>(end - src) || literal_length > raw_size - out) {
+            throw std::runtime_error("Bloc compressé corrompu (littéraux)");
+        }
+        std::memcpy(dst + out, src, literal_length);
+        src += literal_length;
+        out += literal_length;
+
+        if (src == end) break; // Dernière séquence
+
+        if (end - src < 2) throw std::runtime_error("Bloc compressé tronqué");
+        size_t offset = src[0] | (static_cast<size_t>(src[1]) << 8);
+        src += 2;
+        size_t match_length = (token & 0x0F);
+        if (match_length == 15) match_length += read_length(src, end);
+        match_length += MIN_MATCH;
+
+        if (offset == 0 || offset > out || match_length > raw_size - out) {
+            throw std::runtime_error("Bloc compressé corrompu (correspondance)");
+        }
+        // Copie octet par octet: la source peut chevaucher la destination
+        for (size_t k = 0; k < match_length; ++k) {
+            dst[out + k] = dst[out - offset + k];
+        }
+        out += match_length;
+    }
+
+    if (out != raw_size) {
+        throw std::runtime_error("Bloc compressé corrompu (taille décodée)");
+    }
+}
+
+} // namespace poker
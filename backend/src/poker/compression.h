@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace poker {
+
+// Compresseur LZ77 rapide sans dépendance externe (format de bloc inspiré de LZ4:
+// séquences <littéraux, offset 16 bits, longueur de correspondance>).
+// Conçu pour les sections de checkpoint, très redondantes une fois codées en delta.
+std::string compress_block(const char* data, size_t size);
+
+// Décompresse exactement raw_size octets dans dst.
+// Lève std::runtime_error si le bloc est corrompu ou ne correspond pas à raw_size.
+void decompress_block(const char* src, size_t src_size, char* dst, size_t raw_size);
+
+} // namespace poker
@@ -0,0 +1,33 @@
+#include "concurrent_node_index.h"
+
+namespace poker {
+
+ConcurrentNodeIndex::ConcurrentNodeIndex(size_t expected_nodes) {
+    size_t buckets = 1024;
+    while (buckets < 2 * expected_nodes) {
+        buckets *= 2;
+    }
+    buckets_.reset(new std::atomic<Entry*>[buckets]);
+    for (size_t i = 0; i < buckets; ++i) {
+        buckets_[i].store(nullptr, std::memory_order_relaxed);
+    }
+    mask_ = buckets - 1;
+}
+
+GameNode* ConcurrentNodeIndex::find(uint64_t hash, const std::string& key) const {
+    for (const Entry* entry = buckets_[hash & mask_].load(std::memory_order_acquire); entry; entry = entry->next) {
+        if (entry->hash == hash && *entry->key == key) {
+            return entry->node;
+        }
+    }
+    return nullptr;
+}
+
+void ConcurrentNodeIndex::insert(uint64_t hash, const std::string* key, GameNode* node) {
+    std::atomic<Entry*>& bucket = buckets_[hash & mask_];
+    entries_.push_back({hash, key, node, bucket.load(std::memory_order_relaxed)});
+    bucket.store(&entries_.back(), std::memory_order_release);
+    ++size_;
+}
+
+} // namespace poker
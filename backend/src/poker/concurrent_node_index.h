@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+
+namespace poker {
+
+class GameNode;
+
+// Index des nœuds pendant une résolution multithread (CFRSolver::
+// begin_concurrent_traversal): recherches sans verrou, insertions seules.
+// Les insertions sont sérialisées par l'appelant (création des nœuds sous
+// verrou); une entrée est publiée par un stockage release en tête de son
+// seau, après son initialisation complète. Pas de suppression ni de
+// redimensionnement: l'index est reconstruit entre deux itérations quand sa
+// charge devient trop forte (needs_rebuild).
+class ConcurrentNodeIndex {
+public:
+    explicit ConcurrentNodeIndex(size_t expected_nodes);
+
+    ConcurrentNodeIndex(const ConcurrentNodeIndex&) = delete;
+    ConcurrentNodeIndex& operator=(const ConcurrentNodeIndex&) = delete;
+
+    // nullptr si absent; appelable depuis n'importe quel thread
+    GameNode* find(uint64_t hash, const std::string& key) const;
+
+    // key doit rester valide aussi longtemps que l'index (clé de node_map_)
+    void insert(uint64_t hash, const std::string* key, GameNode* node);
+
+    size_t size() const { return size_; }
+    bool needs_rebuild() const { return size_ > 2 * (mask_ + 1); }
+
+private:
+    struct Entry {
+        uint64_t hash;
+        const std::string* key;
+        GameNode* node;
+        Entry* next;
+    };
+
+    std::unique_ptr<std::atomic<Entry*>[]> buckets_;
+    uint64_t mask_;
+    std::deque<Entry> entries_;  // Adresses stables
+    size_t size_ = 0;
+};
+
+} // namespace poker
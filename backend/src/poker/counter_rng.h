@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace poker {
+
+// Générateur à compteur Philox4x32-10 (Salmon et al., « Parallel random
+// numbers: as easy as 1, 2, 3 », SC 2011): chaque bloc de quatre tirages est
+// une fonction pure de la clé (graine) et du compteur (itération, flux,
+// numéro de bloc). Les tirages d'une itération ne dépendent donc ni de
+// l'ordre des itérations ni du thread qui l'exécute, et la reprise d'un
+// checkpoint ne demande que la graine. Aucun état à partager: un générateur
+// se construit sur la pile pour chaque itération.
+class CounterRng {
+public:
+    using result_type = uint32_t;
+
+    CounterRng(uint64_t seed, uint64_t iteration, uint32_t stream = 0)
+        : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+          counter_{0, static_cast<uint32_t>(iteration), static_cast<uint32_t>(iteration >> 32), stream},
+          index_(4) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    result_type operator()() {
+        if (index_ == 4) {
+            refill();
+        }
+        return block_[index_++];
+    }
+
+    // Entier uniforme dans [0, n), n > 0 (multiplication de Lemire, sans biais)
+    uint32_t below(uint32_t n) {
+        uint64_t product = static_cast<uint64_t>((*this)()) * n;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < n) {
+            uint32_t threshold = static_cast<uint32_t>(-n) % n;
+            while (low < threshold) {
+                product = static_cast<uint64_t>((*this)()) * n;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    // Réel uniforme dans [0, 1), 53 bits
+    double uniform() {
+        uint64_t bits = (static_cast<uint64_t>((*this)()) << 32) | (*this)();
+        return static_cast<double>(bits >> 11) * 0x1.0p-53;
+    }
+
+    // Indice tiré proportionnellement aux poids (positifs ou nuls);
+    // uniforme si leur somme est nulle
+    size_t sample(const std::vector<double>& weights) {
+        double total = 0.0;
+        for (double weight : weights) {
+            total += weight;
+        }
+        if (!(total > 0.0)) {
+            return below(static_cast<uint32_t>(weights.size()));
+        }
+        double target = uniform() * total;
+        size_t last = 0;
+        for (size_t i = 0; i < weights.size(); ++i) {
+            if (weights[i] > 0.0) {
+                if (target < weights[i]) {
+                    return i;
+                }
+                target -= weights[i];
+                last = i;
+            }
+        }
+        // Arrondi de la soustraction: dernière action de poids non nul
+        return last;
+    }
+
+    // Bloc Philox4x32-10 du compteur sous la clé (vecteurs de référence de
+    // Random123 dans tests/counter_rng_checks.cpp)
+    static void philox4x32_10(const uint32_t counter[4], const uint32_t key[2], uint32_t block[4]) {
+        static constexpr uint32_t MULTIPLIER_0 = 0xD2511F53;
+        static constexpr uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+        static constexpr uint32_t WEYL_0 = 0x9E3779B9;
+        static constexpr uint32_t WEYL_1 = 0xBB67AE85;
+
+        uint32_t x0 = counter[0], x1 = counter[1], x2 = counter[2], x3 = counter[3];
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < 10; ++round) {
+            uint64_t p0 = static_cast<uint64_t>(MULTIPLIER_0) * x0;
+            uint64_t p1 = static_cast<uint64_t>(MULTIPLIER_1) * x2;
+            x0 = static_cast<uint32_t>(p1 >> 32) ^ x1 ^ k0;
+            x1 = static_cast<uint32_t>(p1);
+            x2 = static_cast<uint32_t>(p0 >> 32) ^ x3 ^ k1;
+            x3 = static_cast<uint32_t>(p0);
+            k0 += WEYL_0;
+            k1 += WEYL_1;
+        }
+        block[0] = x0;
+        block[1] = x1;
+        block[2] = x2;
+        block[3] = x3;
+    }
+
+private:
+    uint32_t key_[2];
+    uint32_t counter_[4];
+    uint32_t block_[4];
+    unsigned index_;
+
+    void refill() {
+        philox4x32_10(counter_, key_, block_);
+        ++counter_[0];
+        index_ = 0;
+    }
+};
+
+} // namespace poker
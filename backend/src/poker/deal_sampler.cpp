@@ -0,0 +1,236 @@
+#include "deal_sampler.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <stdexcept>
+
+namespace poker {
+
+namespace {
+
+constexpr int MAX_DEAL_ATTEMPTS = 10000;
+
+uint64_t card_bit(const Card& card) {
+    return uint64_t(1) << card.index();
+}
+
+int rank_value(char c) {
+    static const std::string RANKS = "23456789TJQKA";
+    size_t pos = RANKS.find(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+    return pos == std::string::npos ? -1 : static_cast<int>(pos) + 2;
+}
+
+// Combinaisons d'une notation abrégée (sans '+') de rangs high >= low
+void add_shorthand(HandRange& range, int high, int low, char kind, double weight) {
+    for (int s1 = 0; s1 < 4; ++s1) {
+        for (int s2 = 0; s2 < 4; ++s2) {
+            if (high == low ? s2 <= s1 : (kind == 's' && s1 != s2) || (kind == 'o' && s1 == s2)) {
+                continue;
+            }
+            range.emplace_back(Hand(Card(static_cast<Rank>(high), static_cast<Suit>(s1)),
+                                    Card(static_cast<Rank>(low), static_cast<Suit>(s2))),
+                               weight);
+        }
+    }
+}
+
+void parse_range_item(HandRange& range, const std::string& item) {
+    size_t colon = item.find(':');
+    std::string combo = item.substr(0, colon);
+    double weight = 1.0;
+    if (colon != std::string::npos) {
+        size_t parsed = 0;
+        try {
+            weight = std::stod(item.substr(colon + 1), &parsed);
+        } catch (const std::exception&) {
+            parsed = 0;
+        }
+        if (parsed == 0 || parsed != item.size() - colon - 1 || !std::isfinite(weight) || weight < 0.0) {
+            throw std::invalid_argument("Poids invalide dans la range: " + item);
+        }
+    }
+
+    if (combo.size() == 4 && rank_value(combo[1]) < 0) {
+        std::vector<Card> cards = parse_cards(combo);
+        range.emplace_back(Hand(cards[0], cards[1]), weight);
+        return;
+    }
+
+    bool plus = !combo.empty() && combo.back() == '+';
+    if (plus) {
+        combo.pop_back();
+    }
+    char kind = combo.size() == 3 ? static_cast<char>(std::tolower(static_cast<unsigned char>(combo[2]))) : ' ';
+    int first = combo.size() >= 2 ? rank_value(combo[0]) : -1;
+    int second = combo.size() >= 2 ? rank_value(combo[1]) : -1;
+    if (first < 0 || second < 0 || combo.size() > 3 || (combo.size() == 3 && kind != 's' && kind != 'o') ||
+        (first == second && kind != ' ')) {
+        throw std::invalid_argument("Élément de range invalide: " + item);
+    }
+
+    int high = std::max(first, second);
+    int low = std::min(first, second);
+    if (high == low) {
+        // "99+": paires de 99 à AA
+        for (int pair = low; pair <= (plus ? 14 : low); ++pair) {
+            add_shorthand(range, pair, pair, kind, weight);
+        }
+    } else {
+        // "ATs+": kicker de T jusqu'au rang sous l'as
+        for (int kicker = low; kicker <= (plus ? high - 1 : low); ++kicker) {
+            add_shorthand(range, high, kicker, kind, weight);
+        }
+    }
+}
+
+} // namespace
+
+HandRange parse_hand_range(const std::string& text) {
+    HandRange range;
+    size_t pos = 0;
+    while (pos <= text.size()) {
+        size_t end = text.find(',', pos);
+        if (end == std::string::npos) end = text.size();
+        std::string item = text.substr(pos, end - pos);
+        item.erase(0, item.find_first_not_of(" \t"));
+        item.erase(item.find_last_not_of(" \t") + 1);
+        if (!item.empty()) {
+            parse_range_item(range, item);
+        }
+        pos = end + 1;
+    }
+    return range;
+}
+
+DealSampler::DealSampler(const Board& board, int num_players, size_t board_size)
+    : board_(board), board_mask_(0), board_size_(std::max(board_size, board.size())),
+      ranges_(static_cast<size_t>(std::max(num_players, 0))) {
+    for (const Card& card : board_) {
+        board_mask_ |= card_bit(card);
+    }
+    for (const Card& card : all_cards()) {
+        if (!(board_mask_ & card_bit(card))) {
+            live_cards_.push_back(card);
+        }
+    }
+    if (2 * ranges_.size() + board_size_ - board_.size() > live_cards_.size()) {
+        throw std::invalid_argument("Paquet insuffisant pour " + std::to_string(num_players) + " joueurs");
+    }
+}
+
+void DealSampler::set_range(int player, const HandRange& range) {
+    if (player < 0 || static_cast<size_t>(player) >= ranges_.size()) {
+        throw std::invalid_argument("Joueur sans place à la table: " + std::to_string(player));
+    }
+    AliasTable table;
+    std::vector<double> weights;
+    for (const auto& [hand, weight] : range) {
+        uint64_t mask = card_bit(hand.first) | card_bit(hand.second);
+        if (weight > 0.0 && !(mask & board_mask_) && hand.first.index() != hand.second.index()) {
+            table.hands.push_back(hand);
+            table.masks.push_back(mask);
+            weights.push_back(weight);
+        }
+    }
+    if (range.empty()) {
+        ranges_[player] = AliasTable();
+        return;
+    }
+    if (weights.empty()) {
+        throw std::invalid_argument("Range du joueur " + std::to_string(player) +
+                                    " vide une fois retirées les cartes du tableau");
+    }
+
+    // Méthode de Vose: chaque case garde sa part et renvoie le reste à un alias
+    size_t n = weights.size();
+    double total = 0.0;
+    for (double weight : weights) {
+        total += weight;
+    }
+    table.probability.resize(n);
+    table.alias.resize(n);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (size_t i = 0; i < n; ++i) {
+        weights[i] *= n / total;
+        (weights[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+    while (!small.empty() && !large.empty()) {
+        uint32_t less = small.back();
+        small.pop_back();
+        uint32_t more = large.back();
+        table.probability[less] = weights[less];
+        table.alias[less] = more;
+        weights[more] -= 1.0 - weights[less];
+        if (weights[more] < 1.0) {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+    // Restes d'arrondi: cases pleines
+    for (uint32_t i : small) {
+        table.probability[i] = 1.0;
+        table.alias[i] = i;
+    }
+    for (uint32_t i : large) {
+        table.probability[i] = 1.0;
+        table.alias[i] = i;
+    }
+    ranges_[player] = std::move(table);
+}
+
+Card DealSampler::draw_card(CounterRng& rng, uint64_t& used) const {
+    uint32_t n = static_cast<uint32_t>(live_cards_.size());
+    for (;;) {
+        const Card& card = live_cards_[rng.below(n)];
+        if (!(used & card_bit(card))) {
+            used |= card_bit(card);
+            return card;
+        }
+    }
+}
+
+void DealSampler::deal(CounterRng& rng, Deal& deal) const {
+    deal.hands.resize(ranges_.size());
+    uint64_t used = board_mask_;
+
+    // Ranges d'abord: un conflit rejette toute leur donne. Les mains
+    // uniformes et le tableau se tirent ensuite parmi les cartes restantes
+    // sans biais.
+    int attempts = 0;
+    bool conflict;
+    do {
+        if (++attempts > MAX_DEAL_ATTEMPTS) {
+            throw std::runtime_error("Ranges incompatibles: aucune donne sans conflit en " +
+                                     std::to_string(MAX_DEAL_ATTEMPTS) + " tentatives");
+        }
+        conflict = false;
+        used = board_mask_;
+        for (size_t player = 0; player < ranges_.size() && !conflict; ++player) {
+            const AliasTable& table = ranges_[player];
+            if (table.hands.empty()) {
+                continue;
+            }
+            uint32_t i = rng.below(static_cast<uint32_t>(table.hands.size()));
+            if (rng.uniform() >= table.probability[i]) {
+                i = table.alias[i];
+            }
+            conflict = (used & table.masks[i]) != 0;
+            used |= table.masks[i];
+            deal.hands[player] = table.hands[i];
+        }
+    } while (conflict);
+
+    for (size_t player = 0; player < ranges_.size(); ++player) {
+        if (ranges_[player].hands.empty()) {
+            Card first = draw_card(rng, used);
+            deal.hands[player] = Hand(first, draw_card(rng, used));
+        }
+    }
+    deal.board.assign(board_.begin(), board_.end());
+    while (deal.board.size() < board_size_) {
+        deal.board.push_back(draw_card(rng, used));
+    }
+}
+
+} // namespace poker
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "card.h"
+#include "counter_rng.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace poker {
+
+// Combinaisons d'un joueur et leurs poids relatifs
+using HandRange = std::vector<std::pair<Hand, double>>;
+
+// Range en texte: éléments séparés par des virgules, poids optionnel après
+// ':' (1 par défaut). Combinaisons explicites ("AhKh"), paires ("QQ",
+// "99+"), mains assorties ou dépareillées ("AKs", "ATo+") ou les deux
+// ("KQ"). Une combinaison répétée cumule ses poids. Lève
+// std::invalid_argument pour un élément invalide.
+HandRange parse_hand_range(const std::string& text);
+
+struct Deal {
+    std::vector<Hand> hands;  // Une main par joueur
+    Board board;              // Tableau complété
+};
+
+// Donne d'une itération échantillonnée: une main sans conflit pour chaque
+// joueur et les cartes restantes du tableau, depuis un paquet en masque de
+// bits (bit Card::index() des cartes sorties). Mains uniformes tirées carte
+// par carte avec rejet des cartes déjà sorties. Ranges pondérées tirées par
+// table d'alias; en cas de conflit, toute la donne des ranges est rejetée,
+// ce qui garde la distribution jointe exacte. Quelques dizaines de
+// nanosecondes par donne, sans état modifié: un échantillonneur sert à tous
+// les threads.
+class DealSampler {
+public:
+    // board_size: taille du tableau complété (5: jusqu'à la river). Lève
+    // std::invalid_argument si le paquet ne suffit pas.
+    DealSampler(const Board& board, int num_players, size_t board_size = 5);
+
+    // Range de player (vide: toutes les mains). Les combinaisons en conflit
+    // avec le tableau sont retirées; lève std::invalid_argument s'il n'en
+    // reste aucune.
+    void set_range(int player, const HandRange& range);
+
+    // Réutilise les vecteurs de deal. Lève std::runtime_error si les ranges
+    // ne permettent (presque) aucune donne sans conflit.
+    void deal(CounterRng& rng, Deal& deal) const;
+
+private:
+    struct AliasTable {
+        std::vector<Hand> hands;
+        std::vector<uint64_t> masks;
+        std::vector<double> probability;
+        std::vector<uint32_t> alias;
+    };
+
+    Board board_;
+    uint64_t board_mask_;
+    size_t board_size_;
+    std::vector<Card> live_cards_;     // Cartes hors du tableau initial
+    std::vector<AliasTable> ranges_;   // Par joueur; vide: mains uniformes
+
+    Card draw_card(CounterRng& rng, uint64_t& used) const;
+};
+
+} // namespace poker
@@ -0,0 +1,534 @@
+#include "distributed_cfr.h"
+#include "metrics.h"
+#include "socket_io.h"
+#include "solve_job.h"
+#include "trace.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+
+namespace poker {
+
+namespace {
+
+// Borne la mémoire allouée pour une trame reçue
+constexpr uint32_t MAX_FRAME_BYTES = 64u << 20;
+// Taille visée des trames d'infosets en fin de résolution
+constexpr size_t INFOSET_FRAME_BYTES = 4u << 20;
+// Attente d'un coordinateur qui n'écoute pas encore
+constexpr int CONNECT_ATTEMPTS = 100;
+constexpr auto CONNECT_RETRY_DELAY = std::chrono::milliseconds(100);
+
+enum FrameKind : char {
+    CONTROL = 'J',
+    ITERATE = 'I',
+    VALUES = 'V',
+    INFOSETS = 'S',
+    END = 'E'
+};
+
+void put_u32(std::string& out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<char>(value >> shift));
+    }
+}
+
+void put_f64(std::string& out, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<char>(bits >> shift));
+    }
+}
+
+// Lecture du contenu d'une trame; lève std::runtime_error s'il est tronqué
+class FrameReader {
+public:
+    explicit FrameReader(const std::string& body) : ptr_(body.data()), end_(body.data() + body.size()) {}
+
+    uint32_t u32() {
+        return static_cast<uint32_t>(big_endian(4));
+    }
+
+    double f64() {
+        uint64_t bits = big_endian(8);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::string bytes(size_t size) {
+        return std::string(take(size), size);
+    }
+
+    bool done() const { return ptr_ == end_; }
+
+private:
+    const char* ptr_;
+    const char* end_;
+
+    const char* take(size_t size) {
+        if (static_cast<size_t>(end_ - ptr_) < size) {
+            throw std::runtime_error("Trame distribuée tronquée");
+        }
+        const char* data = ptr_;
+        ptr_ += size;
+        return data;
+    }
+
+    uint64_t big_endian(size_t size) {
+        const char* data = take(size);
+        uint64_t value = 0;
+        for (size_t i = 0; i < size; ++i) {
+            value = (value << 8) | static_cast<unsigned char>(data[i]);
+        }
+        return value;
+    }
+};
+
+void send_frame(int fd, FrameKind kind, const std::string& body) {
+    std::string frame;
+    frame.reserve(5 + body.size());
+    put_u32(frame, static_cast<uint32_t>(body.size() + 1));
+    frame.push_back(kind);
+    frame += body;
+    if (!write_fully(fd, frame.data(), frame.size())) {
+        throw std::runtime_error("Connexion distribuée interrompue à l'écriture");
+    }
+}
+
+void send_control(int fd, const Json::Value& message) {
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    builder["precision"] = 17;
+    send_frame(fd, CONTROL, Json::writeString(builder, message));
+}
+
+FrameKind receive_frame(int fd, std::string& body) {
+    unsigned char header[4];
+    if (!read_fully(fd, reinterpret_cast<char*>(header), sizeof(header))) {
+        throw std::runtime_error("Connexion distribuée fermée");
+    }
+    uint32_t size = (uint32_t(header[0]) << 24) | (uint32_t(header[1]) << 16) |
+                    (uint32_t(header[2]) << 8) | uint32_t(header[3]);
+    if (size == 0 || size > MAX_FRAME_BYTES) {
+        throw std::runtime_error("Trame distribuée invalide: " + std::to_string(size) + " octets");
+    }
+    char kind;
+    body.resize(size - 1);
+    if (!read_fully(fd, &kind, 1) || !read_fully(fd, body.data(), body.size())) {
+        throw std::runtime_error("Connexion distribuée fermée");
+    }
+    return static_cast<FrameKind>(kind);
+}
+
+Json::Value parse_control(const std::string& body) {
+    Json::CharReaderBuilder builder;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    Json::Value message;
+    std::string errors;
+    if (!reader->parse(body.data(), body.data() + body.size(), &message, &errors) || !message.isObject()) {
+        throw std::runtime_error("Message de contrôle invalide: " + errors);
+    }
+    return message;
+}
+
+// Trame de contrôle attendue; un message d'erreur du pair devient une exception
+Json::Value receive_control(int fd, const char* expected_type) {
+    std::string body;
+    FrameKind kind = receive_frame(fd, body);
+    if (kind != CONTROL) {
+        throw std::runtime_error(std::string("Trame inattendue, message ") + expected_type + " attendu");
+    }
+    Json::Value message = parse_control(body);
+    std::string type = message.get("type", "").asString();
+    if (type == "error") {
+        throw std::runtime_error(message.get("error", "").asString());
+    }
+    if (type != expected_type) {
+        throw std::runtime_error("Message " + type + " inattendu, " + expected_type + " attendu");
+    }
+    return message;
+}
+
+// Infosets du worker en trames 'S' bornées, puis 'E'
+void send_infosets(int fd, const CFRSolver& solver) {
+    std::string body;
+    solver.for_each_infoset([&](const std::string& key, const GameNode& node) {
+        put_u32(body, static_cast<uint32_t>(key.size()));
+        body += key;
+        put_u32(body, static_cast<uint32_t>(node.regret_sum.size()));
+        for (double value : node.regret_sum) {
+            put_f64(body, value);
+        }
+        for (double value : node.strategy_sum) {
+            put_f64(body, value);
+        }
+        if (body.size() >= INFOSET_FRAME_BYTES) {
+            send_frame(fd, INFOSETS, body);
+            body.clear();
+        }
+    });
+    if (!body.empty()) {
+        send_frame(fd, INFOSETS, body);
+    }
+    send_frame(fd, END, {});
+}
+
+int connect_with_retry(const std::string& address) {
+    for (int attempt = 1;; ++attempt) {
+        try {
+            return connect_socket(address);
+        } catch (const std::runtime_error&) {
+            if (attempt == CONNECT_ATTEMPTS) {
+                throw;
+            }
+            std::this_thread::sleep_for(CONNECT_RETRY_DELAY);
+        }
+    }
+}
+
+} // namespace
+
+DistributedCFR::DistributedCFR(std::shared_ptr<GameAbstraction> abstraction, const CFRConfig& config,
+                               const DistributedOptions& options, const std::string& task_type,
+                               const Json::Value& params)
+    : VanillaCFR(std::move(abstraction), config), options_(options), task_type_(task_type), params_(params) {}
+
+DistributedCFR::~DistributedCFR() {
+    close_workers();
+}
+
+void DistributedCFR::close_workers() {
+    for (const Worker& worker : workers_) {
+        ::close(worker.fd);
+    }
+    workers_.clear();
+}
+
+void DistributedCFR::connect_workers(const std::vector<size_t>& remote_children) {
+    // Un worker qui disparaît est signalé par une erreur d'écriture, pas par SIGPIPE
+    std::signal(SIGPIPE, SIG_IGN);
+    int listen_fd = listen_socket(options_.address, options_.workers);
+    std::cout << "En attente de " << options_.workers << " workers sur " << options_.address << "..." << std::endl;
+    try {
+        while (static_cast<int>(workers_.size()) < options_.workers) {
+            int fd = accept_socket(listen_fd);
+            if (fd < 0) {
+                throw std::runtime_error(std::string("Connexion d'un worker impossible (") + std::strerror(errno) + ")");
+            }
+            workers_.push_back({fd, {}});
+        }
+    } catch (...) {
+        ::close(listen_fd);
+        throw;
+    }
+    ::close(listen_fd);
+    if (is_unix_socket_address(options_.address)) {
+        ::unlink(options_.address.c_str());
+    }
+
+    // Sous-arbres distribués à tour de rôle
+    for (size_t i = 0; i < remote_children.size(); ++i) {
+        workers_[i % workers_.size()].children.push_back(remote_children[i]);
+    }
+    if (remote_children.size() < workers_.size()) {
+        std::cerr << "Avertissement: " << workers_.size() << " workers pour " << remote_children.size()
+                  << " sous-arbres, " << workers_.size() - remote_children.size() << " sans partition" << std::endl;
+    }
+    for (const Worker& worker : workers_) {
+        Json::Value assign;
+        assign["type"] = "assign";
+        assign["task_type"] = task_type_;
+        assign["params"] = params_;
+        assign["children"] = Json::Value(Json::arrayValue);
+        for (size_t child : worker.children) {
+            assign["children"].append(static_cast<Json::UInt64>(child));
+        }
+        send_control(worker.fd, assign);
+    }
+    for (size_t w = 0; w < workers_.size(); ++w) {
+        try {
+            receive_control(workers_[w].fd, "ready");
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Worker " + std::to_string(w) + ": " + e.what());
+        }
+    }
+}
+
+CFRResult DistributedCFR::solve(const GameState& initial_state) {
+    metrics::ScopedTimer solve_timer(metrics::Timer::SOLVE);
+    trace::Span solve_span("solve", "cfr");
+    start_profiling();
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    CFRResult result;
+    result.converged = false;
+
+    if (options_.workers < 1) {
+        throw std::runtime_error("Au moins un worker est nécessaire en mode distribué");
+    }
+    if (current_iteration_ > 0) {
+        throw std::runtime_error("Reprise d'un checkpoint non supportée en mode distribué");
+    }
+    if (initial_state.is_terminal()) {
+        throw std::runtime_error("État initial terminal: rien à répartir");
+    }
+
+    std::vector<Action> actions = abstraction_->get_abstracted_actions(initial_state);
+    std::vector<GameState> children;
+    std::vector<size_t> remote_children;
+    for (size_t i = 0; i < actions.size(); ++i) {
+        children.push_back(initial_state.apply_action(actions[i]));
+        if (!children.back().is_terminal()) {
+            remote_children.push_back(i);
+        }
+    }
+    {
+        trace::Span connect_span("connect_workers", "distributed");
+        connect_workers(remote_children);
+    }
+
+    const int num_players = initial_state.num_players;
+    const std::vector<double> root_reach(num_players, 1.0);
+    std::vector<bool> is_remote(actions.size(), false);
+    for (size_t child : remote_children) {
+        is_remote[child] = true;
+    }
+
+    std::string body;
+    for (int iteration = current_iteration_ + 1; iteration <= config_.max_iterations; ++iteration) {
+        if (stop_requested()) {
+            break;
+        }
+        trace::Span iteration_span("iteration", "cfr");
+        iteration_span.arg("iteration", iteration);
+
+        std::vector<double> strategy = current_strategy(initial_state);
+        auto child_reach = [&](size_t i) {
+            std::vector<double> reach = root_reach;
+            reach[initial_state.current_player] *= strategy[i];
+            return reach;
+        };
+
+        // Les workers calculent pendant que le coordinateur évalue ses enfants terminaux
+        for (const Worker& worker : workers_) {
+            if (worker.children.empty()) {
+                continue;
+            }
+            body.clear();
+            put_u32(body, static_cast<uint32_t>(iteration));
+            for (size_t child : worker.children) {
+                for (double reach : child_reach(child)) {
+                    put_f64(body, reach);
+                }
+            }
+            send_frame(worker.fd, ITERATE, body);
+        }
+        std::vector<std::vector<double>> child_values(actions.size());
+        for (size_t i = 0; i < actions.size(); ++i) {
+            if (!is_remote[i]) {
+                child_values[i] = traverse_subtree(children[i], child_reach(i), iteration);
+            }
+        }
+        for (size_t w = 0; w < workers_.size(); ++w) {
+            const Worker& worker = workers_[w];
+            if (worker.children.empty()) {
+                continue;
+            }
+            try {
+                if (receive_frame(worker.fd, body) != VALUES) {
+                    throw std::runtime_error(parse_control(body).get("error", "trame inattendue").asString());
+                }
+                FrameReader reader(body);
+                for (size_t child : worker.children) {
+                    child_values[child].resize(num_players);
+                    for (double& value : child_values[child]) {
+                        value = reader.f64();
+                    }
+                }
+            } catch (const std::runtime_error& e) {
+                throw std::runtime_error("Worker " + std::to_string(w) + ": " + e.what());
+            }
+        }
+
+        update_from_children(initial_state, root_reach, strategy, child_values, iteration);
+        iteration_span.end();
+        complete_iteration(iteration);
+
+        if (enforce_memory_limit(iteration)) {
+            break;
+        }
+    }
+
+    {
+        trace::Span collect_span("collect_infosets", "distributed");
+        std::unordered_map<std::string, std::vector<double>> values = collect_infosets();
+        for (size_t child : remote_children) {
+            import_subtree(children[child], values);
+        }
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    result.iterations_completed = current_iteration_;
+    result.final_exploitability = final_exploitability(initial_state);
+    result.converged = result.final_exploitability <= config_.target_exploitability;
+    result.convergence_time_seconds = duration.count() / 1000.0;
+    result.status_message = status_message(result.converged);
+    fill_memory_stats(result);
+    finish_profiling(result);
+
+    return result;
+}
+
+std::unordered_map<std::string, std::vector<double>> DistributedCFR::collect_infosets() {
+    Json::Value finish;
+    finish["type"] = "finish";
+    for (const Worker& worker : workers_) {
+        send_control(worker.fd, finish);
+    }
+
+    std::unordered_map<std::string, std::vector<double>> values;
+    std::string body;
+    for (size_t w = 0; w < workers_.size(); ++w) {
+        try {
+            FrameKind kind;
+            while ((kind = receive_frame(workers_[w].fd, body)) == INFOSETS) {
+                FrameReader reader(body);
+                while (!reader.done()) {
+                    std::string key = reader.bytes(reader.u32());
+                    size_t count = 2 * static_cast<size_t>(reader.u32());
+                    std::vector<double>& infoset = values[key];
+                    if (!infoset.empty() && infoset.size() != count) {
+                        throw std::runtime_error("Infoset de tailles différentes selon les partitions: " + key);
+                    }
+                    infoset.resize(count, 0.0);
+                    for (double& value : infoset) {
+                        value += reader.f64();
+                    }
+                }
+            }
+            if (kind != END) {
+                throw std::runtime_error(parse_control(body).get("error", "trame inattendue").asString());
+            }
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Worker " + std::to_string(w) + ": " + e.what());
+        }
+    }
+    close_workers();
+    return values;
+}
+
+void DistributedCFR::import_subtree(const GameState& state,
+                                    const std::unordered_map<std::string, std::vector<double>>& values) {
+    if (state.is_terminal()) {
+        return;
+    }
+    int player = state.current_player;
+    auto it = values.find(state_to_key(state, player));
+    if (it == values.end()) {
+        return; // Jamais visité par le worker
+    }
+    GameNode* node = get_or_create_node(state, player);
+    if (!node) {
+        throw MemoryLimitExceeded("Limite mémoire atteinte en réunissant les infosets des workers");
+    }
+    size_t num_actions = node->regret_sum.size();
+    if (it->second.size() != 2 * num_actions) {
+        throw std::runtime_error("Infoset incohérent reçu d'un worker: " + it->first);
+    }
+    std::copy_n(it->second.begin(), num_actions, node->regret_sum.begin());
+    std::copy_n(it->second.begin() + num_actions, num_actions, node->strategy_sum.begin());
+
+    for (const Action& action : abstraction_->get_abstracted_actions(state)) {
+        import_subtree(state.apply_action(action), values);
+    }
+}
+
+int run_distributed_worker(const std::string& address) {
+    std::signal(SIGPIPE, SIG_IGN);
+    int fd = -1;
+    try {
+        fd = connect_with_retry(address);
+        Json::Value assign = receive_control(fd, "assign");
+        const Json::Value& params = assign["params"];
+        CFRConfig config = parse_solver_config(params["solver_config"]);
+        GameState root = parse_game_config(params["game_config"]);
+        auto abstraction = std::make_shared<BasicAbstraction>();
+        std::unique_ptr<VanillaCFR> vanilla = create_exhaustive_solver(assign["task_type"].asString(),
+                                                                       abstraction, config,
+                                                                       params["game_config"]);
+        std::vector<Action> actions = abstraction->get_abstracted_actions(root);
+        std::vector<GameState> children;
+        for (const Json::Value& child : assign["children"]) {
+            if (!child.isUInt() || child.asUInt() >= actions.size()) {
+                throw std::runtime_error("Sous-arbre assigné invalide: " + child.toStyledString());
+            }
+            children.push_back(root.apply_action(actions[child.asUInt()]));
+        }
+        Json::Value ready;
+        ready["type"] = "ready";
+        send_control(fd, ready);
+        std::cout << "Worker connecté à " << address << ": " << children.size() << " sous-arbres" << std::endl;
+
+        std::string body;
+        std::string values;
+        for (;;) {
+            FrameKind kind = receive_frame(fd, body);
+            if (kind == CONTROL) {
+                std::string type = parse_control(body).get("type", "").asString();
+                if (type != "finish") {
+                    throw std::runtime_error("Message " + type + " inattendu");
+                }
+                send_infosets(fd, *vanilla);
+                break;
+            }
+            if (kind != ITERATE) {
+                throw std::runtime_error("Trame inattendue du coordinateur");
+            }
+            FrameReader reader(body);
+            int iteration = static_cast<int>(reader.u32());
+            values.clear();
+            for (const GameState& child : children) {
+                std::vector<double> reach(child.num_players);
+                for (double& probability : reach) {
+                    probability = reader.f64();
+                }
+                for (double value : vanilla->traverse_subtree(child, reach, iteration)) {
+                    put_f64(values, value);
+                }
+            }
+            vanilla->complete_iteration(iteration);
+            send_frame(fd, VALUES, values);
+        }
+        std::cout << "Worker terminé après " << vanilla->current_iteration() << " itérations, "
+                  << vanilla->num_infosets() << " infosets" << std::endl;
+        ::close(fd);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur: " << e.what() << std::endl;
+        if (fd >= 0) {
+            // Signalée au coordinateur, si la connexion tient encore
+            try {
+                Json::Value error;
+                error["type"] = "error";
+                error["error"] = e.what();
+                send_control(fd, error);
+            } catch (const std::runtime_error&) {
+            }
+            ::close(fd);
+        }
+        return 1;
+    }
+}
+
+} // namespace poker
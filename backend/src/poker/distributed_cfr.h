@@ -0,0 +1,81 @@
+#pragma once
+
+#include "cfr_solver.h"
+#include <json/json.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace poker {
+
+// Résolution CFR répartie entre processus. L'arbre est partagé à la racine:
+// le coordinateur tient l'infoset racine, chaque worker les sous-arbres de
+// quelques premières actions (distribuées à tour de rôle; les actions qui
+// mènent à un état terminal restent au coordinateur). Les streets
+// n'avancent pas dans l'arbre (pas de nœud de chance), d'où un partage par
+// première action plutôt que par flop.
+//
+// À chaque itération, seules les probabilités d'atteinte des enfants de la
+// racine partent vers les workers et leurs valeurs reviennent: le
+// coordinateur met à jour les regrets de la racine comme VanillaCFR. En fin
+// de résolution, les workers envoient leurs infosets, réunis dans le solveur
+// du coordinateur: export, cache de solutions et exploitabilité finale
+// portent sur l'arbre complet. L'exploitabilité n'est mesurée qu'à la fin
+// (elle exigerait les sous-arbres à chaque mesure), pas de checkpoint
+// périodique ni de reprise.
+//
+// Protocole (sockets Unix ou TCP, voir socket_io.h): trames de longueur
+// (uint32 big-endian) suivie d'un octet de type et du contenu; entiers et
+// doubles (bits IEEE 754) en big-endian.
+//   'J' JSON de contrôle: {"type": "assign", "task_type", "params",
+//       "children": [indices des actions de la racine]}, {"type": "ready"},
+//       {"type": "finish"}, {"type": "error", "error"}
+//   'I' itération (uint32) puis, par enfant assigné, les probabilités
+//       d'atteinte de chaque joueur
+//   'V' valeurs de chaque joueur par enfant assigné
+//   'S' infosets du worker après "finish": clé (uint32 + octets), nombre
+//       d'actions n (uint32), puis regrets et sommes des stratégies (2n doubles)
+//   'E' fin des trames 'S'
+
+struct DistributedOptions {
+    std::string address;   // Écoute du coordinateur; vide: pas de mode distribué
+    int workers = 1;
+};
+
+class DistributedCFR : public VanillaCFR {
+public:
+    // params: document de la tâche ({"solver_config", "game_config"}), transmis
+    // tel quel aux workers qui reconstruisent la même racine
+    DistributedCFR(std::shared_ptr<GameAbstraction> abstraction, const CFRConfig& config,
+                   const DistributedOptions& options, const std::string& task_type, const Json::Value& params);
+    ~DistributedCFR() override;
+
+    // Attend options.workers connexions, puis résout; lève std::runtime_error
+    // si un worker échoue ou se déconnecte
+    CFRResult solve(const GameState& initial_state) override;
+
+private:
+    struct Worker {
+        int fd;
+        std::vector<size_t> children;
+    };
+
+    DistributedOptions options_;
+    std::string task_type_;
+    Json::Value params_;
+    std::vector<Worker> workers_;
+
+    void connect_workers(const std::vector<size_t>& remote_children);
+    // Infosets de tous les workers, valeurs additionnées si une clé se
+    // retrouve dans plusieurs partitions
+    std::unordered_map<std::string, std::vector<double>> collect_infosets();
+    void import_subtree(const GameState& state, const std::unordered_map<std::string, std::vector<double>>& values);
+    void close_workers();
+};
+
+// Worker: se connecte au coordinateur (nouvelles tentatives pendant
+// quelques secondes s'il n'écoute pas encore) et résout ses sous-arbres
+// jusqu'à la fin. Code de sortie du processus.
+int run_distributed_worker(const std::string& address);
+
+} // namespace poker
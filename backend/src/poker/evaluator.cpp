@@ -1,4 +1,5 @@
 #include "evaluator.h"
+#include "metrics.h"
 #include <algorithm>
 #include <unordered_set>
 #include <random>
@@ -34,6 +35,7 @@ std::string HandStrength::to_string() const {
 }
 
 HandStrength HandEvaluator::evaluate(const std::vector<Card>& cards) {
+    metrics::increment(metrics::Counter::EVALUATOR_CALLS);
     if (cards.size() < 5 || cards.size() > 7) {
         throw std::invalid_argument("Hand evaluation requires 5-7 cards");
     }
@@ -43,8 +45,9 @@ HandStrength HandEvaluator::evaluate(const std::vector<Card>& cards) {
     }
     
     // Pour 6 ou 7 cartes, tester toutes les combinaisons de 5 cartes
-    HandStrength best_hand;
-    best_hand.ranking = HandRanking::HIGH_CARD;
+    // Plus faible que toute main réelle (kickers à zéro): sans initialisation,
+    // les kickers indéterminés faussaient les comparaisons de hauteurs
+    HandStrength best_hand{};
     
     std::vector<size_t> indices(cards.size());
     std::iota(indices.begin(), indices.end(), 0);
@@ -1,5 +1,7 @@
 #include "game_tree.h"
 #include "evaluator.h"
+#include "infoset_store.h"
+#include "metrics.h"
 #include <sstream>
 #include <algorithm>
 #include <cmath>
@@ -277,12 +279,43 @@ GameNode::GameNode(const GameState& state, int player)
     
     if (!is_terminal()) {
         actions = state_.get_legal_actions();
-        regret_sum.resize(actions.size(), 0.0);
-        strategy_sum.resize(actions.size(), 0.0);
+        owned_values_.reset(new double[2 * actions.size()]());
+        bind_values(owned_values_.get());
     }
 }
 
+GameNode::GameNode(const GameState& state, int player, const ValueAllocator& allocate)
+    : state_(state), player_(player) {
+    
+    if (!is_terminal()) {
+        actions = state_.get_legal_actions();
+        bind_values(allocate(actions.size()));
+    }
+}
+
+size_t GameNode::heap_bytes() const {
+    size_t bytes = heap_allocation_size(state_.board.capacity() * sizeof(Card)) +
+                   heap_allocation_size(state_.player_hands.capacity() * sizeof(Hand)) +
+                   heap_allocation_size(state_.stacks.capacity() * sizeof(double)) +
+                   heap_allocation_size(state_.bets.capacity() * sizeof(double)) +
+                   heap_allocation_size((state_.folded_players.capacity() + 7) / 8) +
+                   heap_allocation_size(state_.total_invested.capacity() * sizeof(double)) +
+                   heap_allocation_size(state_.allowed_bet_sizes.capacity() * sizeof(double)) +
+                   heap_allocation_size(actions.capacity() * sizeof(Action)) +
+                   heap_allocation_size(baseline.capacity() * sizeof(double));
+    if (owned_values_) {
+        bytes += heap_allocation_size(2 * actions.size() * sizeof(double));
+    }
+    return bytes;
+}
+
+void GameNode::bind_values(double* values) {
+    regret_sum = ValueSpan(values, actions.size());
+    strategy_sum = ValueSpan(values + actions.size(), actions.size());
+}
+
 std::vector<double> GameNode::get_strategy() const {
+    metrics::increment(metrics::Counter::REGRET_MATCHING_CALLS);
     std::vector<double> strategy(actions.size());
     double normalizing_sum = 0.0;
     
@@ -334,6 +367,69 @@ void GameNode::update_strategy_sum(const std::vector<double>& strategy) {
     }
 }
 
+namespace {
+
+double load_relaxed(const double& value) {
+    double result;
+    __atomic_load(&value, &result, __ATOMIC_RELAXED);
+    return result;
+}
+
+void add_relaxed(double& target, double delta) {
+    double sum = load_relaxed(target) + delta;
+    __atomic_store(&target, &sum, __ATOMIC_RELAXED);
+}
+
+} // namespace
+
+std::vector<double> GameNode::get_strategy_relaxed() const {
+    metrics::increment(metrics::Counter::REGRET_MATCHING_CALLS);
+    std::vector<double> strategy(actions.size());
+    double normalizing_sum = 0.0;
+    
+    for (size_t i = 0; i < actions.size(); ++i) {
+        strategy[i] = std::max(load_relaxed(regret_sum[i]), 0.0);
+        normalizing_sum += strategy[i];
+    }
+    
+    if (normalizing_sum > 0) {
+        for (double& s : strategy) {
+            s /= normalizing_sum;
+        }
+    } else {
+        std::fill(strategy.begin(), strategy.end(), 1.0 / actions.size());
+    }
+    
+    return strategy;
+}
+
+void GameNode::add_regret_relaxed(const std::vector<double>& regret) {
+    for (size_t i = 0; i < regret_sum.size() && i < regret.size(); ++i) {
+        add_relaxed(regret_sum[i], regret[i]);
+    }
+}
+
+void GameNode::add_strategy_sum_relaxed(const std::vector<double>& strategy) {
+    for (size_t i = 0; i < strategy_sum.size() && i < strategy.size(); ++i) {
+        add_relaxed(strategy_sum[i], strategy[i]);
+    }
+}
+
+double GameNode::baseline_value(size_t action, int player) const {
+    size_t index = action * state_.num_players + player;
+    return action < actions.size() && index < baseline.size() ? load_relaxed(baseline[index]) : 0.0;
+}
+
+void GameNode::update_baseline(size_t action, const std::vector<double>& values, double learning_rate) {
+    if (action >= actions.size() || (action + 1) * state_.num_players > baseline.size()) {
+        return;
+    }
+    double* slot = baseline.data() + action * state_.num_players;
+    for (int p = 0; p < state_.num_players && p < static_cast<int>(values.size()); ++p) {
+        add_relaxed(slot[p], learning_rate * (values[p] - load_relaxed(slot[p])));
+    }
+}
+
 // BasicAbstraction implementation
 BasicAbstraction::BasicAbstraction() : num_preflop_buckets_(169) {
     initialize_preflop_bucketing();
@@ -4,6 +4,7 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <functional>
 #include <unordered_map>
 
 namespace poker {
@@ -78,10 +79,37 @@ struct GameState {
         big_blind(0) {}
 };
 
+// Vue sur un tableau de valeurs d'infoset. La mémoire appartient à l'arène du
+// solveur, à un checkpoint mappé ou au nœud lui-même.
+class ValueSpan {
+public:
+    ValueSpan() : data_(nullptr), size_(0) {}
+    ValueSpan(double* data, size_t size) : data_(data), size_(size) {}
+    
+    double& operator[](size_t i) { return data_[i]; }
+    const double& operator[](size_t i) const { return data_[i]; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    double* data() { return data_; }
+    const double* data() const { return data_; }
+    double* begin() { return data_; }
+    double* end() { return data_ + size_; }
+    const double* begin() const { return data_; }
+    const double* end() const { return data_ + size_; }
+    
+private:
+    double* data_;
+    size_t size_;
+};
+
 // Nœud dans l'arbre de jeu pour CFR
 class GameNode {
 public:
+    // Fournit 2 * num_actions doubles: regret_sum puis strategy_sum
+    using ValueAllocator = std::function<double*(size_t num_actions)>;
+    
     GameNode(const GameState& state, int player);
+    GameNode(const GameState& state, int player, const ValueAllocator& allocate);
     
     const GameState& get_state() const { return state_; }
     int get_player() const { return player_; }
@@ -89,18 +117,63 @@ public:
     bool is_terminal() const { return state_.is_terminal(); }
     
     // Pour CFR
-    std::vector<double> regret_sum;
-    std::vector<double> strategy_sum;
+    ValueSpan regret_sum;
+    ValueSpan strategy_sum;
     std::vector<Action> actions;
     
+    // Enfants dans l'ordre des actions abstraites. Le solveur réserve les
+    // valeurs de tous les enfants d'un bloc à la première expansion du nœud;
+    // node est lié à la première visite de l'enfant. values == nullptr pour
+    // un état terminal. values permet de précharger sans déréférencer node.
+    struct Child {
+        GameNode* node;
+        double* values;
+    };
+    std::vector<Child> children;
+    
+    // Précharge le nœud et les valeurs de l'enfant i (à appeler avant de
+    // descendre dans l'enfant précédent)
+    void prefetch_child(size_t i) const {
+        if (i < children.size()) {
+            if (children[i].node) __builtin_prefetch(children[i].node);
+            if (children[i].values) __builtin_prefetch(children[i].values, 1);
+        }
+    }
+    
     std::vector<double> get_strategy() const;
     std::vector<double> get_average_strategy() const;
     void update_regret(const std::vector<double>& regret);
     void update_strategy_sum(const std::vector<double>& strategy);
     
+    // Variantes de la résolution multithread (Hogwild): chargements et
+    // stockages atomiques relâchés, sans verrou ni lecture-modification-
+    // écriture atomique. Deux additions concurrentes peuvent se perdre, ce
+    // que l'échantillonnage tolère; aucune donnée n'est lue à moitié écrite.
+    std::vector<double> get_strategy_relaxed() const;
+    void add_regret_relaxed(const std::vector<double>& regret);
+    void add_strategy_sum_relaxed(const std::vector<double>& strategy);
+    
+    // VR-MCCFR (CFRConfig::use_baselines): valeur de référence apprise par
+    // action et par joueur, baseline[action * num_players + joueur]; vide si
+    // désactivé. Hors des valeurs de l'infoset (ni checkpoint ni export).
+    std::vector<double> baseline;
+    // Accès relâchés, comme les variantes Hogwild ci-dessus. Les indices
+    // sont ceux des actions abstraites de la traversée: une action hors de
+    // actions garde une référence nulle (la correction reste sans biais).
+    double baseline_value(size_t action, int player) const;
+    // Moyenne exponentielle vers values (une valeur par joueur)
+    void update_baseline(size_t action, const std::vector<double>& values, double learning_rate);
+    
+    // Octets alloués sur le tas par le nœud, hors objet lui-même et hors
+    // valeurs fournies par un ValueAllocator (comptées par leur propriétaire)
+    size_t heap_bytes() const;
+    
 private:
     GameState state_;
     int player_; // -1 pour les nœuds de chance (distribution de cartes)
+    std::unique_ptr<double[]> owned_values_; // Nœuds créés hors d'une arène
+    
+    void bind_values(double* values);
 };
 
 // Générateur d'abstraction pour simplifier l'arbre de jeu
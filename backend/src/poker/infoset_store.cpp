@@ -0,0 +1,283 @@
+#include "infoset_store.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace poker {
+
+namespace {
+
+// Espace d'adressage réservé pour le fichier (MAP_NORESERVE: aucune mémoire engagée)
+constexpr size_t MAX_BACKING_BYTES = size_t(1) << 40;
+
+constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+// AnonHugePages de la zone de smaps qui contient address, en octets
+size_t transparent_huge_bytes(const std::string& smaps, uintptr_t address) {
+    size_t pos = 0;
+    while (pos < smaps.size()) {
+        size_t eol = smaps.find('\n', pos);
+        if (eol == std::string::npos) eol = smaps.size();
+        unsigned long start = 0, end = 0;
+        // Les lignes d'en-tête de zone commencent par "début-fin "
+        if (std::sscanf(smaps.c_str() + pos, "%lx-%lx ", &start, &end) == 2 &&
+            smaps[pos] != ' ' && address >= start && address < end) {
+            size_t field = smaps.find("AnonHugePages:", eol);
+            if (field == std::string::npos) return 0;
+            return std::strtoull(smaps.c_str() + field + 14, nullptr, 10) * 1024;
+        }
+        pos = eol + 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+InfosetStore::InfosetStore(size_t chunk_doubles)
+    : huge_pages_(false), chunk_doubles_(chunk_doubles), allocated_doubles_(0), reserved_doubles_(0), fd_(-1), region_(nullptr),
+      used_doubles_(0), file_doubles_(0), budget_windows_(0), current_window_(SIZE_MAX) {}
+
+InfosetStore::~InfosetStore() {
+    release_chunks();
+    release_backing_file();
+}
+
+void InfosetStore::use_backing_file(const std::string& directory, size_t resident_budget_bytes) {
+    if (allocated_doubles_ > 0 || region_) {
+        throw std::runtime_error("Le stockage hors mémoire doit être activé avant toute allocation");
+    }
+    // Les fenêtres doivent rester alignées sur les pages pour madvise
+    long page_size = ::sysconf(_SC_PAGESIZE);
+    size_t page_doubles = static_cast<size_t>(page_size) / sizeof(double);
+    chunk_doubles_ = (chunk_doubles_ + page_doubles - 1) / page_doubles * page_doubles;
+
+    std::string path = (directory.empty() ? std::string(".") : directory) + "/infosets-XXXXXX";
+    std::vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+    fd_ = ::mkstemp(name.data());
+    if (fd_ < 0) {
+        throw std::runtime_error("Impossible de créer le fichier de stockage dans " + directory +
+                                 " (" + std::strerror(errno) + ")");
+    }
+    // Fichier de travail anonyme: libéré automatiquement à la fermeture
+    ::unlink(name.data());
+
+    void* region = ::mmap(nullptr, MAX_BACKING_BYTES, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_NORESERVE, fd_, 0);
+    if (region == MAP_FAILED) {
+        int error = errno;
+        ::close(fd_);
+        fd_ = -1;
+        throw std::runtime_error(std::string("mmap du fichier de stockage impossible (") +
+                                 std::strerror(error) + ")");
+    }
+    region_ = static_cast<double*>(region);
+
+    size_t window_bytes = chunk_doubles_ * sizeof(double);
+    // Au moins la fenêtre courante et la fenêtre préchargée
+    budget_windows_ = resident_budget_bytes ? std::max<size_t>(2, resident_budget_bytes / window_bytes) : 0;
+}
+
+double* InfosetStore::allocate(size_t count) {
+    if (region_) {
+        if (count > file_doubles_ - used_doubles_) {
+            size_t needed = used_doubles_ + count;
+            size_t file_doubles = (needed + chunk_doubles_ - 1) / chunk_doubles_ * chunk_doubles_;
+            if (file_doubles * sizeof(double) > MAX_BACKING_BYTES ||
+                ::ftruncate(fd_, static_cast<off_t>(file_doubles * sizeof(double))) != 0) {
+                throw std::runtime_error(std::string("Extension du fichier de stockage impossible (") +
+                                         std::strerror(errno) + ")");
+            }
+            file_doubles_ = file_doubles;
+            reserved_doubles_ = file_doubles;
+        }
+        // L'extension par ftruncate fournit des zéros
+        double* values = region_ + used_doubles_;
+        used_doubles_ += count;
+        allocated_doubles_ += count;
+        touch(values);
+        return values;
+    }
+
+    if (chunks_.empty() || chunks_.back().capacity - chunks_.back().used < count) {
+        // Les infosets plus grands qu'un bloc obtiennent un bloc dédié
+        size_t capacity = std::max(chunk_doubles_, count);
+        chunks_.push_back(allocate_chunk(capacity));
+        reserved_doubles_ += capacity;
+    }
+
+    Chunk& chunk = chunks_.back();
+    double* values = chunk.data + chunk.used;
+    chunk.used += count;
+    allocated_doubles_ += count;
+    return values;
+}
+
+InfosetStore::Chunk InfosetStore::allocate_chunk(size_t capacity) {
+    if (huge_pages_) {
+        size_t bytes = (capacity * sizeof(double) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+        // Pages réservées par l'administrateur (vm.nr_hugepages): garanties mais souvent absentes
+        void* data = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (data != MAP_FAILED) {
+            return Chunk{static_cast<double*>(data), bytes / sizeof(double), 0, ChunkKind::HUGETLB, bytes};
+        }
+
+        // Repli: pages transparentes. La zone est alignée sur 2 Mo pour que
+        // le noyau puisse la couvrir entièrement de grandes pages.
+        void* raw = ::mmap(nullptr, bytes + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (raw != MAP_FAILED) {
+            uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+            uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+            if (aligned > start) {
+                ::munmap(raw, aligned - start);
+            }
+            ::munmap(reinterpret_cast<void*>(aligned + bytes), start + HUGE_PAGE_SIZE - aligned);
+            ::madvise(reinterpret_cast<void*>(aligned), bytes, MADV_HUGEPAGE);
+            return Chunk{reinterpret_cast<double*>(aligned), bytes / sizeof(double), 0, ChunkKind::MMAP, bytes};
+        }
+    }
+
+    double* data = static_cast<double*>(std::calloc(capacity, sizeof(double)));
+    if (!data) {
+        throw std::bad_alloc();
+    }
+    return Chunk{data, capacity, 0, ChunkKind::CALLOC, 0};
+}
+
+void InfosetStore::release_chunks() {
+    for (const auto& chunk : chunks_) {
+        if (chunk.kind == ChunkKind::CALLOC) {
+            std::free(chunk.data);
+        } else {
+            ::munmap(chunk.data, chunk.mapped_bytes);
+        }
+    }
+    chunks_.clear();
+}
+
+size_t InfosetStore::huge_page_bytes() const {
+    size_t bytes = 0;
+    std::string smaps;
+    for (const auto& chunk : chunks_) {
+        if (chunk.kind == ChunkKind::HUGETLB) {
+            bytes += chunk.mapped_bytes;
+        } else if (chunk.kind == ChunkKind::MMAP) {
+            if (smaps.empty()) {
+                std::ifstream file("/proc/self/smaps");
+                smaps.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            }
+            bytes += std::min(chunk.mapped_bytes,
+                              transparent_huge_bytes(smaps, reinterpret_cast<uintptr_t>(chunk.data)));
+        }
+    }
+    return bytes;
+}
+
+void InfosetStore::enter_window(size_t window) {
+    bool sequential = (window == current_window_ + 1);
+    if (budget_windows_ && current_window_ != SIZE_MAX) {
+        // Écriture asynchrone de la fenêtre quittée: son éviction ultérieure sera bon marché
+        size_t bytes = chunk_doubles_ * sizeof(double);
+        ::sync_file_range(fd_, static_cast<off_t>(current_window_ * bytes), static_cast<off_t>(bytes),
+                          SYNC_FILE_RANGE_WRITE);
+    }
+    current_window_ = window;
+
+    bool newly_resident = false;
+    if (budget_windows_) {
+        if (window >= lru_position_.size()) {
+            lru_position_.resize(window + 1, lru_.end());
+        }
+        if (lru_position_[window] != lru_.end()) {
+            lru_.splice(lru_.begin(), lru_, lru_position_[window]);
+        } else {
+            lru_.push_front(window);
+            lru_position_[window] = lru_.begin();
+            newly_resident = true;
+        }
+    }
+
+    // Les traversées suivent l'ordre d'allocation: la fenêtre suivante
+    // sera très probablement la prochaine visitée
+    size_t next_offset = (window + 1) * chunk_doubles_;
+    if ((newly_resident || (!budget_windows_ && sequential)) && next_offset < file_doubles_) {
+        ::madvise(region_ + next_offset, chunk_doubles_ * sizeof(double), MADV_WILLNEED);
+    }
+
+    while (lru_.size() > budget_windows_) {
+        size_t victim = lru_.back();
+        lru_.pop_back();
+        lru_position_[victim] = lru_.end();
+        evict_window(victim);
+    }
+}
+
+void InfosetStore::evict_window(size_t window) {
+    double* start = region_ + window * chunk_doubles_;
+    size_t bytes = chunk_doubles_ * sizeof(double);
+    // Les pages modifiées doivent être écrites avant de pouvoir quitter le
+    // cache de pages (l'écriture a normalement été lancée en quittant la fenêtre)
+    ::msync(start, bytes, MS_SYNC);
+    ::madvise(start, bytes, MADV_DONTNEED);
+    ::posix_fadvise(fd_, static_cast<off_t>(window * bytes), static_cast<off_t>(bytes), POSIX_FADV_DONTNEED);
+}
+
+void InfosetStore::clear() {
+    release_chunks();
+    allocated_doubles_ = 0;
+    reserved_doubles_ = 0;
+
+    if (region_) {
+        // Tronquer rend les pages au système et garantit des zéros à la réutilisation
+        if (::ftruncate(fd_, 0) != 0) {
+            release_backing_file();
+            throw std::runtime_error("Réinitialisation du fichier de stockage impossible");
+        }
+        used_doubles_ = 0;
+        file_doubles_ = 0;
+        current_window_ = SIZE_MAX;
+        lru_.clear();
+        lru_position_.clear();
+    }
+}
+
+size_t InfosetStore::resident_bytes() const {
+    if (!region_) {
+        return reserved_bytes();
+    }
+    size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    size_t bytes = file_doubles_ * sizeof(double);
+    std::vector<unsigned char> pages((bytes + page_size - 1) / page_size);
+    if (pages.empty() || ::mincore(region_, bytes, pages.data()) != 0) {
+        return 0;
+    }
+    size_t resident = 0;
+    for (unsigned char page : pages) {
+        resident += (page & 1);
+    }
+    return resident * page_size;
+}
+
+void InfosetStore::release_backing_file() {
+    if (region_) {
+        ::munmap(region_, MAX_BACKING_BYTES);
+        region_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+} // namespace poker
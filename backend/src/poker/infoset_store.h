@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace poker {
+
+// Taille réelle d'une allocation de request octets avec malloc (glibc:
+// en-tête de 8 octets, granularité de 16, bloc minimal de 32)
+inline size_t heap_allocation_size(size_t request) {
+    if (request == 0) return 0;
+    size_t size = (request + sizeof(size_t) + 15) & ~size_t(15);
+    return size < 32 ? 32 : size;
+}
+
+// Arène des valeurs d'infosets (regrets et sommes des stratégies).
+// Les valeurs sont allouées par blocs et ne sont jamais déplacées: les
+// GameNode peuvent donc conserver des pointeurs vers leurs tableaux.
+//
+// En mode hors mémoire (use_backing_file), les valeurs vivent dans un
+// fichier temporaire mappé (MAP_SHARED) et sont rangées dans l'ordre
+// d'allocation, c'est-à-dire l'ordre de la première traversée. Les
+// traversées suivantes parcourent donc le fichier presque séquentiellement:
+// la fenêtre suivante est préchargée et les fenêtres les moins récemment
+// utilisées sont rendues au noyau au-delà du budget de mémoire résidente.
+class InfosetStore {
+public:
+    static constexpr size_t DEFAULT_CHUNK_DOUBLES = 1 << 20; // 8 Mo par bloc
+
+    explicit InfosetStore(size_t chunk_doubles = DEFAULT_CHUNK_DOUBLES);
+    ~InfosetStore();
+
+    InfosetStore(const InfosetStore&) = delete;
+    InfosetStore& operator=(const InfosetStore&) = delete;
+
+    // Active le stockage hors mémoire dans un fichier anonyme de directory.
+    // resident_budget_bytes = 0 laisse la pagination entièrement au noyau.
+    // À appeler avant toute allocation; lève std::runtime_error en cas d'échec.
+    void use_backing_file(const std::string& directory, size_t resident_budget_bytes);
+    bool file_backed() const { return region_ != nullptr; }
+
+    // Blocs en mémoire sur pages de 2 Mo: MAP_HUGETLB (pages réservées) si
+    // possible, sinon pages transparentes (MADV_HUGEPAGE). À appeler avant
+    // toute allocation; sans effet en mode hors mémoire.
+    void use_huge_pages(bool enabled) { huge_pages_ = enabled; }
+
+    // Retourne count doubles initialisés à zéro
+    double* allocate(size_t count);
+
+    // Signale l'accès aux valeurs d'un nœud (no-op hors mode fichier)
+    void touch(const double* values) {
+        if (region_ && values >= region_ && values < region_ + used_doubles_) {
+            touch_window(static_cast<size_t>(values - region_) / chunk_doubles_);
+        }
+    }
+
+    // Libère tous les blocs (les pointeurs existants deviennent invalides)
+    void clear();
+
+    size_t allocated_bytes() const { return allocated_doubles_ * sizeof(double); }
+    size_t reserved_bytes() const { return reserved_doubles_ * sizeof(double); }
+
+    // Mémoire effectivement résidente (mincore en mode fichier)
+    size_t resident_bytes() const;
+
+    // Octets des blocs effectivement servis par des pages de 2 Mo (MAP_HUGETLB,
+    // plus pages transparentes relevées dans /proc/self/smaps)
+    size_t huge_page_bytes() const;
+
+private:
+    enum class ChunkKind { CALLOC, MMAP, HUGETLB };
+    struct Chunk {
+        double* data;    // Pages mises à zéro à la demande dans tous les cas
+        size_t capacity;
+        size_t used;
+        ChunkKind kind;
+        size_t mapped_bytes;
+    };
+
+    bool huge_pages_;
+    size_t chunk_doubles_;
+    size_t allocated_doubles_;
+    size_t reserved_doubles_;        // Blocs en mémoire, ou taille du fichier en mode hors mémoire
+    std::vector<Chunk> chunks_;
+
+    // Mode hors mémoire: une seule réservation virtuelle, découpée en
+    // fenêtres de chunk_doubles_ et étendue par ftruncate
+    int fd_;
+    double* region_;
+    size_t used_doubles_;
+    size_t file_doubles_;
+    size_t budget_windows_;          // 0 = pas de budget
+    size_t current_window_;
+    std::list<size_t> lru_;          // Fenêtres résidentes, la plus récente en tête
+    std::vector<std::list<size_t>::iterator> lru_position_;
+
+    void touch_window(size_t window) {
+        if (window != current_window_) {
+            enter_window(window);
+        }
+    }
+    Chunk allocate_chunk(size_t capacity);
+    void release_chunks();
+    void enter_window(size_t window);
+    void evict_window(size_t window);
+    void release_backing_file();
+};
+
+} // namespace poker
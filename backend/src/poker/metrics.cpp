@@ -0,0 +1,159 @@
+#include "metrics.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace poker {
+namespace metrics {
+
+namespace {
+
+#ifdef POKER_SOLVER_METRICS
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<const ThreadCounters*> threads;
+    Snapshot retired; // Totaux des threads terminés
+};
+
+// Jamais détruit: les compteurs thread_local du thread principal peuvent
+// être détruits après les objets statiques
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+void accumulate(Snapshot& total, const ThreadCounters& thread) {
+    for (size_t i = 0; i < NUM_COUNTERS; ++i) {
+        total.counters[i] += thread.counters[i].load(std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < NUM_TIMERS; ++i) {
+        total.timer_nanoseconds[i] += thread.timer_nanoseconds[i].load(std::memory_order_relaxed);
+        total.timer_calls[i] += thread.timer_calls[i].load(std::memory_order_relaxed);
+    }
+}
+
+#endif
+
+struct CounterInfo {
+    Counter counter;
+    const char* name;
+    const char* help;
+};
+
+const CounterInfo COUNTERS[] = {
+    {Counter::ITERATIONS, "poker_solver_iterations_total", "Itérations CFR terminées"},
+    {Counter::NODES_VISITED, "poker_solver_nodes_visited_total", "Nœuds de décision traversés pendant l'entraînement"},
+    {Counter::INFOSETS_CREATED, "poker_solver_infosets_created_total", "Infosets créés"},
+    {Counter::REGRET_MATCHING_CALLS, "poker_solver_regret_matching_calls_total", "Appels au regret matching"},
+    {Counter::EVALUATOR_CALLS, "poker_solver_evaluator_calls_total", "Évaluations de mains"},
+};
+
+struct TimerInfo {
+    Timer timer;
+    const char* name;
+    const char* help;
+};
+
+const TimerInfo TIMERS[] = {
+    {Timer::SOLVE, "poker_solver_solve_seconds", "Durée des résolutions"},
+    {Timer::EXPLOITABILITY, "poker_solver_exploitability_seconds", "Durée des calculs d'exploitabilité"},
+    {Timer::CHECKPOINT, "poker_solver_checkpoint_seconds", "Temps de checkpoint bloquant le solveur"},
+    {Timer::CHECKPOINT_WRITE, "poker_solver_checkpoint_write_seconds", "Durée d'écriture des fichiers de checkpoint"},
+};
+
+} // namespace
+
+#ifdef POKER_SOLVER_METRICS
+
+ThreadCounters::ThreadCounters() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.threads.push_back(this);
+}
+
+ThreadCounters::~ThreadCounters() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    accumulate(r.retired, *this);
+    r.threads.erase(std::remove(r.threads.begin(), r.threads.end(), this), r.threads.end());
+}
+
+Snapshot snapshot() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Snapshot total = r.retired;
+    for (const ThreadCounters* thread : r.threads) {
+        accumulate(total, *thread);
+    }
+    return total;
+}
+
+#else
+
+Snapshot snapshot() {
+    return Snapshot{};
+}
+
+#endif
+
+std::string prometheus_text() {
+    Snapshot s = snapshot();
+    std::ostringstream out;
+    out.precision(9);
+
+    out << "# HELP poker_solver_metrics_enabled Instrumentation compilée (POKER_SOLVER_METRICS)\n"
+        << "# TYPE poker_solver_metrics_enabled gauge\n"
+        << "poker_solver_metrics_enabled " << (enabled ? 1 : 0) << "\n";
+    if (!enabled) {
+        return out.str();
+    }
+
+    for (const auto& info : COUNTERS) {
+        out << "# HELP " << info.name << " " << info.help << "\n"
+            << "# TYPE " << info.name << " counter\n"
+            << info.name << " " << s.counter(info.counter) << "\n";
+    }
+    for (const auto& info : TIMERS) {
+        out << "# HELP " << info.name << " " << info.help << "\n"
+            << "# TYPE " << info.name << " summary\n"
+            << info.name << "_sum " << std::fixed << s.seconds(info.timer) << std::defaultfloat << "\n"
+            << info.name << "_count " << s.calls(info.timer) << "\n";
+    }
+
+    // Débit moyen d'un solveur: les durées de solve() concurrentes s'additionnent
+    double solve_seconds = s.seconds(Timer::SOLVE);
+    double rate = solve_seconds > 0 ? s.counter(Counter::ITERATIONS) / solve_seconds : 0.0;
+    out << "# HELP poker_solver_iterations_per_second Itérations par seconde de résolution\n"
+        << "# TYPE poker_solver_iterations_per_second gauge\n"
+        << "poker_solver_iterations_per_second " << rate << "\n";
+    return out.str();
+}
+
+void write_prometheus_file(const std::string& path) {
+    // Les workers du démon partagent le fichier temporaire
+    static std::mutex write_mutex;
+    std::lock_guard<std::mutex> lock(write_mutex);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Impossible d'écrire le fichier de métriques: " + temporary);
+        }
+        file << prometheus_text();
+        if (!file.flush()) {
+            throw std::runtime_error("Échec d'écriture du fichier de métriques: " + temporary);
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Impossible de renommer " + temporary + " en " + path);
+    }
+}
+
+} // namespace metrics
+} // namespace poker
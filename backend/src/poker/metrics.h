@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace poker {
+namespace metrics {
+
+// Instrumentation du solveur, agrégée sur tout le processus et exportée au
+// format texte Prometheus. Compilée seulement avec POKER_SOLVER_METRICS
+// (option CMake du même nom, active par défaut): sans elle, increment() et
+// ScopedTimer sont vides et le chemin critique est inchangé.
+//
+// Chaque thread incrémente ses propres compteurs (chargement + stockage
+// relâchés, sans instruction atomique ni partage de ligne de cache);
+// snapshot() additionne les compteurs de tous les threads.
+
+enum class Counter : size_t {
+    ITERATIONS,             // Itérations de solve() terminées
+    NODES_VISITED,          // Nœuds de décision traversés pendant l'entraînement
+    INFOSETS_CREATED,       // Nœuds ajoutés à node_map_
+    REGRET_MATCHING_CALLS,  // Stratégies courantes calculées à partir des regrets
+    EVALUATOR_CALLS,        // Évaluations de mains (HandEvaluator::evaluate)
+    COUNT
+};
+
+enum class Timer : size_t {
+    SOLVE,             // Durée des appels à solve()
+    EXPLOITABILITY,    // Mesures d'exploitabilité (en cours et finale)
+    CHECKPOINT,        // Temps de checkpoint bloquant le solveur (snapshot, attente)
+    CHECKPOINT_WRITE,  // Écriture des fichiers, y compris en arrière-plan
+    COUNT
+};
+
+constexpr size_t NUM_COUNTERS = static_cast<size_t>(Counter::COUNT);
+constexpr size_t NUM_TIMERS = static_cast<size_t>(Timer::COUNT);
+
+struct Snapshot {
+    std::array<uint64_t, NUM_COUNTERS> counters{};
+    std::array<uint64_t, NUM_TIMERS> timer_nanoseconds{};
+    std::array<uint64_t, NUM_TIMERS> timer_calls{};
+
+    uint64_t counter(Counter c) const { return counters[static_cast<size_t>(c)]; }
+    double seconds(Timer t) const { return timer_nanoseconds[static_cast<size_t>(t)] * 1e-9; }
+    uint64_t calls(Timer t) const { return timer_calls[static_cast<size_t>(t)]; }
+};
+
+#ifdef POKER_SOLVER_METRICS
+
+constexpr bool enabled = true;
+
+// Compteurs d'un thread, enregistrés auprès du registre global pendant sa vie
+// et reportés dans les totaux des threads terminés à sa fin
+struct ThreadCounters {
+    std::array<std::atomic<uint64_t>, NUM_COUNTERS> counters{};
+    std::array<std::atomic<uint64_t>, NUM_TIMERS> timer_nanoseconds{};
+    std::array<std::atomic<uint64_t>, NUM_TIMERS> timer_calls{};
+
+    ThreadCounters();
+    ~ThreadCounters();
+    ThreadCounters(const ThreadCounters&) = delete;
+    ThreadCounters& operator=(const ThreadCounters&) = delete;
+};
+
+inline thread_local ThreadCounters thread_counters;
+
+// Seul le thread propriétaire écrit: pas besoin d'incrément atomique
+inline void add(std::atomic<uint64_t>& value, uint64_t n) {
+    value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline void increment(Counter counter, uint64_t n = 1) {
+    add(thread_counters.counters[static_cast<size_t>(counter)], n);
+}
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Timer timer) : timer_(timer), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        size_t index = static_cast<size_t>(timer_);
+        add(thread_counters.timer_nanoseconds[index],
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        add(thread_counters.timer_calls[index], 1);
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Timer timer_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#else
+
+constexpr bool enabled = false;
+
+inline void increment(Counter, uint64_t = 1) {}
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Timer) {}
+};
+
+#endif
+
+// Totaux du processus (zéros si l'instrumentation n'est pas compilée)
+Snapshot snapshot();
+
+// Exposition au format texte Prometheus 0.0.4
+std::string prometheus_text();
+
+// Écrit prometheus_text() dans path via un fichier temporaire renommé, pour
+// que le collecteur textfile de node_exporter ne lise jamais un fichier partiel.
+// Appelable depuis plusieurs threads. Lève std::runtime_error en cas d'échec.
+void write_prometheus_file(const std::string& path);
+
+} // namespace metrics
+} // namespace poker
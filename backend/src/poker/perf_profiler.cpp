@@ -0,0 +1,132 @@
+#include "perf_profiler.h"
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace poker {
+
+namespace {
+
+struct CounterSpec {
+    PerfCounter counter;
+    uint32_t type;
+    uint64_t config;
+    const char* name;
+};
+
+const CounterSpec COUNTER_SPECS[] = {
+    {PerfCounter::TASK_CLOCK, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, "task-clock"},
+    {PerfCounter::CYCLES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles"},
+    {PerfCounter::INSTRUCTIONS, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions"},
+    {PerfCounter::CACHE_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, "cache-misses"},
+    {PerfCounter::BRANCH_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch-misses"},
+};
+
+// Compteur du thread appelant, en espace utilisateur uniquement
+int open_counter(const CounterSpec& spec, int group_fd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = group_fd == -1 ? 1 : 0; // Le groupe démarre avec son meneur
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC));
+}
+
+} // namespace
+
+const char* profile_phase_name(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::TRAVERSAL: return "traversal";
+        case ProfilePhase::TERMINAL_EVALUATION: return "terminal_evaluation";
+        case ProfilePhase::REGRET_UPDATE: return "regret_update";
+        case ProfilePhase::EXPLOITABILITY: return "exploitability";
+        default: return "unknown";
+    }
+}
+
+PhaseProfiler::PhaseProfiler() : group_fd_(-1), current_phase_(NO_PHASE), last_values_{} {
+    profile_.enabled = true;
+
+    // Meneur logiciel: le temps CPU reste mesurable sans PMU
+    std::string missing;
+    for (const auto& spec : COUNTER_SPECS) {
+        int fd = open_counter(spec, group_fd_);
+        if (fd < 0) {
+            if (group_fd_ < 0) {
+                profile_.error = std::string("perf_event_open: ") + std::strerror(errno);
+                return;
+            }
+            if (missing.empty()) {
+                missing = std::string(spec.name) + " (" + std::strerror(errno) + ")";
+            } else {
+                missing += std::string(", ") + spec.name;
+            }
+            continue;
+        }
+        if (group_fd_ < 0) {
+            group_fd_ = fd;
+        }
+        fds_.push_back(fd);
+        group_counters_.push_back(spec.counter);
+        profile_.counter_available[static_cast<size_t>(spec.counter)] = true;
+    }
+    if (!missing.empty()) {
+        profile_.error = "Compteurs indisponibles: " + missing;
+    }
+
+    ioctl(group_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(group_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    read_counters(last_values_);
+}
+
+PhaseProfiler::~PhaseProfiler() {
+    for (int fd : fds_) {
+        close(fd);
+    }
+}
+
+bool PhaseProfiler::read_counters(std::array<uint64_t, NUM_PERF_COUNTERS>& values) const {
+    if (group_fd_ < 0) {
+        return false;
+    }
+    // PERF_FORMAT_GROUP: nombre de compteurs puis leurs valeurs, dans l'ordre d'ouverture
+    uint64_t buffer[1 + NUM_PERF_COUNTERS];
+    ssize_t bytes = read(group_fd_, buffer, sizeof(buffer));
+    if (bytes < static_cast<ssize_t>(sizeof(uint64_t)) || buffer[0] != group_counters_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < group_counters_.size(); ++i) {
+        values[static_cast<size_t>(group_counters_[i])] = buffer[1 + i];
+    }
+    return true;
+}
+
+int PhaseProfiler::switch_to(int phase) {
+    int previous = current_phase_;
+    std::array<uint64_t, NUM_PERF_COUNTERS> values = last_values_;
+    if (read_counters(values)) {
+        if (current_phase_ != NO_PHASE) {
+            auto& totals = profile_.phases[static_cast<size_t>(current_phase_)];
+            for (size_t i = 0; i < NUM_PERF_COUNTERS; ++i) {
+                totals[i] += values[i] - last_values_[i];
+            }
+        }
+        last_values_ = values;
+    }
+    current_phase_ = phase;
+    return previous;
+}
+
+const HardwareProfile& PhaseProfiler::profile() {
+    switch_to(current_phase_);
+    return profile_;
+}
+
+} // namespace poker
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace poker {
+
+// Phases d'une résolution distinguées par le profilage matériel
+enum class ProfilePhase : size_t {
+    TRAVERSAL,            // Parcours de l'arbre (hors phases ci-dessous)
+    TERMINAL_EVALUATION,  // Gains des états terminaux
+    REGRET_UPDATE,        // Regrets et somme des stratégies d'un nœud
+    EXPLOITABILITY,       // Mesures d'exploitabilité
+    COUNT
+};
+
+enum class PerfCounter : size_t {
+    TASK_CLOCK,     // Temps CPU du thread (ns, compteur logiciel)
+    CYCLES,
+    INSTRUCTIONS,
+    CACHE_MISSES,   // Défauts du dernier niveau de cache
+    BRANCH_MISSES,
+    COUNT
+};
+
+constexpr size_t NUM_PROFILE_PHASES = static_cast<size_t>(ProfilePhase::COUNT);
+constexpr size_t NUM_PERF_COUNTERS = static_cast<size_t>(PerfCounter::COUNT);
+
+const char* profile_phase_name(ProfilePhase phase);
+
+// Compteurs accumulés par phase pendant un solve()
+struct HardwareProfile {
+    bool enabled = false;
+    std::string error; // Raison de l'absence de compteurs matériels (vide sinon)
+    std::array<bool, NUM_PERF_COUNTERS> counter_available{};
+    std::array<std::array<uint64_t, NUM_PERF_COUNTERS>, NUM_PROFILE_PHASES> phases{};
+    uint64_t nodes_visited = 0;
+
+    uint64_t value(ProfilePhase phase, PerfCounter counter) const {
+        return phases[static_cast<size_t>(phase)][static_cast<size_t>(counter)];
+    }
+};
+
+// Profilage par perf_event_open(2) des phases du thread qui a construit le
+// profileur: un groupe de compteurs (temps CPU, cycles, instructions, défauts
+// de cache et de prédiction de branchement) lu en un appel système à chaque
+// changement de phase, le delta étant attribué à la phase quittée.
+//
+// Les lectures par nœud ont un coût (un appel système par changement de
+// phase): mode de diagnostic (CFRConfig::profile_hardware_counters), pas de
+// production continue. Sans PMU accessible (machine virtuelle,
+// perf_event_paranoid), seul le temps CPU est mesuré et error est renseigné.
+class PhaseProfiler {
+public:
+    PhaseProfiler();
+    ~PhaseProfiler();
+
+    PhaseProfiler(const PhaseProfiler&) = delete;
+    PhaseProfiler& operator=(const PhaseProfiler&) = delete;
+
+    void count_node() { ++profile_.nodes_visited; }
+
+    // Profil accumulé (la phase en cours est comptée jusqu'à cet appel)
+    const HardwareProfile& profile();
+
+    // Phase active pendant la durée de vie de l'objet; les phases s'imbriquent
+    // (la phase englobante reprend à la destruction). Sans profileur: aucun effet.
+    class Scope {
+    public:
+        Scope(PhaseProfiler* profiler, ProfilePhase phase) : profiler_(profiler), previous_(NO_PHASE) {
+            if (profiler_) {
+                previous_ = profiler_->switch_to(static_cast<int>(phase));
+            }
+        }
+        ~Scope() {
+            if (profiler_) {
+                profiler_->switch_to(previous_);
+            }
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        PhaseProfiler* profiler_;
+        int previous_;
+    };
+
+private:
+    static constexpr int NO_PHASE = -1;
+
+    int group_fd_;
+    std::vector<int> fds_;
+    std::vector<PerfCounter> group_counters_; // Ordre des valeurs dans une lecture du groupe
+    int current_phase_;
+    std::array<uint64_t, NUM_PERF_COUNTERS> last_values_;
+    HardwareProfile profile_;
+
+    // Attribue le delta depuis la dernière lecture à la phase courante puis
+    // passe à phase; retourne la phase quittée
+    int switch_to(int phase);
+    bool read_counters(std::array<uint64_t, NUM_PERF_COUNTERS>& values) const;
+};
+
+} // namespace poker
@@ -0,0 +1,84 @@
+#include "progress_reporter.h"
+#include <json/json.h>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+
+namespace poker {
+
+ProgressReporter::ProgressReporter(const CFRSolver& solver, int fd, std::chrono::milliseconds interval)
+    : solver_(solver), fd_(fd), interval_(std::max(interval, std::chrono::milliseconds(1))),
+      start_(std::chrono::steady_clock::now()), last_time_(start_),
+      last_iteration_(solver.current_iteration()), write_failed_(false), stopping_(false) {
+    // Un lecteur qui ferme le flux ne doit pas interrompre la résolution
+    std::signal(SIGPIPE, SIG_IGN);
+    thread_ = std::thread(&ProgressReporter::run, this);
+}
+
+ProgressReporter::~ProgressReporter() {
+    stop();
+}
+
+void ProgressReporter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+    emit("finished");
+}
+
+void ProgressReporter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!cv_.wait_for(lock, interval_, [this] { return stopping_; })) {
+        lock.unlock();
+        emit("progress");
+        lock.lock();
+    }
+}
+
+void ProgressReporter::emit(const char* type) {
+    if (write_failed_) {
+        return;
+    }
+    CFRSolver::Progress progress = solver_.progress();
+    auto now = std::chrono::steady_clock::now();
+    double interval_seconds = std::chrono::duration<double>(now - last_time_).count();
+
+    Json::Value event;
+    event["type"] = type;
+    event["iteration"] = progress.iteration;
+    event["exploitability"] = std::isnan(progress.exploitability) ? Json::Value() : Json::Value(progress.exploitability);
+    event["elapsed_seconds"] = std::chrono::duration<double>(now - start_).count();
+    event["infosets"] = static_cast<Json::UInt64>(progress.infosets);
+    event["memory_bytes"] = static_cast<Json::UInt64>(progress.memory_bytes);
+    event["iterations_per_second"] = interval_seconds > 0 ? (progress.iteration - last_iteration_) / interval_seconds : 0.0;
+    last_time_ = now;
+    last_iteration_ = progress.iteration;
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    std::string line = Json::writeString(builder, event) + "\n";
+    for (size_t written = 0; written < line.size();) {
+        ssize_t n = ::write(fd_, line.data() + written, line.size() - written);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            std::cerr << "Avertissement: Flux d'avancement interrompu: " << std::strerror(errno) << std::endl;
+            write_failed_ = true;
+            return;
+        }
+        written += static_cast<size_t>(n);
+    }
+}
+
+} // namespace poker
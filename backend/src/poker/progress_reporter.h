@@ -0,0 +1,54 @@
+#pragma once
+
+#include "cfr_solver.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace poker {
+
+// Flux d'avancement NDJSON d'un solve(), écrit par un thread dédié sur un
+// descripteur séparé de la sortie du résultat (--progress-fd).
+//
+// Le solveur ne fait que publier quelques compteurs atomiques à chaque
+// itération (CFRSolver::progress()); le formatage et l'écriture se font ici,
+// toutes les interval millisecondes:
+//   {"type": "progress", "iteration": n, "exploitability": x|null,
+//    "elapsed_seconds": t, "infosets": k, "memory_bytes": b,
+//    "iterations_per_second": r}
+// puis, à stop(), un dernier événement {"type": "finished", ...} avec les
+// mêmes champs. iterations_per_second porte sur l'intervalle écoulé depuis
+// l'événement précédent.
+class ProgressReporter {
+public:
+    // fd reste la propriété de l'appelant. Démarre le thread immédiatement.
+    ProgressReporter(const CFRSolver& solver, int fd, std::chrono::milliseconds interval);
+    ~ProgressReporter();
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    // Arrête le thread et écrit l'événement final (idempotent)
+    void stop();
+
+private:
+    const CFRSolver& solver_;
+    int fd_;
+    std::chrono::milliseconds interval_;
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::steady_clock::time_point last_time_;
+    int last_iteration_;
+    bool write_failed_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_;
+    std::thread thread_;
+
+    void run();
+    void emit(const char* type);
+};
+
+} // namespace poker
@@ -0,0 +1,153 @@
+#include "socket_io.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace poker {
+
+namespace {
+
+sockaddr_un unix_address(const std::string& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Chemin de socket trop long: " + path);
+    }
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    return address;
+}
+
+// Résolution de "hôte:port"; à libérer par freeaddrinfo
+addrinfo* resolve_tcp(const std::string& address, bool passive) {
+    size_t colon = address.rfind(':');
+    std::string host = address.substr(0, colon);
+    std::string port = address.substr(colon + 1);
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+    addrinfo* results = nullptr;
+    int status = ::getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &results);
+    if (status != 0) {
+        throw std::runtime_error("Adresse invalide " + address + " (" + ::gai_strerror(status) + ")");
+    }
+    return results;
+}
+
+// Trames courtes échangées à chaque itération: pas d'attente de Nagle
+void set_no_delay(int fd) {
+    int enable = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+}
+
+std::runtime_error socket_error(const char* what, const std::string& address) {
+    return std::runtime_error(std::string(what) + " " + address + " (" + std::strerror(errno) + ")");
+}
+
+} // namespace
+
+bool read_fully(int fd, char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::read(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool write_fully(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool is_unix_socket_address(const std::string& address) {
+    return address.find('/') != std::string::npos || address.find(':') == std::string::npos;
+}
+
+int listen_socket(const std::string& address, int backlog) {
+    if (is_unix_socket_address(address)) {
+        sockaddr_un un = unix_address(address);
+        int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        ::unlink(address.c_str()); // Socket laissé par une exécution précédente
+        if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&un), sizeof(un)) != 0 || ::listen(fd, backlog) != 0) {
+            std::runtime_error error = socket_error("Impossible d'écouter sur", address);
+            if (fd >= 0) ::close(fd);
+            throw error;
+        }
+        return fd;
+    }
+
+    addrinfo* results = resolve_tcp(address, true);
+    int fd = -1;
+    for (addrinfo* ai = results; ai && fd < 0; ai = ai->ai_next) {
+        fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) continue;
+        int reuse = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (::bind(fd, ai->ai_addr, ai->ai_addrlen) != 0 || ::listen(fd, backlog) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    ::freeaddrinfo(results);
+    if (fd < 0) {
+        throw socket_error("Impossible d'écouter sur", address);
+    }
+    return fd;
+}
+
+int connect_socket(const std::string& address) {
+    if (is_unix_socket_address(address)) {
+        sockaddr_un un = unix_address(address);
+        int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&un), sizeof(un)) != 0) {
+            std::runtime_error error = socket_error("Connexion impossible à", address);
+            if (fd >= 0) ::close(fd);
+            throw error;
+        }
+        return fd;
+    }
+
+    addrinfo* results = resolve_tcp(address, false);
+    int fd = -1;
+    for (addrinfo* ai = results; ai && fd < 0; ai = ai->ai_next) {
+        fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd >= 0 && ::connect(fd, ai->ai_addr, ai->ai_addrlen) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    ::freeaddrinfo(results);
+    if (fd < 0) {
+        throw socket_error("Connexion impossible à", address);
+    }
+    set_no_delay(fd);
+    return fd;
+}
+
+int accept_socket(int listen_fd) {
+    int fd;
+    do {
+        fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+    if (fd >= 0) {
+        set_no_delay(fd); // Sans effet sur un socket Unix
+    }
+    return fd;
+}
+
+} // namespace poker
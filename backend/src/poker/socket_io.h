@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace poker {
+
+// E/S bloquantes sur un descripteur (socket, tube), reprises après EINTR.
+// false en fin de flux ou en cas d'erreur.
+bool read_fully(int fd, char* data, size_t size);
+bool write_fully(int fd, const char* data, size_t size);
+
+// Adresse "hôte:port" (TCP, hôte vide: toutes les interfaces à l'écoute) ou
+// chemin de socket Unix (toute adresse qui contient '/' ou pas de ':').
+// Lèvent std::runtime_error en cas d'échec.
+int listen_socket(const std::string& address, int backlog);
+int connect_socket(const std::string& address);
+// Connexion suivante sur un socket de listen_socket; -1 en cas d'échec (errno)
+int accept_socket(int listen_fd);
+bool is_unix_socket_address(const std::string& address);
+
+} // namespace poker
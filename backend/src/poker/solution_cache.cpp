@@ -0,0 +1,322 @@
+#include "solution_cache.h"
+#include "binary_io.h"
+#include "solve_job.h"
+#include "strategy_file.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace poker {
+
+namespace {
+
+using SuitPermutation = std::array<int, 4>;
+
+Card permute(const Card& card, const SuitPermutation& permutation) {
+    return Card(card.rank(), static_cast<Suit>(permutation[static_cast<int>(card.suit())]));
+}
+
+// Flop trié (l'ordre de ses cartes ne change pas le spot), turn et river à leur place
+std::string canonical_board(const Board& board, const SuitPermutation& permutation) {
+    Board permuted;
+    for (const Card& card : board) {
+        permuted.push_back(permute(card, permutation));
+    }
+    std::sort(permuted.begin(), permuted.begin() + std::min<size_t>(3, permuted.size()));
+    return board_to_string(permuted);
+}
+
+// Range en texte ("AhKh, QsQd:0.5, AKs"): combinaisons explicites
+// renommées et ordonnées, éléments triés; les autres notations sont
+// invariantes par couleur
+std::string canonical_range(const std::string& range, const SuitPermutation& permutation) {
+    std::vector<std::string> items;
+    size_t pos = 0;
+    while (pos <= range.size()) {
+        size_t end = range.find(',', pos);
+        if (end == std::string::npos) end = range.size();
+        std::string item = range.substr(pos, end - pos);
+        item.erase(0, item.find_first_not_of(" \t"));
+        item.erase(item.find_last_not_of(" \t") + 1);
+        if (!item.empty()) {
+            size_t colon = item.find(':');
+            std::string combo = item.substr(0, colon);
+            if (combo.size() == 4) {
+                try {
+                    std::vector<Card> cards = parse_cards(combo);
+                    Card first = permute(cards[0], permutation);
+                    Card second = permute(cards[1], permutation);
+                    if (first < second) std::swap(first, second);
+                    item = first.to_string() + second.to_string() +
+                           (colon == std::string::npos ? "" : item.substr(colon));
+                } catch (const std::invalid_argument&) {
+                    // Notation abrégée de 4 caractères ("AKo+"): inchangée
+                }
+            }
+            items.push_back(item);
+        }
+        pos = end + 1;
+    }
+    std::sort(items.begin(), items.end());
+    std::string canonical;
+    for (const std::string& item : items) {
+        canonical += (canonical.empty() ? "" : ",") + item;
+    }
+    return canonical;
+}
+
+Json::Value canonical_ranges(const Json::Value& ranges, const SuitPermutation& permutation) {
+    if (ranges.isString()) {
+        return canonical_range(ranges.asString(), permutation);
+    }
+    Json::Value canonical = ranges;
+    if (ranges.isArray()) {
+        for (Json::ArrayIndex i = 0; i < ranges.size(); ++i) {
+            canonical[i] = canonical_ranges(ranges[i], permutation);
+        }
+    } else if (ranges.isObject()) {
+        for (const std::string& name : ranges.getMemberNames()) {
+            canonical[name] = canonical_ranges(ranges[name], permutation);
+        }
+    }
+    return canonical;
+}
+
+std::string write_compact(const Json::Value& value) {
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    builder["precision"] = 17;
+    return Json::writeString(builder, value);
+}
+
+std::string hex_key(uint64_t hash) {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+    return buffer;
+}
+
+bool has_suffix(const std::string& name, const std::string& suffix) {
+    return name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Date de modification rafraîchie: l'entrée devient la plus récemment utilisée
+void touch(const std::string& path) {
+    ::utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+}
+
+} // namespace
+
+std::string canonical_spot(const std::string& task_type, const Json::Value& params) {
+    Json::Value game_config = params["game_config"];
+    Board board;
+    if (game_config.isObject() && game_config.isMember("board")) {
+        board = parse_board_config(game_config["board"]);
+    }
+    Json::Value ranges = game_config.isObject() ? game_config.get("ranges", Json::Value()) : Json::Value();
+
+    // Renommage des couleurs qui donne la plus petite représentation
+    SuitPermutation permutation = {0, 1, 2, 3};
+    std::string best;
+    Json::Value best_ranges;
+    std::string best_board;
+    do {
+        std::string candidate_board = canonical_board(board, permutation);
+        Json::Value candidate_ranges = canonical_ranges(ranges, permutation);
+        std::string candidate = candidate_board + '\n' + write_compact(candidate_ranges);
+        if (best.empty() || candidate < best) {
+            best = std::move(candidate);
+            best_board = std::move(candidate_board);
+            best_ranges = std::move(candidate_ranges);
+        }
+    } while (std::next_permutation(permutation.begin(), permutation.end()));
+
+    if (game_config.isObject()) {
+        if (game_config.isMember("board")) {
+            game_config["board"] = best_board;
+        }
+        if (game_config.isMember("ranges")) {
+            game_config["ranges"] = best_ranges;
+        }
+    }
+
+    CFRConfig config = parse_solver_config(params["solver_config"]);
+    Json::Value solver_config;
+    solver_config["use_chance_sampling"] = config.use_chance_sampling;
+    solver_config["use_discounting"] = config.use_discounting;
+    solver_config["alpha"] = config.alpha;
+    solver_config["beta"] = config.beta;
+    if (config.use_baselines) {
+        solver_config["use_baselines"] = true;
+        solver_config["baseline_learning_rate"] = config.baseline_learning_rate;
+    }
+
+    Json::Value spot;
+    spot["task_type"] = task_type;
+    spot["game_config"] = game_config;
+    spot["solver_config"] = solver_config;
+    return write_compact(spot);
+}
+
+SolutionCache::SolutionCache(const std::string& directory, uint64_t max_bytes)
+    : directory_(directory), max_bytes_(max_bytes) {
+    if (::mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw std::runtime_error("Impossible de créer le cache de solutions " + directory + " (" +
+                                 std::strerror(errno) + ")");
+    }
+}
+
+std::string SolutionCache::entry_path(const std::string& key, const char* extension) const {
+    return directory_ + "/" + key + extension;
+}
+
+SolutionCache::Lookup SolutionCache::lookup(const std::string& spot, const Json::Value& params) {
+    CFRConfig config = parse_solver_config(params["solver_config"]);
+    Lookup lookup;
+    lookup.key = hex_key(fnv1a_64(spot));
+    std::string strategy_path = entry_path(lookup.key, ".strat");
+    if (::access(strategy_path.c_str(), R_OK) != 0) {
+        return lookup;
+    }
+
+    Json::Value metadata;
+    int iterations = 0;
+    try {
+        StrategyFile file(strategy_path);
+        std::string_view text = file.metadata();
+        Json::CharReaderBuilder builder;
+        std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+        std::string errors;
+        if (!reader->parse(text.data(), text.data() + text.size(), &metadata, &errors)) {
+            throw std::runtime_error("métadonnées illisibles");
+        }
+        iterations = static_cast<int>(file.header().iteration);
+    } catch (const std::exception& e) {
+        std::cerr << "Avertissement: Entrée de cache ignorée (" << strategy_path << "): " << e.what() << std::endl;
+        return lookup;
+    }
+    // Collision de hash: la forme canonique complète fait foi
+    if (metadata["canonical_spot"].asString() != spot) {
+        return lookup;
+    }
+
+    const Json::Value& result = metadata["result"]["result"];
+    bool converged = result["converged"].asBool() &&
+                     result["final_exploitability"].asDouble() <= config.target_exploitability;
+    std::string checkpoint_path = entry_path(lookup.key, ".ckpt");
+    lookup.iterations = iterations;
+    if (iterations >= config.max_iterations || converged) {
+        lookup.status = Status::HIT;
+        lookup.result = metadata["result"];
+        lookup.result["result"]["metadata"]["solver_config"] = params["solver_config"];
+        lookup.result["result"]["metadata"]["game_config"] = params["game_config"];
+    } else if (metadata["game_config"] == params["game_config"] &&
+               ::access(checkpoint_path.c_str(), R_OK) == 0) {
+        // Les clés du checkpoint portent le tableau réel: pas de reprise
+        // depuis un spot seulement isomorphe
+        lookup.status = Status::WARM;
+        lookup.checkpoint_path = checkpoint_path;
+        touch(checkpoint_path);
+    } else {
+        return lookup;
+    }
+    touch(strategy_path);
+    return lookup;
+}
+
+void SolutionCache::store(const std::string& spot, const CFRSolver& solver, const std::string& task_type,
+                          const Json::Value& params, const Json::Value& result) {
+    std::string key = hex_key(fnv1a_64(spot));
+    try {
+        // Checkpoint d'abord: l'export rend l'entrée visible
+        solver.write_checkpoint(entry_path(key, ".ckpt"));
+
+        Json::Value metadata;
+        metadata["canonical_spot"] = spot;
+        metadata["task_type"] = task_type;
+        metadata["solver_config"] = params["solver_config"];
+        metadata["game_config"] = params["game_config"];
+        metadata["result"] = result;
+        StrategyExportOptions options;
+        options.value_bits = 16;
+        options.metadata = write_compact(metadata);
+        write_strategy_file(solver, entry_path(key, ".strat"), options);
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur: Mise en cache de la solution impossible: " << e.what() << std::endl;
+        return;
+    }
+    evict(key);
+}
+
+void SolutionCache::evict(const std::string& keep) {
+    std::lock_guard<std::mutex> lock(evict_mutex_);
+    struct Entry {
+        std::string key;
+        uint64_t bytes = 0;
+        struct timespec used = {0, 0};
+    };
+    std::vector<Entry> entries;
+
+    DIR* dir = ::opendir(directory_.c_str());
+    if (!dir) {
+        return;
+    }
+    while (struct dirent* item = ::readdir(dir)) {
+        std::string name = item->d_name;
+        size_t extension = has_suffix(name, ".strat") ? 6 : has_suffix(name, ".ckpt") ? 5 : 0;
+        struct stat st;
+        if (extension == 0 || ::stat((directory_ + "/" + name).c_str(), &st) != 0) {
+            continue;
+        }
+        std::string key = name.substr(0, name.size() - extension);
+        auto it = std::find_if(entries.begin(), entries.end(), [&](const Entry& e) { return e.key == key; });
+        if (it == entries.end()) {
+            entries.push_back({key, 0, {0, 0}});
+            it = entries.end() - 1;
+        }
+        it->bytes += static_cast<uint64_t>(st.st_size);
+        if (st.st_mtim.tv_sec > it->used.tv_sec ||
+            (st.st_mtim.tv_sec == it->used.tv_sec && st.st_mtim.tv_nsec > it->used.tv_nsec)) {
+            it->used = st.st_mtim;
+        }
+    }
+    ::closedir(dir);
+
+    uint64_t total = std::accumulate(entries.begin(), entries.end(), uint64_t(0),
+                                     [](uint64_t sum, const Entry& e) { return sum + e.bytes; });
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.used.tv_sec != b.used.tv_sec ? a.used.tv_sec < b.used.tv_sec : a.used.tv_nsec < b.used.tv_nsec;
+    });
+    // L'entrée qui vient d'être écrite reste, même seule au-delà du budget
+    for (const Entry& entry : entries) {
+        if (total <= max_bytes_) {
+            break;
+        }
+        if (entry.key == keep) {
+            continue;
+        }
+        ::unlink(entry_path(entry.key, ".strat").c_str());
+        ::unlink(entry_path(entry.key, ".ckpt").c_str());
+        total -= entry.bytes;
+    }
+}
+
+const char* solution_cache_status_name(SolutionCache::Status status) {
+    switch (status) {
+        case SolutionCache::Status::MISS: return "miss";
+        case SolutionCache::Status::HIT: return "hit";
+        case SolutionCache::Status::WARM: return "warm";
+    }
+    return "miss";
+}
+
+} // namespace poker
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "cfr_solver.h"
+#include <json/json.h>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace poker {
+
+// Forme canonique d'une tâche: deux spots de même forme ont la même
+// solution. Réunit task_type, game_config (membres triés, tableau et
+// combinaisons explicites des ranges ramenés à une représentation unique
+// par isomorphisme de couleurs, flop non ordonné) et les paramètres de
+// solver_config qui changent les regrets (ceux de CFRConfig::hash). Les
+// critères d'arrêt n'en font pas partie.
+std::string canonical_spot(const std::string& task_type, const Json::Value& params);
+
+// Cache de solutions sur disque, adressé par le contenu (fnv1a_64 de
+// canonical_spot). Une entrée est un export de stratégie (<clé>.strat, voir
+// strategy_file.h; ses métadonnées portent la forme canonique et le document
+// de résultat) et un checkpoint (<clé>.ckpt) pour la reprise à chaud.
+// Les fichiers sont écrits puis renommés: plusieurs processus peuvent
+// partager le répertoire. Au-delà de max_bytes, les entrées les moins
+// récemment utilisées (date de modification, rafraîchie à chaque usage)
+// sont supprimées.
+class SolutionCache {
+public:
+    // Crée directory au besoin; lève std::runtime_error en cas d'échec
+    SolutionCache(const std::string& directory, uint64_t max_bytes);
+
+    enum class Status {
+        MISS,
+        HIT,   // Solution assez itérée (ou convergée): résultat rendu tel quel
+        WARM   // Moins d'itérations que demandé: reprise depuis le checkpoint
+    };
+
+    struct Lookup {
+        Status status = Status::MISS;
+        std::string key;              // Nom des fichiers de l'entrée
+        int iterations = 0;           // Itérations de la solution en cache
+        Json::Value result;           // HIT: document de résultat enregistré
+        std::string checkpoint_path;  // WARM
+    };
+
+    // Entrée de spot (canonical_spot) pour la tâche params. Le résultat d'un
+    // HIT reprend la configuration de params; la reprise (WARM) exige un
+    // game_config identique à celui de l'entrée, isomorphe ne suffit pas.
+    Lookup lookup(const std::string& spot, const Json::Value& params);
+
+    // Enregistre la solution de solver et son document de résultat
+    // (simulation_result_json, sans champs propres à l'appelant), puis
+    // applique le budget disque. Les erreurs sont signalées sur stderr: le
+    // cache ne fait jamais échouer une résolution.
+    void store(const std::string& spot, const CFRSolver& solver, const std::string& task_type,
+               const Json::Value& params, const Json::Value& result);
+
+private:
+    std::string directory_;
+    uint64_t max_bytes_;
+    std::mutex evict_mutex_;
+
+    std::string entry_path(const std::string& key, const char* extension) const;
+    void evict(const std::string& keep);
+};
+
+const char* solution_cache_status_name(SolutionCache::Status status);
+
+} // namespace poker
@@ -0,0 +1,405 @@
+#include "solve_job.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace poker {
+
+CFRConfig parse_solver_config(const Json::Value& config) {
+    CFRConfig cfr_config;
+    
+    if (config.isMember("max_iterations")) {
+        cfr_config.max_iterations = config["max_iterations"].asInt();
+    }
+    if (config.isMember("target_exploitability")) {
+        cfr_config.target_exploitability = config["target_exploitability"].asDouble();
+    }
+    if (config.isMember("use_chance_sampling")) {
+        cfr_config.use_chance_sampling = config["use_chance_sampling"].asBool();
+    }
+    if (config.isMember("use_discounting")) {
+        cfr_config.use_discounting = config["use_discounting"].asBool();
+    }
+    if (config.isMember("alpha")) {
+        cfr_config.alpha = config["alpha"].asDouble();
+    }
+    if (config.isMember("beta")) {
+        cfr_config.beta = config["beta"].asDouble();
+    }
+    if (config.isMember("checkpoint_frequency")) {
+        cfr_config.checkpoint_frequency = config["checkpoint_frequency"].asInt();
+    }
+    if (config.isMember("checkpoint_dir")) {
+        cfr_config.checkpoint_dir = config["checkpoint_dir"].asString();
+    }
+    if (config.isMember("async_checkpoints")) {
+        cfr_config.async_checkpoints = config["async_checkpoints"].asBool();
+    }
+    if (config.isMember("compact_checkpoints")) {
+        cfr_config.compact_checkpoints = config["compact_checkpoints"].asBool();
+    }
+    if (config.isMember("checkpoint_quantization_step")) {
+        cfr_config.checkpoint_quantization_step = config["checkpoint_quantization_step"].asDouble();
+    }
+    if (config.isMember("checkpoint_keyframe_interval")) {
+        cfr_config.checkpoint_keyframe_interval = config["checkpoint_keyframe_interval"].asInt();
+    }
+    if (config.isMember("infoset_storage_dir")) {
+        cfr_config.infoset_storage_dir = config["infoset_storage_dir"].asString();
+    }
+    if (config.isMember("infoset_resident_mb")) {
+        cfr_config.infoset_resident_mb = config["infoset_resident_mb"].asUInt64();
+    }
+    if (config.isMember("infoset_huge_pages")) {
+        cfr_config.infoset_huge_pages = config["infoset_huge_pages"].asBool();
+    }
+    if (config.isMember("memory_limit_mb")) {
+        cfr_config.memory_limit_mb = config["memory_limit_mb"].asUInt64();
+    }
+    if (config.isMember("profile_hardware_counters")) {
+        cfr_config.profile_hardware_counters = config["profile_hardware_counters"].asBool();
+    }
+    if (config.isMember("num_threads")) {
+        cfr_config.num_threads = config["num_threads"].asInt();
+    }
+    if (config.isMember("seed")) {
+        cfr_config.seed = config["seed"].asUInt64();
+    }
+    if (config.isMember("use_baselines")) {
+        cfr_config.use_baselines = config["use_baselines"].asBool();
+    }
+    if (config.isMember("baseline_learning_rate")) {
+        cfr_config.baseline_learning_rate = config["baseline_learning_rate"].asDouble();
+    }
+    if (config.isMember("memory_limit_policy")) {
+        std::string policy = config["memory_limit_policy"].asString();
+        if (policy == "fail") {
+            cfr_config.memory_limit_policy = MemoryLimitPolicy::FAIL;
+        } else if (policy == "spill") {
+            cfr_config.memory_limit_policy = MemoryLimitPolicy::SPILL;
+        } else if (policy == "sample") {
+            cfr_config.memory_limit_policy = MemoryLimitPolicy::SAMPLE;
+        } else {
+            throw std::runtime_error("memory_limit_policy inconnue: " + policy + " (attendu: fail, spill ou sample)");
+        }
+    }
+    
+    return cfr_config;
+}
+
+GameState parse_game_config(const Json::Value& config) {
+    // Les vecteurs par joueur (mains, couchés, investissements) doivent être
+    // dimensionnés dès la construction: apply_action les indexe directement
+    GameState state(config.isMember("num_players") ? config["num_players"].asInt() : 2);
+    
+    // Configuration par défaut
+    state.street = 0; // preflop
+    state.current_player = 0;
+    state.button_position = 1;
+    state.small_blind = 0.5;
+    state.big_blind = 1.0;
+    state.pot = 1.5; // SB + BB
+    
+    // Parser les paramètres depuis le JSON
+    if (config.isMember("small_blind")) {
+        state.small_blind = config["small_blind"].asDouble();
+    }
+    if (config.isMember("big_blind")) {
+        state.big_blind = config["big_blind"].asDouble();
+    }
+    if (config.isMember("stack_size")) {
+        double stack_size = config["stack_size"].asDouble();
+        state.stacks.assign(state.num_players, stack_size);
+    } else {
+        state.stacks.assign(state.num_players, 100.0); // 100 BB par défaut
+    }
+    
+    // Initialiser les mises (SB et BB déjà misés)
+    if (state.num_players >= 2) {
+        state.bets[0] = state.small_blind;  // Small blind
+        state.bets[1] = state.big_blind;    // Big blind
+        state.total_invested[0] = state.small_blind;
+        state.total_invested[1] = state.big_blind;
+        state.stacks[0] -= state.small_blind;
+        state.stacks[1] -= state.big_blind;
+    }
+    
+    // Tailles de mise autorisées (en % du pot)
+    state.allowed_bet_sizes = {0.33, 0.5, 0.75, 1.0}; // 33%, 50%, 75%, 100% pot
+    if (config.isMember("allowed_bet_sizes")) {
+        state.allowed_bet_sizes.clear();
+        for (const auto& size : config["allowed_bet_sizes"]) {
+            state.allowed_bet_sizes.push_back(size.asDouble());
+        }
+    }
+    
+    // Tableau imposé: le spot commence à la rue correspondante
+    if (config.isMember("board")) {
+        state.board = parse_board_config(config["board"]);
+        if (!state.board.empty()) {
+            state.street = static_cast<int>(state.board.size()) - 2;
+        }
+    }
+    
+    return state;
+}
+
+Board parse_board_config(const Json::Value& board) {
+    std::string text;
+    if (board.isArray()) {
+        for (const auto& card : board) {
+            text += card.asString() + " ";
+        }
+    } else {
+        text = board.asString();
+    }
+    
+    Board cards;
+    try {
+        cards = parse_cards(text);
+    } catch (const std::invalid_argument& e) {
+        throw std::runtime_error(std::string("Tableau invalide: ") + e.what());
+    }
+    if (!cards.empty() && (cards.size() < 3 || cards.size() > 5)) {
+        throw std::runtime_error("Tableau de 3 à 5 cartes attendu: " + text);
+    }
+    return cards;
+}
+
+Action parse_history_action(const std::string& token, const std::vector<Action>& actions) {
+    auto find_type = [&](ActionType type) -> const Action* {
+        for (const auto& action : actions) {
+            if (action.type == type) return &action;
+        }
+        return nullptr;
+    };
+    
+    const Action* match = nullptr;
+    char kind = static_cast<char>(std::tolower(static_cast<unsigned char>(token[0])));
+    if (token.size() == 1 && kind == 'f') {
+        match = find_type(ActionType::FOLD);
+    } else if (token.size() == 1 && (kind == 'x' || kind == 'k')) {
+        match = find_type(ActionType::CHECK);
+    } else if (token.size() == 1 && kind == 'c') {
+        match = find_type(ActionType::CALL);
+    } else if (kind == 'r' || kind == 'b' || kind == 'a') {
+        std::vector<const Action*> raises;
+        for (const auto& action : actions) {
+            if (action.type == ActionType::RAISE) raises.push_back(&action);
+        }
+        if (raises.empty()) {
+            throw std::runtime_error("Aucune relance possible pour '" + token + "'");
+        }
+        if (kind == 'a' && token.size() == 1) {
+            match = *std::max_element(raises.begin(), raises.end(),
+                                      [](const Action* a, const Action* b) { return a->amount < b->amount; });
+        } else if (token.size() == 1) {
+            if (raises.size() > 1) {
+                throw std::runtime_error("Relance ambiguë '" + token + "': préciser le montant");
+            }
+            match = raises[0];
+        } else {
+            size_t parsed = 0;
+            double amount = 0.0;
+            try {
+                amount = std::stod(token.substr(1), &parsed);
+            } catch (const std::exception&) {
+                parsed = 0;
+            }
+            if (kind == 'a' || parsed != token.size() - 1) {
+                throw std::runtime_error("Action invalide dans l'historique: " + token);
+            }
+            match = *std::min_element(raises.begin(), raises.end(), [amount](const Action* a, const Action* b) {
+                return std::abs(a->amount - amount) < std::abs(b->amount - amount);
+            });
+        }
+    } else {
+        throw std::runtime_error("Action invalide dans l'historique: " + token);
+    }
+    
+    if (!match) {
+        throw std::runtime_error("Action '" + token + "' impossible à ce point de l'historique");
+    }
+    return *match;
+}
+
+GameState apply_action_history(const GameState& root, const std::string& history,
+                               const GameAbstraction& abstraction) {
+    GameState state = root;
+    size_t pos = 0;
+    while (pos < history.size()) {
+        size_t end = history.find_first_of(" ,/\t", pos);
+        if (end == std::string::npos) end = history.size();
+        if (end > pos) {
+            std::string token = history.substr(pos, end - pos);
+            if (state.is_terminal()) {
+                throw std::runtime_error("Historique au-delà d'un état terminal: " + token);
+            }
+            state = state.apply_action(parse_history_action(token, abstraction.get_abstracted_actions(state)));
+        }
+        pos = end + 1;
+    }
+    return state;
+}
+
+std::vector<HandRange> parse_ranges_config(const Json::Value& ranges, int num_players) {
+    if (!ranges.isArray()) {
+        throw std::runtime_error("ranges: tableau d'une range par joueur attendu");
+    }
+    if (static_cast<int>(ranges.size()) > num_players) {
+        throw std::runtime_error("ranges: " + std::to_string(ranges.size()) + " ranges pour " +
+                                 std::to_string(num_players) + " joueurs");
+    }
+    std::vector<HandRange> parsed;
+    for (Json::ArrayIndex player = 0; player < ranges.size(); ++player) {
+        const Json::Value& range = ranges[player];
+        if (!range.isString()) {
+            throw std::runtime_error("ranges: chaîne attendue pour le joueur " + std::to_string(player));
+        }
+        try {
+            parsed.push_back(parse_hand_range(range.asString()));
+        } catch (const std::invalid_argument& e) {
+            throw std::runtime_error(std::string("Range invalide: ") + e.what());
+        }
+    }
+    return parsed;
+}
+
+std::unique_ptr<VanillaCFR> create_exhaustive_solver(const std::string& task_type,
+                                                     std::shared_ptr<GameAbstraction> abstraction,
+                                                     const CFRConfig& config, const Json::Value& game_config) {
+    if (task_type != "preflop" && task_type != "postflop") {
+        throw std::runtime_error("Type de tâche non supporté: " + task_type);
+    }
+    // Options sans effet sur un parcours exhaustif: refusées plutôt qu'ignorées
+    if (config.num_threads > 1) {
+        throw std::runtime_error("num_threads > 1 demande un solveur par échantillonnage (use_chance_sampling)");
+    }
+    if (config.seed != 0) {
+        throw std::runtime_error("seed demande un solveur par échantillonnage (use_chance_sampling)");
+    }
+    if (config.use_baselines) {
+        throw std::runtime_error("use_baselines demande un solveur par échantillonnage (use_chance_sampling)");
+    }
+    if (game_config.isObject() && game_config.isMember("ranges")) {
+        throw std::runtime_error("ranges demande un solveur par échantillonnage (use_chance_sampling)");
+    }
+    return std::make_unique<VanillaCFR>(abstraction, config);
+}
+
+std::unique_ptr<CFRSolver> create_task_solver(const std::string& task_type,
+                                              std::shared_ptr<GameAbstraction> abstraction,
+                                              const CFRConfig& config, const Json::Value& game_config) {
+    if (!config.use_chance_sampling) {
+        return create_exhaustive_solver(task_type, abstraction, config, game_config);
+    }
+    if (task_type != "preflop" && task_type != "postflop") {
+        throw std::runtime_error("Type de tâche non supporté: " + task_type);
+    }
+    auto solver = std::make_unique<ChanceSamplingCFR>(abstraction, config);
+    if (game_config.isObject() && game_config.isMember("ranges")) {
+        int num_players = game_config.isMember("num_players") ? game_config["num_players"].asInt() : 2;
+        solver->set_ranges(parse_ranges_config(game_config["ranges"], num_players));
+    }
+    return solver;
+}
+
+namespace {
+
+// Compteurs par phase; les rapports ne figurent que si leurs compteurs sont disponibles
+Json::Value hardware_profile_json(const HardwareProfile& profile) {
+    const char* counter_names[NUM_PERF_COUNTERS] = {"task_clock_ns", "cycles", "instructions",
+                                                    "cache_misses", "branch_misses"};
+    auto available = [&profile](PerfCounter counter) {
+        return profile.counter_available[static_cast<size_t>(counter)];
+    };
+
+    Json::Value output;
+    output["available"] = available(PerfCounter::CYCLES) && available(PerfCounter::INSTRUCTIONS);
+    if (!profile.error.empty()) {
+        output["error"] = profile.error;
+    }
+    output["nodes_visited"] = static_cast<Json::UInt64>(profile.nodes_visited);
+    double nodes = static_cast<double>(std::max<uint64_t>(profile.nodes_visited, 1));
+
+    for (size_t p = 0; p < NUM_PROFILE_PHASES; ++p) {
+        ProfilePhase phase = static_cast<ProfilePhase>(p);
+        Json::Value phase_json;
+        for (size_t c = 0; c < NUM_PERF_COUNTERS; ++c) {
+            if (profile.counter_available[c]) {
+                phase_json[counter_names[c]] = static_cast<Json::UInt64>(profile.phases[p][c]);
+            }
+        }
+        uint64_t cycles = profile.value(phase, PerfCounter::CYCLES);
+        if (available(PerfCounter::INSTRUCTIONS) && cycles > 0) {
+            phase_json["ipc"] = static_cast<double>(profile.value(phase, PerfCounter::INSTRUCTIONS)) / cycles;
+        }
+        if (available(PerfCounter::CACHE_MISSES)) {
+            phase_json["cache_misses_per_node"] = profile.value(phase, PerfCounter::CACHE_MISSES) / nodes;
+        }
+        if (available(PerfCounter::BRANCH_MISSES)) {
+            phase_json["branch_misses_per_node"] = profile.value(phase, PerfCounter::BRANCH_MISSES) / nodes;
+        }
+        output["phases"][profile_phase_name(phase)] = phase_json;
+    }
+    return output;
+}
+
+} // namespace
+
+Json::Value simulation_result_json(const std::string& task_type, const Json::Value& params,
+                                   const CFRResult& result, const std::vector<double>& strategy) {
+    Json::Value output;
+    output["success"] = true;
+    output["task_type"] = task_type;
+    output["result"] = Json::Value();
+    output["result"]["iterations_completed"] = result.iterations_completed;
+    output["result"]["final_exploitability"] = result.final_exploitability;
+    output["result"]["convergence_time"] = result.convergence_time_seconds;
+    output["result"]["converged"] = result.converged;
+    output["result"]["status"] = result.status_message;
+    output["result"]["memory"]["infosets"] = static_cast<Json::UInt64>(result.num_infosets);
+    output["result"]["memory"]["infoset_bytes"] = static_cast<Json::UInt64>(result.infoset_memory_bytes);
+    output["result"]["memory"]["huge_page_bytes"] = static_cast<Json::UInt64>(result.huge_page_bytes);
+    output["result"]["memory"]["huge_pages"] = result.huge_page_bytes > 0;
+    if (result.hardware_profile.enabled) {
+        output["result"]["hardware_counters"] = hardware_profile_json(result.hardware_profile);
+    }
+    
+    // Ajouter la stratégie
+    Json::Value strategy_json(Json::arrayValue);
+    for (size_t i = 0; i < strategy.size(); ++i) {
+        strategy_json.append(strategy[i]);
+    }
+    output["result"]["strategy"]["player_0"] = strategy_json;
+    
+    // Ajouter les métadonnées
+    output["result"]["metadata"]["solver_config"] = params["solver_config"];
+    output["result"]["metadata"]["game_config"] = params["game_config"];
+    
+    return output;
+}
+
+Json::Value simulation_error_json(const std::string& message) {
+    Json::Value error_output;
+    error_output["success"] = false;
+    error_output["error"] = message;
+    return error_output;
+}
+
+int detach_stdout() {
+    std::cout.flush();
+    int out_fd = ::dup(STDOUT_FILENO);
+    if (out_fd < 0 || ::dup2(STDERR_FILENO, STDOUT_FILENO) < 0) {
+        throw std::runtime_error(std::string("Redirection de la sortie standard impossible (") +
+                                 std::strerror(errno) + ")");
+    }
+    return out_fd;
+}
+
+} // namespace poker
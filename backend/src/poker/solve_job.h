@@ -0,0 +1,74 @@
+#pragma once
+
+#include "cfr_solver.h"
+#include "deal_sampler.h"
+#include "game_tree.h"
+#include <json/json.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace poker {
+
+// Tâche de résolution décrite par un document de paramètres
+// ({"solver_config": {...}, "game_config": {...}}), commun au mode ligne de
+// commande (--params-file) et au démon (--serve)
+
+// Lève std::runtime_error pour une memory_limit_policy inconnue
+CFRConfig parse_solver_config(const Json::Value& config);
+GameState parse_game_config(const Json::Value& config);
+
+// Tableau de game_config: "As Kd 7h" ou ["As", "Kd", "7h"], 0 ou 3 à 5
+// cartes distinctes. Lève std::runtime_error sinon.
+Board parse_board_config(const Json::Value& board);
+
+// Action de actions désignée par un jeton d'historique: f (fold), x ou k
+// (check), c (call), r<montant> ou b<montant> (relance de <montant> jetons,
+// ramenée à la taille abstraite la plus proche), r seul quand une seule
+// taille existe et a (plus grande relance). Lève std::runtime_error si
+// l'action n'existe pas parmi actions.
+Action parse_history_action(const std::string& token, const std::vector<Action>& actions);
+
+// État atteint depuis root par un historique d'actions (jetons de
+// parse_history_action séparés par des espaces, des virgules ou des '/').
+// Lève std::runtime_error si une action n'existe pas dans l'abstraction ou
+// si l'historique dépasse un état terminal.
+GameState apply_action_history(const GameState& root, const std::string& history,
+                               const GameAbstraction& abstraction);
+
+// Ranges de game_config: une par joueur, en notation de parse_hand_range
+// (["AA,KK,AKs", "QQ+,AQ+:0.5"]); joueur absent ou chaîne vide: toutes les
+// mains. Lève std::runtime_error si la forme ou une range est invalide.
+std::vector<HandRange> parse_ranges_config(const Json::Value& ranges, int num_players);
+
+// Solveur d'un type de tâche ("preflop" ou "postflop"): MCCFR
+// (ChanceSamplingCFR, avec les ranges de game_config) si
+// use_chance_sampling, VanillaCFR sinon. Lève std::runtime_error pour un
+// type inconnu ou des options sans effet sur le solveur choisi.
+std::unique_ptr<CFRSolver> create_task_solver(const std::string& task_type,
+                                              std::shared_ptr<GameAbstraction> abstraction,
+                                              const CFRConfig& config,
+                                              const Json::Value& game_config = Json::Value());
+
+// VanillaCFR d'un type de tâche quel que soit use_chance_sampling (mode
+// distribué); lève std::runtime_error pour un type inconnu ou une option
+// réservée aux solveurs par échantillonnage (num_threads > 1, seed,
+// use_baselines, ranges)
+std::unique_ptr<VanillaCFR> create_exhaustive_solver(const std::string& task_type,
+                                                     std::shared_ptr<GameAbstraction> abstraction,
+                                                     const CFRConfig& config,
+                                                     const Json::Value& game_config = Json::Value());
+
+// Document de résultat de --output-format json
+Json::Value simulation_result_json(const std::string& task_type, const Json::Value& params,
+                                   const CFRResult& result, const std::vector<double>& strategy);
+
+// Document d'erreur de --output-format json
+Json::Value simulation_error_json(const std::string& message);
+
+// Réserve la sortie standard aux documents JSON: retourne un descripteur
+// vers la sortie d'origine et redirige stdout (messages du solveur) vers
+// stderr. Lève std::runtime_error en cas d'échec.
+int detach_stdout();
+
+} // namespace poker
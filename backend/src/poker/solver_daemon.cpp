@@ -0,0 +1,610 @@
+#include "solver_daemon.h"
+#include "solve_job.h"
+#include "socket_io.h"
+#include "strategy_diff.h"
+#include "metrics.h"
+#include "trace.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace poker {
+
+namespace {
+
+// Borne la mémoire allouée pour une trame reçue (paramètres d'une tâche)
+constexpr uint32_t MAX_FRAME_BYTES = 64u << 20;
+
+// Lit une trame; false en fin de flux. Lève std::runtime_error si la trame
+// annoncée est trop grande (le flux n'est alors plus synchronisé).
+bool read_frame(int fd, std::string& payload) {
+    unsigned char header[4];
+    if (!read_fully(fd, reinterpret_cast<char*>(header), sizeof(header))) {
+        return false;
+    }
+    uint32_t size = (uint32_t(header[0]) << 24) | (uint32_t(header[1]) << 16) |
+                    (uint32_t(header[2]) << 8) | uint32_t(header[3]);
+    if (size > MAX_FRAME_BYTES) {
+        throw std::runtime_error("Trame trop grande: " + std::to_string(size) + " octets");
+    }
+    payload.resize(size);
+    return read_fully(fd, payload.data(), size);
+}
+
+// Répertoire des checkpoints de la tâche job_id sous base (vide: courant)
+std::string job_checkpoint_dir(const std::string& base, const std::string& job_id) {
+    std::string directory = "job_" + job_id;
+    for (size_t i = 4; i < directory.size(); ++i) {
+        char c = directory[i];
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '.' && c != '_' && c != '-') {
+            directory[i] = '_';
+        }
+    }
+    return base.empty() ? directory : base + "/" + directory;
+}
+
+Json::Value message(const char* type, const std::string& job_id) {
+    Json::Value msg;
+    msg["type"] = type;
+    if (!job_id.empty()) {
+        msg["job_id"] = job_id;
+    }
+    return msg;
+}
+
+Json::Value error_message(const std::string& job_id, const std::string& error) {
+    Json::Value msg = message("error", job_id);
+    msg["error"] = error;
+    return msg;
+}
+
+// Spots identiques (arbre et paramètres de résolution), aux critères
+// d'arrêt près. jsoncpp écrit les membres triés: la clé est canonique.
+std::string tree_key(const std::string& task_type, const Json::Value& params) {
+    Json::Value solver_config = params["solver_config"];
+    if (solver_config.isObject()) {
+        solver_config.removeMember("max_iterations");
+        solver_config.removeMember("target_exploitability");
+    }
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return task_type + '\n' + Json::writeString(builder, params["game_config"]) + '\n' +
+           Json::writeString(builder, solver_config);
+}
+
+} // namespace
+
+SolverDaemon::Connection::~Connection() {
+    if (owns_fds) {
+        ::close(in_fd);
+        if (out_fd != in_fd) {
+            ::close(out_fd);
+        }
+    }
+}
+
+void SolverDaemon::Connection::send(const Json::Value& message) {
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    send(message, builder);
+}
+
+void SolverDaemon::Connection::send(const Json::Value& message, const Json::StreamWriterBuilder& writer) {
+    std::string payload = Json::writeString(writer, message);
+
+    uint32_t size = static_cast<uint32_t>(payload.size());
+    std::string frame(4, '\0');
+    frame[0] = static_cast<char>(size >> 24);
+    frame[1] = static_cast<char>(size >> 16);
+    frame[2] = static_cast<char>(size >> 8);
+    frame[3] = static_cast<char>(size);
+    frame += payload;
+
+    std::lock_guard<std::mutex> lock(write_mutex);
+    if (closed) {
+        return;
+    }
+    if (!write_fully(out_fd, frame.data(), frame.size())) {
+        closed = true;
+    }
+}
+
+SolverDaemon::SolverDaemon(const DaemonOptions& options)
+    : options_(options), abstraction_(std::make_shared<BasicAbstraction>()), closing_(false), listen_fd_(-1) {
+    options_.workers = std::max(1, options_.workers);
+    if (!options_.solution_cache_dir.empty()) {
+        try {
+            solution_cache_ = std::make_unique<SolutionCache>(options_.solution_cache_dir,
+                                                              uint64_t(options_.solution_cache_mb) << 20);
+        } catch (const std::exception& e) {
+            std::cerr << "Erreur: " << e.what() << " (cache de solutions désactivé)" << std::endl;
+        }
+    }
+}
+
+SolverDaemon::~SolverDaemon() {
+    shutdown();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+    }
+}
+
+int SolverDaemon::run() {
+    // Un client qui se déconnecte ne doit pas tuer le démon à l'écriture suivante
+    std::signal(SIGPIPE, SIG_IGN);
+
+    for (int i = 0; i < options_.workers; ++i) {
+        workers_.emplace_back(&SolverDaemon::worker_loop, this, i);
+    }
+    int status = options_.socket_path.empty() ? serve_stdio() : serve_socket();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closing_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+    return status;
+}
+
+int SolverDaemon::serve_stdio() {
+    // Les trames partent sur une copie de stdout; stdout lui-même est
+    // redirigé vers stderr pour que les messages du solveur ne les corrompent pas
+    int out_fd = -1;
+    try {
+        out_fd = detach_stdout();
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur: " << e.what() << std::endl;
+        return 1;
+    }
+    auto connection = std::make_shared<Connection>(STDIN_FILENO, out_fd, false);
+    std::cerr << "Démon de résolution prêt sur stdin (" << options_.workers << " workers)" << std::endl;
+    serve_connection(connection);
+    // Fin de stdin: les tâches déjà reçues sont terminées avant de quitter (voir run)
+    return 0;
+}
+
+int SolverDaemon::serve_socket() {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (options_.socket_path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Erreur: Chemin de socket trop long: " << options_.socket_path << std::endl;
+        return 1;
+    }
+    std::strncpy(address.sun_path, options_.socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    ::unlink(options_.socket_path.c_str()); // Socket laissé par une exécution précédente
+    if (listen_fd_ < 0 || ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listen_fd_, 16) != 0) {
+        std::cerr << "Erreur: Impossible d'écouter sur " << options_.socket_path
+                  << " (" << std::strerror(errno) << ")" << std::endl;
+        return 1;
+    }
+    std::cerr << "Démon de résolution prêt sur " << options_.socket_path
+              << " (" << options_.workers << " workers)" << std::endl;
+
+    std::vector<std::thread> readers;
+    for (;;) {
+        int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break; // shutdown() a fermé l'écoute
+        }
+        auto connection = std::make_shared<Connection>(fd, fd, true);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closing_) {
+                break;
+            }
+            connections_.push_back(connection);
+        }
+        readers.emplace_back(&SolverDaemon::serve_connection, this, connection);
+    }
+
+    // Débloquer les lectures des clients encore connectés
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& connection : connections_) {
+            ::shutdown(connection->in_fd, SHUT_RD);
+        }
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    ::unlink(options_.socket_path.c_str());
+    return 0;
+}
+
+void SolverDaemon::serve_connection(std::shared_ptr<Connection> connection) {
+    Json::CharReaderBuilder builder;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    std::string payload;
+
+    try {
+        while (read_frame(connection->in_fd, payload)) {
+            Json::Value request;
+            std::string errors;
+            if (!reader->parse(payload.data(), payload.data() + payload.size(), &request, &errors) ||
+                !request.isObject()) {
+                connection->send(error_message("", "Requête JSON invalide: " + errors));
+                continue;
+            }
+            if (!handle_request(connection, request)) {
+                break;
+            }
+        }
+    } catch (const std::exception& e) {
+        connection->send(error_message("", e.what()));
+    }
+
+    if (connection->owns_fds) {
+        // Client de socket parti: personne ne lira plus ses résultats
+        cancel_all(connection);
+        connection->closed = true;
+        std::lock_guard<std::mutex> lock(mutex_);
+        connections_.erase(std::remove(connections_.begin(), connections_.end(), connection), connections_.end());
+    }
+}
+
+bool SolverDaemon::handle_request(const std::shared_ptr<Connection>& connection, const Json::Value& request) {
+    std::string type = request.get("type", "").asString();
+    if (type == "solve") {
+        submit(connection, request);
+    } else if (type == "cancel") {
+        cancel(connection, request.get("job_id", "").asString());
+    } else if (type == "query") {
+        query(connection, request);
+    } else if (type == "ping") {
+        Json::Value pong = message("pong", "");
+        std::lock_guard<std::mutex> lock(mutex_);
+        pong["queued"] = static_cast<Json::UInt64>(queue_.size());
+        pong["running"] = static_cast<Json::UInt64>(running_.size());
+        pong["cached_trees"] = static_cast<Json::UInt64>(cache_.size());
+        connection->send(pong);
+    } else if (type == "metrics") {
+        Json::Value response = message("metrics", "");
+        response["content_type"] = "text/plain; version=0.0.4";
+        response["text"] = metrics::prometheus_text();
+        connection->send(response);
+    } else if (type == "shutdown") {
+        shutdown();
+        return false;
+    } else {
+        connection->send(error_message(request.get("job_id", "").asString(), "Type de requête inconnu: " + type));
+    }
+    return true;
+}
+
+void SolverDaemon::submit(const std::shared_ptr<Connection>& connection, const Json::Value& request) {
+    auto job = std::make_shared<Job>();
+    job->id = request.get("job_id", "").asString();
+    job->task_type = request.get("task_type", "").asString();
+    job->params = request["params"];
+    job->warm_start = request.get("warm_start", false).asBool();
+    if (request.isMember("strategy_diff")) {
+        const Json::Value& diff = request["strategy_diff"];
+        job->strategy_diff_every = std::max(1, diff.get("every", 100).asInt());
+        job->strategy_diff_threshold = diff.get("threshold", job->strategy_diff_threshold).asDouble();
+    }
+    job->connection = connection;
+
+    if (job->id.empty()) {
+        connection->send(error_message("", "job_id manquant"));
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto same_id = [&](const std::shared_ptr<Job>& other) { return other->id == job->id; };
+        if (closing_) {
+            connection->send(error_message(job->id, "Démon en cours d'arrêt"));
+            return;
+        }
+        if (std::any_of(queue_.begin(), queue_.end(), same_id) ||
+            std::any_of(running_.begin(), running_.end(), same_id)) {
+            connection->send(error_message(job->id, "Tâche déjà en cours: " + job->id));
+            return;
+        }
+        queue_.push_back(job);
+        // Sous le verrou: accepted précède tout message d'un worker
+        connection->send(message("accepted", job->id));
+    }
+    cv_.notify_one();
+}
+
+void SolverDaemon::cancel(const std::shared_ptr<Connection>& connection, const std::string& job_id) {
+    std::shared_ptr<Job> dequeued;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto same_id = [&](const std::shared_ptr<Job>& job) { return job->id == job_id; };
+        auto queued = std::find_if(queue_.begin(), queue_.end(), same_id);
+        if (queued != queue_.end()) {
+            dequeued = *queued;
+            queue_.erase(queued);
+        } else {
+            auto running = std::find_if(running_.begin(), running_.end(), same_id);
+            if (running == running_.end()) {
+                connection->send(error_message(job_id, "Tâche inconnue: " + job_id));
+                return;
+            }
+            // Le worker répond cancelled à la fin de l'itération en cours
+            (*running)->cancelled = true;
+            if ((*running)->solver) {
+                (*running)->solver->request_stop();
+            }
+            return;
+        }
+    }
+    dequeued->connection->send(message("cancelled", dequeued->id));
+}
+
+void SolverDaemon::cancel_all(const std::shared_ptr<Connection>& connection) {
+    std::vector<std::shared_ptr<Job>> dequeued;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto matches = [&](const std::shared_ptr<Job>& job) { return !connection || job->connection == connection; };
+        for (auto it = queue_.begin(); it != queue_.end();) {
+            if (matches(*it)) {
+                dequeued.push_back(*it);
+                it = queue_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        for (auto& job : running_) {
+            if (matches(job)) {
+                job->cancelled = true;
+                if (job->solver) {
+                    job->solver->request_stop();
+                }
+            }
+        }
+    }
+    for (auto& job : dequeued) {
+        job->connection->send(message("cancelled", job->id));
+    }
+}
+
+void SolverDaemon::shutdown() {
+    cancel_all(nullptr);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closing_ = true;
+        if (listen_fd_ >= 0) {
+            // Réveille accept() dans serve_socket
+            ::shutdown(listen_fd_, SHUT_RDWR);
+        }
+    }
+    cv_.notify_all();
+}
+
+void SolverDaemon::query(const std::shared_ptr<Connection>& connection, const Json::Value& request) {
+    std::string job_id = request.get("job_id", "").asString();
+    try {
+        std::shared_ptr<const StrategyStore> store = strategy_store(request.get("strategy_file", "").asString());
+        Json::Value response = strategy_answer_json(store->query(parse_strategy_query(request)));
+        response["type"] = "strategy";
+        if (!job_id.empty()) {
+            response["job_id"] = job_id;
+        }
+        connection->send(response);
+    } catch (const std::exception& e) {
+        connection->send(error_message(job_id, e.what()));
+    }
+}
+
+std::shared_ptr<const StrategyStore> SolverDaemon::strategy_store(const std::string& path) {
+    struct stat st;
+    if (path.empty() || ::stat(path.c_str(), &st) != 0) {
+        throw std::runtime_error("Fichier de stratégie introuvable: " + path);
+    }
+    std::lock_guard<std::mutex> lock(stores_mutex_);
+    auto it = stores_.find(path);
+    if (it != stores_.end() && it->second.device == st.st_dev && it->second.inode == st.st_ino &&
+        it->second.modified.tv_sec == st.st_mtim.tv_sec && it->second.modified.tv_nsec == st.st_mtim.tv_nsec) {
+        return it->second.store;
+    }
+    // Les requêtes en cours sur l'ancienne version gardent leur mapping
+    OpenStore opened{std::make_shared<const StrategyStore>(path), st.st_dev, st.st_ino, st.st_mtim};
+    stores_[path] = opened;
+    return opened.store;
+}
+
+void SolverDaemon::worker_loop(int index) {
+    trace::set_thread_name("worker " + std::to_string(index));
+    for (;;) {
+        std::shared_ptr<Job> job;
+        {
+            // Attente d'une tâche: intervalle "idle" de la chronologie
+            trace::Span idle_span("idle", "daemon");
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return closing_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;
+            }
+            job = queue_.front();
+            queue_.pop_front();
+            running_.push_back(job);
+        }
+
+        execute(*job);
+
+        if (!options_.metrics_file.empty()) {
+            try {
+                metrics::write_prometheus_file(options_.metrics_file);
+            } catch (const std::exception& e) {
+                std::cerr << "Erreur: " << e.what() << std::endl;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_.erase(std::remove(running_.begin(), running_.end(), job), running_.end());
+    }
+}
+
+void SolverDaemon::execute(Job& job) {
+    trace::Span job_span("job", "daemon");
+    std::string key;
+    std::unique_ptr<CFRSolver> solver;
+    try {
+        CFRConfig config = parse_solver_config(job.params["solver_config"]);
+        config.checkpoint_dir = job_checkpoint_dir(config.checkpoint_dir, job.id);
+        GameState initial_state = parse_game_config(job.params["game_config"]);
+
+        std::string spot;
+        SolutionCache::Lookup cached;
+        if (solution_cache_) {
+            spot = canonical_spot(job.task_type, job.params);
+            cached = solution_cache_->lookup(spot, job.params);
+            if (cached.status == SolutionCache::Status::HIT) {
+                Json::Value output = cached.result;
+                output["type"] = "result";
+                output["job_id"] = job.id;
+                output["tree_reused"] = false;
+                output["solution_cache"] = solution_cache_status_name(cached.status);
+                job.connection->send(output);
+                return;
+            }
+        }
+
+        key = tree_key(job.task_type, job.params);
+        solver = checkout_tree(key);
+        bool tree_reused = solver != nullptr;
+        if (!solver) {
+            solver = create_task_solver(job.task_type, abstraction_, config, job.params["game_config"]);
+        } else {
+            // Arbre créé par une autre tâche: checkpoints dans le répertoire de celle-ci
+            solver->set_checkpoint_dir(config.checkpoint_dir);
+            if (job.warm_start) {
+                // L'arbre d'une tâche annulée revient au cache avec sa demande d'arrêt
+                solver->clear_stop_request();
+                solver->set_stopping_criteria(solver->current_iteration() + config.max_iterations,
+                                              config.target_exploitability);
+            } else {
+                solver->reset_values();
+                solver->set_stopping_criteria(config.max_iterations, config.target_exploitability);
+            }
+        }
+        // Les regrets d'un arbre repris (warm_start) priment sur le cache disque
+        if (cached.status == SolutionCache::Status::WARM && !(tree_reused && job.warm_start)) {
+            solver->load_checkpoint(cached.checkpoint_path);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (job.cancelled) {
+                solver->request_stop();
+            }
+            job.solver = solver.get();
+        }
+
+        auto connection = job.connection;
+        std::string job_id = job.id;
+        solver->set_progress_callback([connection, job_id](int iteration, double exploitability) {
+            Json::Value progress = message("progress", job_id);
+            progress["iteration"] = iteration;
+            progress["exploitability"] = exploitability;
+            connection->send(progress);
+        });
+        if (job.strategy_diff_every > 0) {
+            auto tracker = std::make_shared<StrategyDiffTracker>(job.strategy_diff_threshold);
+            const CFRSolver* diff_solver = solver.get();
+            solver->set_iteration_callback(job.strategy_diff_every,
+                                           [connection, job_id, tracker, diff_solver](int iteration) {
+                Json::Value frame = tracker->diff(*diff_solver, iteration);
+                if (!frame.isNull()) {
+                    frame["job_id"] = job_id;
+                    connection->send(frame, strategy_diff_writer());
+                }
+            });
+        }
+
+        CFRResult result = solver->solve(initial_state);
+        bool stopped = solver->stop_requested();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job.solver = nullptr;
+        }
+        solver->set_progress_callback(nullptr);
+        solver->set_iteration_callback(0, nullptr);
+
+        if (stopped) {
+            job.connection->send(message("cancelled", job.id));
+        } else {
+            std::vector<double> strategy = solver->get_strategy(initial_state, 0);
+            Json::Value output = simulation_result_json(job.task_type, job.params, result, strategy);
+            if (solution_cache_) {
+                solution_cache_->store(spot, *solver, job.task_type, job.params, output);
+                output["solution_cache"] = solution_cache_status_name(cached.status);
+            }
+            output["type"] = "result";
+            output["job_id"] = job.id;
+            output["tree_reused"] = tree_reused;
+            job.connection->send(output);
+        }
+        return_tree(key, std::move(solver));
+    } catch (const std::exception& e) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job.solver = nullptr;
+        }
+        // L'arbre d'un solveur interrompu par une exception n'est pas réutilisé
+        job.connection->send(error_message(job.id, e.what()));
+    }
+}
+
+std::unique_ptr<CFRSolver> SolverDaemon::checkout_tree(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+        if (it->key == key) {
+            std::unique_ptr<CFRSolver> solver = std::move(it->solver);
+            cache_.erase(it);
+            return solver;
+        }
+    }
+    return nullptr;
+}
+
+void SolverDaemon::return_tree(const std::string& key, std::unique_ptr<CFRSolver> solver) {
+    std::unique_ptr<CFRSolver> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (options_.cached_trees == 0) {
+            evicted = std::move(solver);
+        } else {
+            // Deux tâches simultanées sur un même spot construisent chacune un arbre
+            auto same_key = std::find_if(cache_.begin(), cache_.end(),
+                                         [&](const CachedTree& tree) { return tree.key == key; });
+            if (same_key != cache_.end()) {
+                evicted = std::move(same_key->solver);
+                cache_.erase(same_key);
+            }
+            cache_.push_front(CachedTree{key, std::move(solver)});
+            if (!evicted && cache_.size() > options_.cached_trees) {
+                evicted = std::move(cache_.back().solver);
+                cache_.pop_back();
+            }
+        }
+    }
+    // La libération d'un grand arbre se fait hors du verrou
+}
+
+} // namespace poker
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "cfr_solver.h"
+#include "solution_cache.h"
+#include "strategy_store.h"
+#include <json/json.h>
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+
+namespace poker {
+
+// Démon de résolution (--serve). Un seul processus traite les tâches
+// successives: l'abstraction (tables de buckets) est construite une fois et
+// les arbres des derniers spots résolus restent en mémoire, de sorte qu'une
+// tâche sur un spot déjà vu ne reconstruit ni nœuds ni clés.
+//
+// Transport: stdin/stdout, ou un socket Unix (plusieurs clients). Dans les
+// deux sens, chaque message est une trame: longueur uint32 big-endian puis
+// document JSON UTF-8. En mode stdin, la sortie standard est réservée aux
+// trames (les messages du solveur passent sur stderr).
+//
+// Requêtes:
+//   {"type": "solve", "job_id": "...", "task_type": "preflop",
+//    "params": {"solver_config": {...}, "game_config": {...}},
+//    "warm_start": false,
+//    "strategy_diff": {"every": 100, "threshold": 0.01}}   // optionnel
+//   {"type": "cancel", "job_id": "..."}
+//   {"type": "query", "job_id": "...", "strategy_file": "/chemin/spot.strat",
+//    "history": "x r12", "hand": "AhQc", "board": "As Kd 7h 4c 2s",
+//    "translation": "blend"}
+//   {"type": "ping"}
+//   {"type": "metrics"}
+//   {"type": "shutdown"}
+//
+// Réponses, dans l'ordre pour une tâche:
+//   {"type": "accepted", "job_id": ...}
+//   {"type": "progress", "job_id": ..., "iteration": n, "exploitability": x}
+//   {"type": "strategy_diff", "job_id": ..., ...} toutes les "every" itérations
+//       si strategy_diff est demandé et qu'un infoset a changé (strategy_diff.h)
+//   {"type": "result", "job_id": ..., "tree_reused": bool, ...} (document de
+//       --output-format json), ou {"type": "cancelled"} ou {"type": "error"}
+// query répond aussitôt, sans passer par la file des tâches, par
+// {"type": "strategy", "job_id": ..., "player", "key", "actions", "strategy"}
+// (voir strategy_store.h); le fichier reste mappé entre les requêtes et
+// n'est rouvert que s'il a été remplacé.
+// ping répond {"type": "pong"} avec l'état des files; metrics répond
+// {"type": "metrics", "content_type": "text/plain; version=0.0.4", "text": ...}
+// avec les compteurs du processus au format Prometheus (voir metrics.h).
+//
+// warm_start reprend les regrets de l'arbre en cache (max_iterations
+// itérations de plus); sinon l'arbre est réutilisé avec des valeurs remises
+// à zéro et le résultat est celui d'une résolution à froid.
+//
+// Les checkpoints d'une tâche (périodiques, de limite mémoire) sont écrits
+// dans "job_<job_id>" sous solver_config.checkpoint_dir (répertoire courant
+// par défaut), caractères hors [A-Za-z0-9._-] remplacés par '_': des tâches
+// parallèles (workers > 1) n'écrivent jamais le même fichier.
+//
+// Avec solution_cache_dir, un spot déjà résolu (à l'isomorphisme de
+// couleurs près) assez longtemps est rendu sans résolution, et un spot
+// identique moins itéré reprend depuis le checkpoint du cache; le résultat
+// porte "solution_cache": "hit", "warm" ou "miss".
+struct DaemonOptions {
+    std::string socket_path;   // Vide: stdin/stdout
+    int workers = 1;           // Tâches résolues en parallèle
+    size_t cached_trees = 4;   // Arbres conservés entre les tâches (LRU)
+    std::string metrics_file;  // Non vide: métriques Prometheus réécrites après chaque tâche
+    std::string solution_cache_dir;   // Non vide: cache de solutions sur disque (solution_cache.h)
+    size_t solution_cache_mb = 1024;  // Budget disque du cache
+};
+
+class SolverDaemon {
+public:
+    explicit SolverDaemon(const DaemonOptions& options);
+    ~SolverDaemon();
+
+    SolverDaemon(const SolverDaemon&) = delete;
+    SolverDaemon& operator=(const SolverDaemon&) = delete;
+
+    // Sert jusqu'à une requête shutdown (ou la fin de stdin, après les tâches
+    // en cours). Retourne le code de sortie du processus.
+    int run();
+
+private:
+    // Extrémité d'un client; les réponses peuvent venir de plusieurs threads
+    struct Connection {
+        int in_fd;
+        int out_fd;
+        bool owns_fds;
+        std::mutex write_mutex;
+        std::atomic<bool> closed{false};
+
+        Connection(int in, int out, bool owns) : in_fd(in), out_fd(out), owns_fds(owns) {}
+        ~Connection();
+        void send(const Json::Value& message);
+        void send(const Json::Value& message, const Json::StreamWriterBuilder& writer);
+    };
+
+    struct Job {
+        std::string id;
+        std::string task_type;
+        Json::Value params;
+        bool warm_start = false;
+        int strategy_diff_every = 0; // 0: pas de trames strategy_diff
+        double strategy_diff_threshold = 0.01;
+        std::shared_ptr<Connection> connection;
+        bool cancelled = false;      // Protégés par mutex_
+        CFRSolver* solver = nullptr; // Solveur en cours d'exécution
+    };
+
+    struct CachedTree {
+        std::string key;
+        std::unique_ptr<CFRSolver> solver;
+    };
+
+    // Solution mappée; inode et date identifient la version du fichier
+    struct OpenStore {
+        std::shared_ptr<const StrategyStore> store;
+        dev_t device;
+        ino_t inode;
+        struct timespec modified;
+    };
+
+    DaemonOptions options_;
+    std::shared_ptr<GameAbstraction> abstraction_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::shared_ptr<Job>> queue_;
+    std::vector<std::shared_ptr<Job>> running_;
+    std::list<CachedTree> cache_;    // Le plus récemment utilisé en tête
+    bool closing_;                   // Plus de nouvelles tâches
+    int listen_fd_;
+    std::vector<std::shared_ptr<Connection>> connections_;
+    std::vector<std::thread> workers_;
+    std::unique_ptr<SolutionCache> solution_cache_;
+    std::mutex stores_mutex_;
+    std::map<std::string, OpenStore> stores_;  // Par chemin de fichier de stratégie
+
+    int serve_stdio();
+    int serve_socket();
+    void serve_connection(std::shared_ptr<Connection> connection);
+
+    // false si la requête demande l'arrêt du démon
+    bool handle_request(const std::shared_ptr<Connection>& connection, const Json::Value& request);
+    void submit(const std::shared_ptr<Connection>& connection, const Json::Value& request);
+    void cancel(const std::shared_ptr<Connection>& connection, const std::string& job_id);
+    void cancel_all(const std::shared_ptr<Connection>& connection);
+    void shutdown();
+    void query(const std::shared_ptr<Connection>& connection, const Json::Value& request);
+    std::shared_ptr<const StrategyStore> strategy_store(const std::string& path);
+
+    void worker_loop(int index);
+    void execute(Job& job);
+
+    // Arbre en cache pour key, retiré du cache pendant son utilisation
+    std::unique_ptr<CFRSolver> checkout_tree(const std::string& key);
+    void return_tree(const std::string& key, std::unique_ptr<CFRSolver> solver);
+};
+
+} // namespace poker
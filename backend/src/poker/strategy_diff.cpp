@@ -0,0 +1,51 @@
+#include "strategy_diff.h"
+#include <cmath>
+
+namespace poker {
+
+Json::Value StrategyDiffTracker::diff(const CFRSolver& solver, int iteration) {
+    Json::Value changed(Json::arrayValue);
+    size_t total = 0;
+
+    solver.for_each_infoset([&](const std::string& key, const GameNode& node) {
+        ++total;
+        std::vector<double> strategy = node.get_average_strategy();
+        std::vector<float>& sent = sent_[key];
+        bool moved = sent.size() != strategy.size();
+        for (size_t i = 0; !moved && i < strategy.size(); ++i) {
+            moved = std::fabs(static_cast<float>(strategy[i]) - sent[i]) > threshold_;
+        }
+        if (!moved) {
+            return;
+        }
+
+        sent.assign(strategy.begin(), strategy.end());
+        Json::Value entry;
+        entry["key"] = key;
+        entry["strategy"] = Json::Value(Json::arrayValue);
+        for (double probability : strategy) {
+            entry["strategy"].append(probability);
+        }
+        changed.append(std::move(entry));
+    });
+
+    if (changed.empty()) {
+        return Json::Value();
+    }
+    Json::Value frame;
+    frame["type"] = "strategy_diff";
+    frame["iteration"] = iteration;
+    frame["infosets"] = static_cast<Json::UInt64>(total);
+    frame["changed"] = std::move(changed);
+    return frame;
+}
+
+Json::StreamWriterBuilder strategy_diff_writer() {
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    builder["precision"] = 4;
+    builder["precisionType"] = "decimal";
+    return builder;
+}
+
+} // namespace poker
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "cfr_solver.h"
+#include <json/json.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace poker {
+
+// Deltas de stratégie pour l'affichage en direct: à chaque appel, seuls les
+// infosets dont la stratégie moyenne s'est écartée de plus de threshold
+// (sur au moins une action) de la dernière version envoyée sont émis.
+// La comparaison se fait avec la version envoyée, pas avec l'appel
+// précédent: une dérive lente finit par être transmise.
+//
+// Trame (une ligne NDJSON, ou un message "strategy_diff" du démon):
+//   {"type": "strategy_diff", "iteration": n, "infosets": total,
+//    "changed": [{"key": "...", "strategy": [p0, p1, ...]}, ...]}
+// Les probabilités sont arrondies à 4 décimales par l'écrivain
+// (strategy_diff_writer()).
+class StrategyDiffTracker {
+public:
+    explicit StrategyDiffTracker(double threshold) : threshold_(threshold) {}
+
+    // Trame des infosets modifiés depuis leur dernier envoi; null si aucun.
+    // À appeler entre deux itérations (CFRSolver::set_iteration_callback).
+    Json::Value diff(const CFRSolver& solver, int iteration);
+
+private:
+    double threshold_;
+    // Dernière stratégie envoyée par infoset, en float pour limiter la mémoire
+    std::unordered_map<std::string, std::vector<float>> sent_;
+};
+
+// Écrivain compact (une ligne, 4 décimales) pour les trames de diff
+Json::StreamWriterBuilder strategy_diff_writer();
+
+} // namespace poker
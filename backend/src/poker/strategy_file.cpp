@@ -0,0 +1,377 @@
+#include "strategy_file.h"
+#include "binary_io.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace poker {
+
+namespace {
+
+constexpr uint64_t RECORD_ALIGNMENT = 8;
+
+struct PendingInfoset {
+    uint64_t key_hash;
+    std::string key;
+    std::vector<Action> actions;
+    std::vector<double> strategy;
+};
+
+// Probabilités élaguées puis quantifiées sur scale unités exactement (plus forts restes)
+std::vector<uint32_t> quantize_strategy(const std::vector<double>& strategy, double prune_threshold, uint32_t scale) {
+    std::vector<double> kept(strategy.size(), 0.0);
+    double total = 0.0;
+    for (size_t i = 0; i < strategy.size(); ++i) {
+        if (strategy[i] >= prune_threshold && strategy[i] > 0.0) {
+            kept[i] = strategy[i];
+            total += strategy[i];
+        }
+    }
+    if (!(total > 0.0)) {
+        // Tout est élagué: l'action la plus probable reste
+        kept[std::max_element(strategy.begin(), strategy.end()) - strategy.begin()] = 1.0;
+        total = 1.0;
+    }
+
+    std::vector<uint32_t> quantized(strategy.size());
+    std::vector<std::pair<double, size_t>> remainders;
+    uint32_t assigned = 0;
+    for (size_t i = 0; i < kept.size(); ++i) {
+        double exact = kept[i] / total * scale;
+        quantized[i] = std::min(scale, static_cast<uint32_t>(exact));
+        assigned += quantized[i];
+        remainders.emplace_back(exact - quantized[i], i);
+    }
+    std::stable_sort(remainders.begin(), remainders.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (size_t k = 0; assigned < scale && k < remainders.size(); ++k, ++assigned) {
+        ++quantized[remainders[k].second];
+    }
+    return quantized;
+}
+
+void append_value(std::string& out, uint32_t value, int value_bits) {
+    if (value_bits == 8) {
+        out.push_back(static_cast<char>(value));
+    } else {
+        uint16_t v = static_cast<uint16_t>(value);
+        out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+    }
+}
+
+} // namespace
+
+void write_strategy_file(const CFRSolver& solver, const std::string& filename,
+                         const StrategyExportOptions& options) {
+    if (options.value_bits != 8 && options.value_bits != 16) {
+        throw std::runtime_error("Précision de stratégie non supportée: " + std::to_string(options.value_bits) +
+                                 " bits (attendu: 8 ou 16)");
+    }
+    const uint32_t scale = options.value_bits == 8 ? 0xFFu : 0xFFFFu;
+    const size_t value_bytes = options.value_bits / 8;
+
+    std::vector<PendingInfoset> infosets;
+    solver.for_each_infoset([&infosets](const std::string& key, const GameNode& node) {
+        if (node.actions.size() > UINT16_MAX) {
+            throw std::runtime_error("Trop d'actions pour l'export de stratégie: " + key);
+        }
+        infosets.push_back({fnv1a_64(key), key, node.actions, node.get_average_strategy()});
+    });
+    // Ordre de recherche dichotomique de StrategyFile::find
+    std::sort(infosets.begin(), infosets.end(), [](const PendingInfoset& a, const PendingInfoset& b) {
+        return a.key_hash != b.key_hash ? a.key_hash < b.key_hash : a.key < b.key;
+    });
+
+    std::vector<StrategyIndexEntry> index;
+    index.reserve(infosets.size());
+    std::string keys;
+    std::string records;
+    for (const auto& infoset : infosets) {
+        StrategyIndexEntry entry{};
+        entry.key_hash = infoset.key_hash;
+        entry.key_offset = keys.size();
+        entry.key_length = static_cast<uint32_t>(infoset.key.size());
+        entry.num_actions = static_cast<uint16_t>(infoset.actions.size());
+        entry.record_offset = records.size();
+        keys += infoset.key;
+
+        for (const Action& action : infoset.actions) {
+            StrategyAction stored{};
+            stored.type = static_cast<uint8_t>(action.type);
+            stored.amount = action.amount;
+            records.append(reinterpret_cast<const char*>(&stored), sizeof(stored));
+        }
+
+        std::vector<uint32_t> quantized;
+        if (!infoset.strategy.empty()) {
+            quantized = quantize_strategy(infoset.strategy, options.prune_threshold, scale);
+        }
+        size_t nonzero = std::count_if(quantized.begin(), quantized.end(), [](uint32_t q) { return q != 0; });
+        bool sparse = quantized.size() <= 256 && nonzero * (1 + value_bytes) < quantized.size() * value_bytes;
+        entry.num_stored = static_cast<uint16_t>(sparse ? nonzero : quantized.size());
+        if (sparse) {
+            for (size_t i = 0; i < quantized.size(); ++i) {
+                if (quantized[i]) {
+                    records.push_back(static_cast<char>(i));
+                }
+            }
+        }
+        for (uint32_t q : quantized) {
+            if (!sparse || q) {
+                append_value(records, q, options.value_bits);
+            }
+        }
+        records.resize(align_up(records.size(), RECORD_ALIGNMENT), '\0');
+        index.push_back(entry);
+    }
+
+    StrategyFileHeader header{};
+    std::memcpy(header.magic, STRATEGY_FILE_MAGIC, sizeof(header.magic));
+    header.version = STRATEGY_FILE_VERSION;
+    header.solver_type = static_cast<uint32_t>(solver.solver_type());
+    header.iteration = static_cast<uint64_t>(solver.current_iteration());
+    header.num_infosets = index.size();
+    header.value_bits = static_cast<uint8_t>(options.value_bits);
+    header.prune_threshold = static_cast<float>(options.prune_threshold);
+
+    const std::pair<const void*, uint64_t> contents[] = {
+        {index.data(), index.size() * sizeof(StrategyIndexEntry)},
+        {keys.data(), keys.size()},
+        {records.data(), records.size()},
+        {options.metadata.data(), options.metadata.size()},
+    };
+    uint64_t offset = sizeof(StrategyFileHeader);
+    for (size_t s = 0; s < static_cast<size_t>(StrategySection::COUNT); ++s) {
+        offset = align_up(offset, RECORD_ALIGNMENT);
+        header.sections[s].offset = offset;
+        header.sections[s].size = contents[s].second;
+        header.sections[s].crc = crc32(contents[s].first, contents[s].second);
+        offset += contents[s].second;
+    }
+    header.header_crc = crc32(&header, sizeof(header));
+
+    const std::string tmp_filename = filename + ".tmp";
+    {
+        std::ofstream out(tmp_filename, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Impossible de créer le fichier de stratégie " + tmp_filename);
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        uint64_t position = sizeof(header);
+        static const char padding[RECORD_ALIGNMENT] = {};
+        for (size_t s = 0; s < static_cast<size_t>(StrategySection::COUNT); ++s) {
+            out.write(padding, static_cast<std::streamsize>(header.sections[s].offset - position));
+            out.write(static_cast<const char*>(contents[s].first), static_cast<std::streamsize>(contents[s].second));
+            position = header.sections[s].offset + contents[s].second;
+        }
+        if (!out.flush()) {
+            std::remove(tmp_filename.c_str());
+            throw std::runtime_error("Écriture du fichier de stratégie impossible: " + tmp_filename);
+        }
+    }
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        std::remove(tmp_filename.c_str());
+        throw std::runtime_error("Impossible de renommer le fichier de stratégie vers " + filename);
+    }
+}
+
+// StrategyFile implementation
+StrategyFile::StrategyFile(const std::string& filename, bool verify_sections)
+    : filename_(filename), base_(nullptr), size_(0), header_{}, index_(nullptr), num_entries_(0),
+      keys_(nullptr), records_(nullptr), records_size_(0), metadata_(nullptr), metadata_size_(0) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier de stratégie " + filename);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(StrategyFileHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Fichier de stratégie tronqué (en-tête): " + filename);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    base_ = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base_ == MAP_FAILED) {
+        base_ = nullptr;
+        throw std::runtime_error("mmap du fichier de stratégie impossible: " + filename + " (" +
+                                 std::strerror(errno) + ")");
+    }
+
+    try {
+        const char* bytes = static_cast<const char*>(base_);
+        std::memcpy(&header_, bytes, sizeof(header_));
+        if (std::memcmp(header_.magic, STRATEGY_FILE_MAGIC, sizeof(header_.magic)) != 0) {
+            throw std::runtime_error("Fichier de stratégie invalide (magic): " + filename);
+        }
+        if (header_.version != STRATEGY_FILE_VERSION) {
+            throw std::runtime_error("Version de fichier de stratégie non supportée (" +
+                                     std::to_string(header_.version) + "): " + filename);
+        }
+        StrategyFileHeader zeroed = header_;
+        zeroed.header_crc = 0;
+        if (crc32(&zeroed, sizeof(zeroed)) != header_.header_crc) {
+            throw std::runtime_error("En-tête de fichier de stratégie corrompu (CRC): " + filename);
+        }
+        if (header_.value_bits != 8 && header_.value_bits != 16) {
+            throw std::runtime_error("Précision de fichier de stratégie invalide: " + filename);
+        }
+        for (const auto& entry : header_.sections) {
+            if (entry.offset > size_ || entry.size > size_ - entry.offset) {
+                throw std::runtime_error("Fichier de stratégie tronqué (sections): " + filename);
+            }
+            if (verify_sections && crc32(bytes + entry.offset, entry.size) != entry.crc) {
+                throw std::runtime_error("Section de fichier de stratégie corrompue (CRC): " + filename);
+            }
+        }
+        if (header_.sections[static_cast<size_t>(StrategySection::INDEX)].size !=
+            header_.num_infosets * sizeof(StrategyIndexEntry)) {
+            throw std::runtime_error("Index de fichier de stratégie incohérent: " + filename);
+        }
+
+        index_ = reinterpret_cast<const StrategyIndexEntry*>(section(StrategySection::INDEX));
+        num_entries_ = header_.num_infosets;
+        keys_ = section(StrategySection::KEYS);
+        records_ = section(StrategySection::RECORDS);
+        records_size_ = header_.sections[static_cast<size_t>(StrategySection::RECORDS)].size;
+        metadata_ = section(StrategySection::METADATA);
+        metadata_size_ = header_.sections[static_cast<size_t>(StrategySection::METADATA)].size;
+    } catch (...) {
+        ::munmap(base_, size_);
+        base_ = nullptr;
+        throw;
+    }
+}
+
+StrategyFile::~StrategyFile() {
+    if (base_) {
+        ::munmap(base_, size_);
+    }
+}
+
+const char* StrategyFile::section(StrategySection id) const {
+    return static_cast<const char*>(base_) + header_.sections[static_cast<size_t>(id)].offset;
+}
+
+std::string_view StrategyFile::key_of(const StrategyIndexEntry& entry) const {
+    const uint64_t keys_size = header_.sections[static_cast<size_t>(StrategySection::KEYS)].size;
+    if (entry.key_offset > keys_size || entry.key_length > keys_size - entry.key_offset) {
+        throw std::runtime_error("Clé hors limites dans le fichier de stratégie " + filename_);
+    }
+    return std::string_view(keys_ + entry.key_offset, entry.key_length);
+}
+
+std::string_view StrategyFile::metadata() const {
+    return std::string_view(metadata_, metadata_size_);
+}
+
+const StrategyIndexEntry* StrategyFile::find(std::string_view key) const {
+    const uint64_t hash = fnv1a_64(key.data(), key.size());
+    const StrategyIndexEntry* end = index_ + num_entries_;
+    const StrategyIndexEntry* it = std::lower_bound(index_, end, hash,
+        [](const StrategyIndexEntry& entry, uint64_t h) { return entry.key_hash < h; });
+    for (; it != end && it->key_hash == hash; ++it) {
+        if (key_of(*it) == key) {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<Action> StrategyFile::actions(const StrategyIndexEntry& entry) const {
+    const uint64_t size = entry.num_actions * sizeof(StrategyAction);
+    if (entry.record_offset > records_size_ || size > records_size_ - entry.record_offset) {
+        throw std::runtime_error("Enregistrement hors limites dans le fichier de stratégie " + filename_);
+    }
+    std::vector<Action> actions(entry.num_actions);
+    for (size_t i = 0; i < entry.num_actions; ++i) {
+        StrategyAction stored;
+        std::memcpy(&stored, records_ + entry.record_offset + i * sizeof(StrategyAction), sizeof(stored));
+        actions[i] = Action{static_cast<ActionType>(stored.type), stored.amount};
+    }
+    return actions;
+}
+
+std::vector<double> StrategyFile::strategy(const StrategyIndexEntry& entry) const {
+    const size_t value_bytes = header_.value_bits / 8;
+    const bool sparse = entry.num_stored < entry.num_actions;
+    const uint64_t size = entry.num_actions * sizeof(StrategyAction) +
+                          entry.num_stored * (value_bytes + (sparse ? 1 : 0));
+    if (entry.num_stored > entry.num_actions || entry.record_offset > records_size_ ||
+        size > records_size_ - entry.record_offset) {
+        throw std::runtime_error("Enregistrement hors limites dans le fichier de stratégie " + filename_);
+    }
+
+    const char* ptr = records_ + entry.record_offset + entry.num_actions * sizeof(StrategyAction);
+    const unsigned char* indices = reinterpret_cast<const unsigned char*>(ptr);
+    const char* values = sparse ? ptr + entry.num_stored : ptr;
+    const double scale = header_.value_bits == 8 ? 255.0 : 65535.0;
+
+    std::vector<double> strategy(entry.num_actions, 0.0);
+    for (size_t k = 0; k < entry.num_stored; ++k) {
+        uint32_t q;
+        if (value_bytes == 1) {
+            q = static_cast<unsigned char>(values[k]);
+        } else {
+            uint16_t v;
+            std::memcpy(&v, values + 2 * k, sizeof(v));
+            q = v;
+        }
+        size_t action = sparse ? indices[k] : k;
+        if (action >= strategy.size()) {
+            throw std::runtime_error("Indice d'action invalide dans le fichier de stratégie " + filename_);
+        }
+        strategy[action] = q / scale;
+    }
+    return strategy;
+}
+
+Json::Value strategy_file_to_json(const StrategyFile& file) {
+    const StrategyFileHeader& header = file.header();
+    Json::Value output;
+    output["format"] = "gto-strategy";
+    output["version"] = header.version;
+    output["solver_type"] = header.solver_type;
+    output["iteration"] = static_cast<Json::UInt64>(header.iteration);
+    output["value_bits"] = header.value_bits;
+    output["prune_threshold"] = header.prune_threshold;
+
+    std::string_view metadata = file.metadata();
+    if (!metadata.empty()) {
+        Json::CharReaderBuilder builder;
+        std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+        Json::Value parsed;
+        std::string errors;
+        if (reader->parse(metadata.data(), metadata.data() + metadata.size(), &parsed, &errors)) {
+            output["metadata"] = parsed;
+        } else {
+            output["metadata"] = std::string(metadata);
+        }
+    }
+
+    output["infosets"] = Json::Value(Json::arrayValue);
+    for (size_t i = 0; i < file.num_infosets(); ++i) {
+        const StrategyIndexEntry& entry = file.entry(i);
+        Json::Value infoset;
+        infoset["key"] = std::string(file.key_of(entry));
+        infoset["actions"] = Json::Value(Json::arrayValue);
+        for (const Action& action : file.actions(entry)) {
+            infoset["actions"].append(action.to_string());
+        }
+        infoset["strategy"] = Json::Value(Json::arrayValue);
+        for (double probability : file.strategy(entry)) {
+            infoset["strategy"].append(probability);
+        }
+        output["infosets"].append(std::move(infoset));
+    }
+    return output;
+}
+
+} // namespace poker
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "cfr_solver.h"
+#include <json/json.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace poker {
+
+// Export binaire de la solution complète (stratégies moyennes de tous les
+// infosets), destiné à l'ingestion par le master et aux requêtes.
+//
+// Disposition du fichier:
+//   StrategyFileHeader (144 octets, table des sections incluse)
+//   INDEX     StrategyIndexEntry par infoset, triées par (key_hash, clé)
+//   KEYS      clés des infosets concaténées (CFRSolver::state_to_key)
+//   RECORDS   par infoset: description de l'arbre (StrategyAction x
+//             num_actions) puis probabilités quantifiées
+//   METADATA  document JSON libre (task_type, configurations du spot)
+//
+// Les probabilités sont quantifiées sur 8 ou 16 bits avec une somme exacte
+// de 255 ou 65535 par infoset (méthode des plus forts restes). Les actions
+// sous prune_threshold sont mises à zéro avant quantification. Un
+// enregistrement est creux (indices des actions non nulles suivis de leurs
+// valeurs) quand c'est plus court que la forme dense. Aucune section n'est
+// compressée: le fichier se mappe et s'interroge tel quel (StrategyFile).
+
+constexpr char STRATEGY_FILE_MAGIC[8] = {'G', 'T', 'O', 'S', 'T', 'R', 'A', 'T'};
+constexpr uint32_t STRATEGY_FILE_VERSION = 2;
+
+enum class StrategySection : uint32_t {
+    INDEX = 0,
+    KEYS = 1,
+    RECORDS = 2,
+    METADATA = 3,
+    COUNT = 4
+};
+
+struct StrategySectionEntry {
+    uint64_t offset;   // Depuis le début du fichier
+    uint64_t size;
+    uint32_t crc;      // CRC32 des octets de la section
+    uint32_t reserved;
+};
+static_assert(sizeof(StrategySectionEntry) == 24, "StrategySectionEntry doit faire 24 octets");
+
+struct StrategyFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t solver_type;      // Valeur de SolverType
+    uint64_t iteration;
+    uint64_t num_infosets;
+    uint8_t value_bits;        // 8 ou 16
+    uint8_t reserved_flags[3];
+    float prune_threshold;
+    StrategySectionEntry sections[static_cast<size_t>(StrategySection::COUNT)];
+    uint32_t header_crc;       // CRC32 de l'en-tête, ce champ à zéro
+    uint32_t reserved;
+};
+static_assert(sizeof(StrategyFileHeader) == 144, "StrategyFileHeader doit faire 144 octets");
+
+struct StrategyIndexEntry {
+    uint64_t key_hash;         // fnv1a_64 de la clé
+    uint64_t key_offset;       // Dans KEYS
+    uint32_t key_length;
+    uint16_t num_actions;
+    uint16_t num_stored;       // num_actions: dense; moins: creux
+    uint64_t record_offset;    // Dans RECORDS (aligné sur 8 octets)
+};
+static_assert(sizeof(StrategyIndexEntry) == 32, "StrategyIndexEntry doit faire 32 octets");
+
+struct StrategyAction {
+    uint8_t type;              // Valeur de ActionType
+    uint8_t reserved[7];
+    double amount;             // Exact: rejouer un historique reconstruit les clés
+};
+static_assert(sizeof(StrategyAction) == 16, "StrategyAction doit faire 16 octets");
+
+struct StrategyExportOptions {
+    int value_bits = 8;            // 8 ou 16
+    double prune_threshold = 0.0;  // Probabilités inférieures mises à zéro
+    std::string metadata;          // JSON stocké dans METADATA
+};
+
+// Écrit les stratégies moyennes des infosets de solver (fichier temporaire
+// puis rename). Lève std::runtime_error en cas d'échec.
+void write_strategy_file(const CFRSolver& solver, const std::string& filename,
+                         const StrategyExportOptions& options);
+
+// Fichier de stratégie mappé en lecture seule (MAP_SHARED): plusieurs
+// processus qui l'ouvrent partagent le cache de pages.
+class StrategyFile {
+public:
+    // Valide l'en-tête et les bornes des sections; verify_sections vérifie
+    // aussi leurs CRC (lit le fichier en entier). Lève std::runtime_error
+    // si le fichier est absent, tronqué ou corrompu.
+    StrategyFile(const std::string& filename, bool verify_sections = false);
+    ~StrategyFile();
+
+    StrategyFile(const StrategyFile&) = delete;
+    StrategyFile& operator=(const StrategyFile&) = delete;
+
+    const StrategyFileHeader& header() const { return header_; }
+    size_t num_infosets() const { return num_entries_; }
+    const StrategyIndexEntry& entry(size_t i) const { return index_[i]; }
+    std::string_view key_of(const StrategyIndexEntry& entry) const;
+    std::string_view metadata() const;
+
+    // Recherche dichotomique par hash dans l'index mappé, nullptr si absent
+    const StrategyIndexEntry* find(std::string_view key) const;
+
+    std::vector<Action> actions(const StrategyIndexEntry& entry) const;
+    // Probabilités décodées, une par action (somme 1)
+    std::vector<double> strategy(const StrategyIndexEntry& entry) const;
+
+private:
+    std::string filename_;
+    void* base_;
+    size_t size_;
+    StrategyFileHeader header_;
+    const StrategyIndexEntry* index_;
+    size_t num_entries_;
+    const char* keys_;
+    const char* records_;
+    uint64_t records_size_;
+    const char* metadata_;
+    uint64_t metadata_size_;
+
+    const char* section(StrategySection id) const;
+};
+
+// Document JSON de débogage: en-tête, métadonnées et tous les infosets
+// ({"key", "actions", "strategy"}), dans l'ordre de l'index
+Json::Value strategy_file_to_json(const StrategyFile& file);
+
+} // namespace poker
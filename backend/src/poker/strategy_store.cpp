@@ -0,0 +1,243 @@
+#include "strategy_store.h"
+#include "action_translation.h"
+#include "cfr_solver.h"
+#include "solve_job.h"
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <stdexcept>
+
+namespace poker {
+
+namespace {
+
+GameState root_from_metadata(const StrategyFile& file) {
+    std::string_view metadata = file.metadata();
+    Json::CharReaderBuilder builder;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    Json::Value parsed;
+    std::string errors;
+    if (!reader->parse(metadata.data(), metadata.data() + metadata.size(), &parsed, &errors) ||
+        !parsed.isObject() || !parsed.isMember("game_config")) {
+        throw std::runtime_error("Métadonnées du fichier de stratégie sans game_config");
+    }
+    return parse_game_config(parsed["game_config"]);
+}
+
+std::vector<Card> parse_query_cards(const std::string& cards, const char* what) {
+    try {
+        return parse_cards(cards);
+    } catch (const std::invalid_argument& e) {
+        throw std::runtime_error(std::string(what) + " invalide: " + e.what());
+    }
+}
+
+// Montant d'un jeton r<montant> ou b<montant>
+bool raise_token_amount(const std::string& token, double& amount) {
+    char kind = static_cast<char>(std::tolower(static_cast<unsigned char>(token[0])));
+    if ((kind != 'r' && kind != 'b') || token.size() < 2) {
+        return false;
+    }
+    size_t parsed = 0;
+    try {
+        amount = std::stod(token.substr(1), &parsed);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return parsed == token.size() - 1;
+}
+
+} // namespace
+
+StrategyStore::StrategyStore(const std::string& filename)
+    : file_(filename), root_(root_from_metadata(file_)) {}
+
+const StrategyIndexEntry& StrategyStore::node_entry(const GameState& state, std::string& key) const {
+    key = infoset_key(state, state.current_player);
+    const StrategyIndexEntry* entry = file_.find(key);
+    if (!entry) {
+        throw std::runtime_error("Infoset absent de la solution: " + key);
+    }
+    return *entry;
+}
+
+StrategyAnswer StrategyStore::query(const StrategyQuery& query) const {
+    GameState root = root_;
+    if (!query.board.empty()) {
+        Board board = parse_query_cards(query.board, "Tableau");
+        if (board.size() < 3 || board.size() > 5) {
+            throw std::runtime_error("Tableau de 3 à 5 cartes attendu: " + query.board);
+        }
+        root.board = board;
+        root.street = static_cast<int>(board.size()) - 2;
+    }
+    if (!query.hand.empty()) {
+        std::vector<Card> hand = parse_query_cards(query.hand, "Main");
+        if (hand.size() != 2) {
+            throw std::runtime_error("Main de 2 cartes attendue: " + query.hand);
+        }
+        for (const Card& card : hand) {
+            if (std::find(root.board.begin(), root.board.end(), card) != root.board.end()) {
+                throw std::runtime_error("Carte de la main déjà sur le tableau: " + card.to_string());
+            }
+        }
+    }
+
+    bool random_seed = query.translation == TranslationMode::RANDOM && !query.has_seed;
+    std::mt19937_64 rng(random_seed ? std::random_device{}() : query.seed);
+    std::vector<Branch> branches{{std::move(root), 1.0, {}}};
+    std::string key;
+    std::string last_error;
+    const std::string& history = query.history;
+    size_t pos = 0;
+    while (pos < history.size()) {
+        size_t end = history.find_first_of(" ,/\t", pos);
+        if (end == std::string::npos) end = history.size();
+        if (end > pos) {
+            std::string token = history.substr(pos, end - pos);
+            std::vector<Branch> next;
+            for (Branch& branch : branches) {
+                try {
+                    follow(branch, token, query.translation, rng, next);
+                } catch (const std::runtime_error& e) {
+                    last_error = e.what();
+                }
+            }
+            if (next.empty()) {
+                throw std::runtime_error(last_error);
+            }
+            branches = std::move(next);
+        }
+        pos = end + 1;
+    }
+
+    // Mélange des stratégies des branches restantes, actions réunies
+    StrategyAnswer answer;
+    const Branch* heaviest = nullptr;
+    double total_weight = 0.0;
+    std::vector<std::pair<const Branch*, const StrategyIndexEntry*>> reached;
+    for (const Branch& branch : branches) {
+        try {
+            if (branch.state.is_terminal()) {
+                throw std::runtime_error("L'historique mène à un état terminal");
+            }
+            reached.emplace_back(&branch, &node_entry(branch.state, key));
+            total_weight += branch.weight;
+            if (!heaviest || branch.weight > heaviest->weight) {
+                heaviest = &branch;
+                answer.key = key;
+            }
+        } catch (const std::runtime_error& e) {
+            last_error = e.what();
+        }
+    }
+    if (reached.empty()) {
+        throw std::runtime_error(last_error);
+    }
+
+    for (const auto& [branch, entry] : reached) {
+        std::vector<Action> actions = file_.actions(*entry);
+        std::vector<double> strategy = file_.strategy(*entry);
+        for (size_t i = 0; i < actions.size(); ++i) {
+            auto it = std::find(answer.actions.begin(), answer.actions.end(), actions[i]);
+            size_t slot = it - answer.actions.begin();
+            if (it == answer.actions.end()) {
+                answer.actions.push_back(actions[i]);
+                answer.strategy.push_back(0.0);
+            }
+            answer.strategy[slot] += branch->weight / total_weight * strategy[i];
+        }
+    }
+    answer.player = heaviest->state.current_player;
+    answer.translations = heaviest->translations;
+    return answer;
+}
+
+void StrategyStore::follow(const Branch& branch, const std::string& token, TranslationMode mode,
+                           std::mt19937_64& rng, std::vector<Branch>& next) const {
+    if (branch.state.is_terminal()) {
+        throw std::runtime_error("Historique au-delà d'un état terminal: " + token);
+    }
+    std::string key;
+    std::vector<Action> actions = file_.actions(node_entry(branch.state, key));
+
+    double amount = 0.0;
+    if (mode == TranslationMode::NEAREST || !raise_token_amount(token, amount)) {
+        Action action = parse_history_action(token, actions);
+        next.push_back({branch.state.apply_action(action), branch.weight, branch.translations});
+        return;
+    }
+
+    BetTranslation translation = translate_bet(actions, amount, branch.state.pot);
+    if (translation.lower == translation.upper) {
+        next.push_back({branch.state.apply_action(actions[translation.lower]), branch.weight, branch.translations});
+        return;
+    }
+    auto push = [&](size_t index, double probability) {
+        if (probability <= 0.0) {
+            return;
+        }
+        Branch child{branch.state.apply_action(actions[index]), branch.weight * probability, branch.translations};
+        child.translations.push_back({token, actions[translation.lower], actions[translation.upper],
+                                      translation.lower_probability, actions[index]});
+        next.push_back(std::move(child));
+    };
+    if (mode == TranslationMode::RANDOM) {
+        bool lower = std::uniform_real_distribution<double>(0.0, 1.0)(rng) < translation.lower_probability;
+        push(lower ? translation.lower : translation.upper, 1.0);
+    } else {
+        push(translation.lower, translation.lower_probability);
+        push(translation.upper, 1.0 - translation.lower_probability);
+    }
+}
+
+StrategyQuery parse_strategy_query(const Json::Value& request) {
+    StrategyQuery query;
+    query.history = request.get("history", "").asString();
+    query.hand = request.get("hand", "").asString();
+    query.board = request.get("board", "").asString();
+    std::string mode = request.get("translation", "blend").asString();
+    if (mode == "blend") {
+        query.translation = TranslationMode::BLEND;
+    } else if (mode == "random") {
+        query.translation = TranslationMode::RANDOM;
+    } else if (mode == "nearest") {
+        query.translation = TranslationMode::NEAREST;
+    } else {
+        throw std::runtime_error("Mode de traduction inconnu: " + mode + " (attendu: blend, random ou nearest)");
+    }
+    if (request.isMember("seed")) {
+        query.has_seed = true;
+        query.seed = request["seed"].asUInt64();
+    }
+    return query;
+}
+
+Json::Value strategy_answer_json(const StrategyAnswer& answer) {
+    Json::Value output;
+    output["player"] = answer.player;
+    output["key"] = answer.key;
+    output["actions"] = Json::Value(Json::arrayValue);
+    for (const Action& action : answer.actions) {
+        output["actions"].append(action.to_string());
+    }
+    output["strategy"] = Json::Value(Json::arrayValue);
+    for (double probability : answer.strategy) {
+        output["strategy"].append(probability);
+    }
+    if (!answer.translations.empty()) {
+        output["translations"] = Json::Value(Json::arrayValue);
+        for (const AppliedTranslation& translation : answer.translations) {
+            Json::Value entry;
+            entry["token"] = translation.token;
+            entry["lower"] = translation.lower.to_string();
+            entry["upper"] = translation.upper.to_string();
+            entry["lower_probability"] = translation.lower_probability;
+            entry["taken"] = translation.taken.to_string();
+            output["translations"].append(std::move(entry));
+        }
+    }
+    return output;
+}
+
+} // namespace poker
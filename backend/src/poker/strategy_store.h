@@ -0,0 +1,103 @@
+#pragma once
+
+#include "game_tree.h"
+#include "strategy_file.h"
+#include <json/json.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace poker {
+
+// Requêtes sur une solution exportée (write_strategy_file) sans relancer le
+// solveur: le fichier est mappé (StrategyFile, cache de pages partagé entre
+// les processus) et une requête ne décode que les enregistrements des nœuds
+// traversés, trouvés par recherche dichotomique dans l'index.
+//
+// L'historique est rejoué depuis la racine décrite par les métadonnées
+// (game_config), avec les actions stockées de chaque nœud: aucune
+// abstraction n'est reconstruite. Les clés d'infoset (infoset_key) ne
+// dépendent pas des cartes privées: la main est validée (cartes distinctes
+// du tableau) puis reçoit la stratégie du nœud.
+//
+// Une relance de l'historique dont le montant n'est pas une taille
+// abstraite est traduite vers ses voisines (action_translation.h):
+//   BLEND   les deux branches sont suivies et les stratégies finales
+//           mélangées selon les probabilités de traduction (défaut)
+//   RANDOM  une branche tirée selon ces probabilités (seed reproductible)
+//   NEAREST la relance abstraite la plus proche en jetons
+// Une branche qui sort de la solution (état terminal, infoset jamais
+// visité) est écartée et le mélange renormalisé.
+enum class TranslationMode {
+    BLEND,
+    RANDOM,
+    NEAREST
+};
+
+struct StrategyQuery {
+    std::string history;  // Jetons de parse_history_action, vide: racine
+    std::string hand;     // Cartes du joueur qui agit ("AhQc"), optionnel
+    std::string board;    // Tableau ("As Kd 7h"), vide: celui de la solution
+    TranslationMode translation = TranslationMode::BLEND;
+    bool has_seed = false;
+    uint64_t seed = 0;    // RANDOM; sinon tirage non reproductible
+};
+
+// Relance hors abstraction rencontrée sur la branche retenue
+struct AppliedTranslation {
+    std::string token;
+    Action lower;
+    Action upper;
+    double lower_probability;
+    Action taken;         // Action suivie par la branche retenue
+};
+
+struct StrategyAnswer {
+    int player;
+    std::string key;      // Branche de plus fort poids (ou tirée)
+    std::vector<Action> actions;    // Union des actions des branches mélangées
+    std::vector<double> strategy;
+    std::vector<AppliedTranslation> translations;
+};
+
+class StrategyStore {
+public:
+    // Lève std::runtime_error si le fichier est invalide ou si ses
+    // métadonnées ne décrivent pas le spot (game_config)
+    explicit StrategyStore(const std::string& filename);
+
+    // Lève std::runtime_error pour des cartes invalides, une action absente
+    // de la solution ou un historique qui mène à un état terminal
+    StrategyAnswer query(const StrategyQuery& query) const;
+
+    const StrategyFile& file() const { return file_; }
+
+private:
+    // Chemin pondéré dans l'arbre de la solution
+    struct Branch {
+        GameState state;
+        double weight;
+        std::vector<AppliedTranslation> translations;
+    };
+
+    StrategyFile file_;
+    GameState root_;
+
+    const StrategyIndexEntry& node_entry(const GameState& state, std::string& key) const;
+    // Ajoute à next les branches issues de branch après le jeton token
+    void follow(const Branch& branch, const std::string& token, TranslationMode mode,
+                std::mt19937_64& rng, std::vector<Branch>& next) const;
+};
+
+// {"history", "hand", "board", "translation": "blend" | "random" |
+// "nearest", "seed"} (membres optionnels); lève std::runtime_error pour un
+// mode de traduction inconnu
+StrategyQuery parse_strategy_query(const Json::Value& request);
+
+// {"player", "key", "actions": [...], "strategy": [...]}, plus
+// "translations": [{"token", "lower", "upper", "lower_probability", "taken"}]
+// si l'historique contient des relances hors abstraction
+Json::Value strategy_answer_json(const StrategyAnswer& answer);
+
+} // namespace poker
@@ -0,0 +1,183 @@
+#include "trace.h"
+#include <json/json.h>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include <unistd.h>
+
+namespace poker {
+namespace trace {
+
+namespace {
+
+struct Event {
+    const char* name;
+    const char* category;
+    int64_t start_ns;
+    int64_t duration_ns;
+    const char* arg_names[2];
+    int64_t arg_values[2];
+    int num_args;
+};
+
+// Tampon circulaire d'un thread: seul ce thread écrit, write_file lit
+struct ThreadBuffer {
+    uint32_t tid;
+    std::string name; // Protégé par Registry::mutex
+    std::unique_ptr<Event[]> events{new Event[BUFFER_EVENTS]};
+    std::atomic<uint64_t> head{0}; // Nombre total d'événements écrits
+};
+
+static_assert((BUFFER_EVENTS & (BUFFER_EVENTS - 1)) == 0, "BUFFER_EVENTS doit être une puissance de 2");
+
+struct Registry {
+    std::mutex mutex;
+    // Les tampons survivent à leur thread jusqu'à l'écriture du fichier
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    uint32_t next_tid = 1;
+};
+
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+std::chrono::steady_clock::time_point epoch;
+thread_local std::shared_ptr<ThreadBuffer> local_buffer;
+
+ThreadBuffer& thread_buffer() {
+    if (!local_buffer) {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        buffer->tid = r.next_tid++;
+        buffer->name = "thread " + std::to_string(buffer->tid);
+        r.buffers.push_back(buffer);
+        local_buffer = std::move(buffer);
+    }
+    return *local_buffer;
+}
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void write_microseconds(std::ostream& out, int64_t ns) {
+    out << ns / 1000 << '.' << static_cast<char>('0' + ns % 1000 / 100)
+        << static_cast<char>('0' + ns % 100 / 10) << static_cast<char>('0' + ns % 10);
+}
+
+} // namespace
+
+void start() {
+    epoch = std::chrono::steady_clock::now();
+    active.store(true, std::memory_order_release);
+    set_thread_name("main");
+}
+
+void set_thread_name(const std::string& name) {
+    if (!enabled()) {
+        return;
+    }
+    ThreadBuffer& buffer = thread_buffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.name = name;
+}
+
+Span::Span(const char* name, const char* category)
+    : name_(name), category_(category), start_ns_(0), arg_names_{}, arg_values_{}, num_args_(0),
+      recording_(enabled()) {
+    if (recording_) {
+        start_ns_ = now_ns();
+    }
+}
+
+void Span::arg(const char* name, int64_t value) {
+    if (num_args_ < 2) {
+        arg_names_[num_args_] = name;
+        arg_values_[num_args_] = value;
+        ++num_args_;
+    }
+}
+
+void Span::end() {
+    if (!recording_) {
+        return;
+    }
+    recording_ = false;
+    int64_t end_ns = now_ns();
+
+    ThreadBuffer& buffer = thread_buffer();
+    uint64_t index = buffer.head.load(std::memory_order_relaxed);
+    Event& event = buffer.events[index & (BUFFER_EVENTS - 1)];
+    event.name = name_;
+    event.category = category_;
+    event.start_ns = start_ns_;
+    event.duration_ns = end_ns - start_ns_;
+    for (int i = 0; i < 2; ++i) {
+        event.arg_names[i] = arg_names_[i];
+        event.arg_values[i] = arg_values_[i];
+    }
+    event.num_args = num_args_;
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+void write_file(const std::string& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Impossible d'écrire le fichier de trace: " + path);
+    }
+
+    long pid = static_cast<long>(getpid());
+    uint64_t dropped = 0;
+    bool first = true;
+    auto separator = [&]() -> std::ostream& {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        return out;
+    };
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto& buffer : r.buffers) {
+        separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << buffer->tid
+                    << ",\"args\":{\"name\":" << Json::valueToQuotedString(buffer->name.c_str()) << "}}";
+
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t first_index = head > BUFFER_EVENTS ? head - BUFFER_EVENTS : 0;
+        dropped += first_index;
+        for (uint64_t i = first_index; i < head; ++i) {
+            const Event& event = buffer->events[i & (BUFFER_EVENTS - 1)];
+            separator() << "{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+                        << "\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << buffer->tid << ",\"ts\":";
+            write_microseconds(out, event.start_ns);
+            out << ",\"dur\":";
+            write_microseconds(out, event.duration_ns);
+            if (event.num_args) {
+                out << ",\"args\":{";
+                for (int a = 0; a < event.num_args; ++a) {
+                    out << (a ? "," : "") << '"' << event.arg_names[a] << "\":" << event.arg_values[a];
+                }
+                out << '}';
+            }
+            out << '}';
+        }
+    }
+    out << "\n],\"otherData\":{\"dropped_events\":" << dropped << "}}\n";
+
+    if (!out.flush()) {
+        throw std::runtime_error("Échec d'écriture du fichier de trace: " + path);
+    }
+    if (dropped) {
+        std::cerr << "Avertissement: " << dropped << " événements de trace perdus (tampons de "
+                  << BUFFER_EVENTS << " événements par thread pleins)" << std::endl;
+    }
+}
+
+} // namespace trace
+} // namespace poker
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace poker {
+namespace trace {
+
+// Chronologie des phases du solveur (--trace), écrite au format JSON
+// "trace event" de Chrome (chrome://tracing, ui.perfetto.dev).
+//
+// Chaque thread enregistre ses intervalles dans son propre tampon circulaire
+// (un seul écrivain, aucun verrou): quand il est plein, les événements les
+// plus anciens sont écrasés et comptés comme perdus. Tant que start() n'a
+// pas été appelé, un Span coûte un chargement atomique.
+
+constexpr size_t BUFFER_EVENTS = 1 << 16; // Par thread
+
+// Active l'enregistrement; les horodatages partent de cet appel
+void start();
+
+inline std::atomic<bool> active{false};
+
+inline bool enabled() {
+    return active.load(std::memory_order_relaxed);
+}
+
+// Nom du thread courant dans la chronologie (métadonnée thread_name)
+void set_thread_name(const std::string& name);
+
+// Écrit les événements de tous les threads dans path. À appeler quand les
+// threads tracés sont au repos: un événement écrit pendant la copie peut
+// être incohérent. Lève std::runtime_error en cas d'échec.
+void write_file(const std::string& path);
+
+// Intervalle [construction, end() ou destruction] du thread courant.
+// name, category et les noms d'arguments doivent être des littéraux.
+class Span {
+public:
+    Span(const char* name, const char* category);
+    ~Span() { end(); }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    // Deux arguments entiers au plus (affichés dans le panneau de l'événement)
+    void arg(const char* name, int64_t value);
+    // Nom décidé en fin de phase (ex.: itération qui a fait grandir l'arbre)
+    void rename(const char* name) { name_ = name; }
+    void end();
+
+private:
+    const char* name_;
+    const char* category_;
+    int64_t start_ns_;
+    const char* arg_names_[2];
+    int64_t arg_values_[2];
+    int num_args_;
+    bool recording_;
+};
+
+} // namespace trace
+} // namespace poker
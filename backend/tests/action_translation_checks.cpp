@@ -0,0 +1,61 @@
+#include "check.h"
+#include "poker/action_translation.h"
+#include <vector>
+
+using namespace poker;
+
+namespace {
+
+// Relances volontairement dans le désordre: indices 4 (40), 2 (10), 3 (20)
+std::vector<Action> node_actions() {
+    return {{ActionType::FOLD, 0.0}, {ActionType::CALL, 5.0}, {ActionType::RAISE, 10.0},
+            {ActionType::RAISE, 20.0}, {ActionType::RAISE, 40.0}};
+}
+
+void check_translation(const BetTranslation& translation, size_t lower, size_t upper, double probability) {
+    CHECK_EQ(translation.lower, lower);
+    CHECK_EQ(translation.upper, upper);
+    CHECK_NEAR(translation.lower_probability, probability, 1e-12);
+}
+
+} // namespace
+
+POKER_CHECK(action_translation, pseudo_harmonic_mapping) {
+    CHECK_EQ(pseudo_harmonic_probability(0.5, 1.0, 0.5), 1.0);
+    CHECK_EQ(pseudo_harmonic_probability(0.5, 1.0, 1.0), 0.0);
+    CHECK_EQ(pseudo_harmonic_probability(0.5, 1.0, 0.1), 1.0);
+    CHECK_EQ(pseudo_harmonic_probability(0.5, 1.0, 3.0), 0.0);
+    // (B - x)(1 + A) / ((B - A)(1 + x)) = 0.25 * 1.5 / (0.5 * 1.75)
+    CHECK_NEAR(pseudo_harmonic_probability(0.5, 1.0, 0.75), 3.0 / 7.0, 1e-15);
+    CHECK_NEAR(pseudo_harmonic_probability(0.0, 1.0, 0.5), 1.0 / 3.0, 1e-15);
+
+    double previous = 1.0;
+    for (double x = 0.5; x <= 1.0; x += 0.01) {
+        double p = pseudo_harmonic_probability(0.5, 1.0, x);
+        CHECK(p >= 0.0 && p <= previous);
+        previous = p;
+    }
+}
+
+POKER_CHECK(action_translation, translate_bet_neighbours) {
+    std::vector<Action> actions = node_actions();
+    check_translation(translate_bet(actions, 10.0, 20.0), 2, 2, 1.0);
+    check_translation(translate_bet(actions, 40.0, 20.0), 4, 4, 1.0);
+    // Montant d'historique arrondi: tolérance de 0.01 jeton
+    check_translation(translate_bet(actions, 20.005, 20.0), 3, 3, 1.0);
+    check_translation(translate_bet(actions, 19.995, 20.0), 3, 3, 1.0);
+    // Hors de l'intervalle abstrait: plus petite ou plus grande relance
+    check_translation(translate_bet(actions, 2.0, 20.0), 2, 2, 1.0);
+    check_translation(translate_bet(actions, 500.0, 20.0), 4, 4, 1.0);
+    // Tailles en fraction du pot: 10/20 < 15/20 < 20/20
+    check_translation(translate_bet(actions, 15.0, 20.0), 2, 3, 3.0 / 7.0);
+    check_translation(translate_bet(actions, 30.0, 20.0), 3, 4,
+                      pseudo_harmonic_probability(1.0, 2.0, 1.5));
+    // Pot nul: montants pris tels quels
+    check_translation(translate_bet(actions, 15.0, 0.0), 2, 3, pseudo_harmonic_probability(10.0, 20.0, 15.0));
+}
+
+POKER_CHECK(action_translation, rejects_nodes_without_raise) {
+    std::vector<Action> actions = {{ActionType::FOLD, 0.0}, {ActionType::CALL, 5.0}};
+    CHECK_THROWS(translate_bet(actions, 10.0, 20.0), std::runtime_error);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace poker {
+namespace checks {
+
+// Vérifications déterministes sans dépendance externe. Chaque vérification
+// appartient à un groupe (un test ctest: poker_checks <groupe>); un échec
+// lève CheckFailure, rapporté avec le fichier et la ligne.
+
+class CheckFailure : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+using CheckFunction = void (*)();
+
+// Enregistrement statique (macro POKER_CHECK); retourne une valeur ignorée
+int register_check(const char* group, const char* name, CheckFunction function);
+
+[[noreturn]] void fail(const char* file, int line, const std::string& message);
+
+// Répertoire temporaire supprimé avec son contenu à la destruction
+class TempDir {
+public:
+    TempDir();
+    ~TempDir();
+
+    TempDir(const TempDir&) = delete;
+    TempDir& operator=(const TempDir&) = delete;
+
+    std::string path(const std::string& name) const { return path_ + "/" + name; }
+
+private:
+    std::string path_;
+};
+
+// Contenu complet d'un fichier; lève CheckFailure s'il est illisible
+std::string read_file(const std::string& filename);
+void write_file(const std::string& filename, const std::string& contents);
+
+} // namespace checks
+} // namespace poker
+
+#define POKER_CHECK_CONCAT_(a, b) a##b
+#define POKER_CHECK_CONCAT(a, b) POKER_CHECK_CONCAT_(a, b)
+
+#define POKER_CHECK(group, name)                                                              \
+    static void POKER_CHECK_CONCAT(check_, name)();                                           \
+    static const int POKER_CHECK_CONCAT(registered_, name) =                                  \
+        ::poker::checks::register_check(#group, #name, POKER_CHECK_CONCAT(check_, name));     \
+    static void POKER_CHECK_CONCAT(check_, name)()
+
+#define CHECK(condition)                                                                      \
+    do {                                                                                      \
+        if (!(condition)) {                                                                   \
+            ::poker::checks::fail(__FILE__, __LINE__, "CHECK(" #condition ")");               \
+        }                                                                                     \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                            \
+    do {                                                                                      \
+        const auto& check_actual_ = (actual);                                                 \
+        const auto& check_expected_ = (expected);                                             \
+        if (!(check_actual_ == check_expected_)) {                                            \
+            std::ostringstream check_message_;                                                \
+            check_message_ << #actual " == " #expected ": " << check_actual_                  \
+                           << " != " << check_expected_;                                      \
+            ::poker::checks::fail(__FILE__, __LINE__, check_message_.str());                  \
+        }                                                                                     \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance)                                               \
+    do {                                                                                      \
+        double check_actual_ = (actual);                                                      \
+        double check_expected_ = (expected);                                                  \
+        if (!(check_actual_ >= check_expected_ - (tolerance) &&                               \
+              check_actual_ <= check_expected_ + (tolerance))) {                              \
+            std::ostringstream check_message_;                                                \
+            check_message_.precision(17);                                                     \
+            check_message_ << #actual " ~ " #expected ": " << check_actual_ << " vs "         \
+                           << check_expected_ << " (tolérance " << (tolerance) << ")";        \
+            ::poker::checks::fail(__FILE__, __LINE__, check_message_.str());                  \
+        }                                                                                     \
+    } while (0)
+
+// statement doit lever exception_type
+#define CHECK_THROWS(statement, exception_type)                                               \
+    do {                                                                                      \
+        bool check_thrown_ = false;                                                           \
+        try {                                                                                 \
+            statement;                                                                        \
+        } catch (const exception_type&) {                                                     \
+            check_thrown_ = true;                                                             \
+        }                                                                                     \
+        if (!check_thrown_) {                                                                 \
+            ::poker::checks::fail(__FILE__, __LINE__, #statement " ne lève pas " #exception_type); \
+        }                                                                                     \
+    } while (0)
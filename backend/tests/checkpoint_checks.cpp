@@ -0,0 +1,373 @@
+#include "check.h"
+#include "solver_fixture.h"
+#include "poker/binary_io.h"
+#include "poker/checkpoint.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace poker;
+
+namespace {
+
+// Empreinte du fichier brut de make_snapshot(7) (voir plain_format_fingerprint)
+constexpr uint64_t PLAIN_FORMAT_SIZE = 6016;
+constexpr uint64_t PLAIN_FORMAT_FNV = 0x2a554ff08948e744ULL;
+
+// Infosets de tailles variées; valeurs signées non entières, reproductibles
+CheckpointSnapshot make_snapshot(uint64_t iteration) {
+    CheckpointSnapshot snapshot;
+    snapshot.solver_type = 1;
+    snapshot.config_hash = 0x0123456789abcdefULL;
+    snapshot.iteration = iteration;
+    snapshot.solver_state = "42";
+    for (int i = 0; i < 40; ++i) {
+        size_t num_actions = 1 + i % 5;
+        std::vector<double> regrets(num_actions);
+        std::vector<double> strategy(num_actions);
+        for (size_t a = 0; a < num_actions; ++a) {
+            regrets[a] = (i * 7 + a * 3) % 11 - 5.25 + iteration * 0.125;
+            strategy[a] = (i + a) * 0.5 + iteration;
+        }
+        snapshot.add_infoset("p" + std::to_string(i % 2) + "_node" + std::to_string(i), regrets.data(),
+                             strategy.data(), num_actions);
+    }
+    return snapshot;
+}
+
+// Valeurs attendues d'un infoset du snapshot, par clé
+std::vector<double> expected_values(const CheckpointSnapshot& snapshot, const std::string& key) {
+    for (const auto& entry : snapshot.index) {
+        if (snapshot.keys.compare(entry.key_offset, entry.key_length, key) == 0) {
+            const double* values = snapshot.values.data() + entry.value_offset;
+            return std::vector<double>(values, values + 2 * entry.num_actions);
+        }
+    }
+    return {};
+}
+
+} // namespace
+
+POKER_CHECK(checkpoint, plain_round_trip) {
+    checks::TempDir dir;
+    CheckpointSnapshot snapshot = make_snapshot(1234);
+    CheckpointSnapshot reference = snapshot;
+    write_checkpoint_file(snapshot, dir.path("plain.bin"));
+
+    MappedCheckpoint checkpoint(dir.path("plain.bin"), true);
+    CHECK(!checkpoint.is_compact());
+    CHECK_EQ(checkpoint.header().version, CHECKPOINT_VERSION);
+    CHECK_EQ(checkpoint.header().solver_type, 1u);
+    CHECK_EQ(checkpoint.header().config_hash, 0x0123456789abcdefULL);
+    CHECK_EQ(checkpoint.header().iteration, 1234u);
+    CHECK_EQ(checkpoint.solver_state(), std::string("42"));
+    CHECK_EQ(checkpoint.num_infosets(), reference.index.size());
+
+    for (size_t i = 0; i < checkpoint.num_infosets(); ++i) {
+        const CheckpointIndexEntry& entry = checkpoint.entry(i);
+        std::string key = checkpoint.key_of(entry);
+        CHECK_EQ(entry.key_hash, fnv1a_64(key));
+        if (i > 0) {
+            CHECK(checkpoint.entry(i - 1).key_hash <= entry.key_hash);
+        }
+        CHECK(checkpoint.find(key) == &entry);
+        std::vector<double> expected = expected_values(reference, key);
+        CHECK_EQ(expected.size(), 2 * size_t(entry.num_actions));
+        for (size_t v = 0; v < expected.size(); ++v) {
+            CHECK_EQ(checkpoint.values(entry)[v], expected[v]);
+        }
+    }
+    CHECK(checkpoint.find("absent") == nullptr);
+}
+
+// Disposition du format 3 figée: un changement de ces octets doit
+// s'accompagner d'un nouveau CHECKPOINT_VERSION et de la lecture de l'ancien
+POKER_CHECK(checkpoint, plain_format_fingerprint) {
+    checks::TempDir dir;
+    CheckpointSnapshot snapshot = make_snapshot(7);
+    write_checkpoint_file(snapshot, dir.path("plain.bin"));
+    std::string bytes = checks::read_file(dir.path("plain.bin"));
+    CHECK_EQ(bytes.size(), size_t(PLAIN_FORMAT_SIZE));
+    CHECK_EQ(fnv1a_64(bytes), PLAIN_FORMAT_FNV);
+}
+
+POKER_CHECK(checkpoint, rejects_damaged_files) {
+    checks::TempDir dir;
+    CheckpointSnapshot snapshot = make_snapshot(3);
+    write_checkpoint_file(snapshot, dir.path("plain.bin"));
+    std::string bytes = checks::read_file(dir.path("plain.bin"));
+
+    CHECK_THROWS(MappedCheckpoint(dir.path("absent.bin"), false), std::runtime_error);
+
+    std::string bad_magic = bytes;
+    bad_magic[0] = 'X';
+    checks::write_file(dir.path("magic.bin"), bad_magic);
+    CHECK_THROWS(MappedCheckpoint(dir.path("magic.bin"), false), std::runtime_error);
+
+    std::string bad_header = bytes;
+    bad_header[offsetof(CheckpointHeader, iteration)] ^= 1;
+    checks::write_file(dir.path("header.bin"), bad_header);
+    CHECK_THROWS(MappedCheckpoint(dir.path("header.bin"), false), std::runtime_error);
+
+    checks::write_file(dir.path("truncated.bin"), bytes.substr(0, bytes.size() / 2));
+    CHECK_THROWS(MappedCheckpoint(dir.path("truncated.bin"), false), std::runtime_error);
+
+    // Dernier octet de VALUES: détecté par la vérification des sections
+    std::string bad_values = bytes;
+    bad_values[bad_values.size() - 1] ^= 0x40;
+    checks::write_file(dir.path("values.bin"), bad_values);
+    CHECK_THROWS(MappedCheckpoint(dir.path("values.bin"), true), std::runtime_error);
+}
+
+POKER_CHECK(checkpoint, writer_flushes_asynchronous_checkpoints) {
+    checks::TempDir dir;
+    {
+        CheckpointWriter writer(CheckpointEncoding{}, true);
+        for (uint64_t iteration = 1; iteration <= 3; ++iteration) {
+            writer.submit(make_snapshot(iteration), dir.path("async_" + std::to_string(iteration) + ".bin"));
+        }
+        writer.flush();
+    }
+    for (uint64_t iteration = 1; iteration <= 3; ++iteration) {
+        MappedCheckpoint checkpoint(dir.path("async_" + std::to_string(iteration) + ".bin"), true);
+        CHECK_EQ(checkpoint.header().iteration, iteration);
+    }
+}
+
+namespace {
+
+// Valeurs d'un checkpoint compact: à un demi-pas des valeurs d'origine
+void check_quantized(const MappedCheckpoint& checkpoint, const CheckpointSnapshot& reference, double step) {
+    CHECK(checkpoint.is_compact());
+    CHECK_EQ(checkpoint.num_infosets(), reference.index.size());
+    for (size_t i = 0; i < checkpoint.num_infosets(); ++i) {
+        const CheckpointIndexEntry& entry = checkpoint.entry(i);
+        std::vector<double> expected = expected_values(reference, checkpoint.key_of(entry));
+        CHECK_EQ(expected.size(), 2 * size_t(entry.num_actions));
+        for (size_t v = 0; v < expected.size(); ++v) {
+            CHECK_NEAR(checkpoint.values(entry)[v], expected[v], step / 2 * (1 + 1e-9));
+        }
+    }
+}
+
+// Snapshot de l'itération iteration, avec un infoset propre à cette
+// itération et un infoset dont le nombre d'actions change (stockés en
+// valeur absolue dans un delta)
+CheckpointSnapshot make_evolving_snapshot(uint64_t iteration) {
+    CheckpointSnapshot snapshot = make_snapshot(iteration);
+    double values[8] = {1.0 / 3, -2.0 / 7, 5e-7, 1e6 + 0.1, 0.0, 2.5, -1e-3, 12.0};
+    snapshot.add_infoset("only_" + std::to_string(iteration), values, values + 2, 2);
+    size_t resized = 2 + iteration % 2;
+    snapshot.add_infoset("resized", values, values + resized, resized);
+    return snapshot;
+}
+
+// Empreinte de la trame compacte de make_evolving_snapshot(7) (voir compact_format_fingerprint)
+constexpr uint64_t COMPACT_FORMAT_SIZE = 1148;
+constexpr uint64_t COMPACT_FORMAT_FNV = 0x5351a4ca03b2c720ULL;
+
+} // namespace
+
+POKER_CHECK(compact_checkpoint, quantized_round_trip) {
+    checks::TempDir dir;
+    for (double step : {1e-6, 1e-3, 0.25}) {
+        CheckpointEncoding encoding;
+        encoding.compact = true;
+        encoding.quantization_step = step;
+        CheckpointSnapshot snapshot = make_evolving_snapshot(5);
+        CheckpointSnapshot reference = snapshot;
+        write_checkpoint_file(snapshot, dir.path("compact.bin"), encoding);
+
+        MappedCheckpoint checkpoint(dir.path("compact.bin"), true);
+        CHECK_EQ(checkpoint.header().iteration, 5u);
+        CHECK_EQ(checkpoint.solver_state(), std::string("42"));
+        check_quantized(checkpoint, reference, step);
+        CHECK(checkpoint.find("resized") != nullptr);
+    }
+}
+
+POKER_CHECK(compact_checkpoint, delta_chain_and_keyframes) {
+    checks::TempDir dir;
+    CheckpointEncoding encoding;
+    encoding.compact = true;
+    encoding.keyframe_interval = 3;
+    QuantizedFrame previous;
+    std::vector<CheckpointSnapshot> references;
+    for (uint64_t iteration = 1; iteration <= 4; ++iteration) {
+        CheckpointSnapshot snapshot = make_evolving_snapshot(iteration);
+        references.push_back(snapshot);
+        write_checkpoint_file(snapshot, dir.path("chain_" + std::to_string(iteration) + ".bin"), encoding,
+                              &previous);
+    }
+    for (uint64_t iteration = 1; iteration <= 4; ++iteration) {
+        MappedCheckpoint checkpoint(dir.path("chain_" + std::to_string(iteration) + ".bin"), true);
+        check_quantized(checkpoint, references[iteration - 1], encoding.quantization_step);
+    }
+
+    // 2 et 3 sont des deltas de la chaîne de 1; 4 est une trame complète
+    std::remove(dir.path("chain_1.bin").c_str());
+    CHECK_THROWS(MappedCheckpoint(dir.path("chain_2.bin"), false), std::runtime_error);
+    CHECK_THROWS(MappedCheckpoint(dir.path("chain_3.bin"), false), std::runtime_error);
+    MappedCheckpoint keyframe(dir.path("chain_4.bin"), false);
+    check_quantized(keyframe, references[3], encoding.quantization_step);
+}
+
+POKER_CHECK(compact_checkpoint, rejects_out_of_range_values) {
+    checks::TempDir dir;
+    CheckpointEncoding encoding;
+    encoding.compact = true;
+    encoding.quantization_step = 1e-12;
+    CheckpointSnapshot snapshot;
+    double values[2] = {1e300, 0.0};
+    snapshot.add_infoset("huge", values, values + 1, 1);
+    CHECK_THROWS(write_checkpoint_file(snapshot, dir.path("huge.bin"), encoding), std::runtime_error);
+
+    encoding.quantization_step = 0.0;
+    CheckpointSnapshot zero_step = make_snapshot(1);
+    CHECK_THROWS(write_checkpoint_file(zero_step, dir.path("zero.bin"), encoding), std::runtime_error);
+}
+
+// Trame complète compacte figée, comme plain_format_fingerprint
+POKER_CHECK(compact_checkpoint, compact_format_fingerprint) {
+    checks::TempDir dir;
+    CheckpointEncoding encoding;
+    encoding.compact = true;
+    CheckpointSnapshot snapshot = make_evolving_snapshot(7);
+    write_checkpoint_file(snapshot, dir.path("compact.bin"), encoding);
+    std::string bytes = checks::read_file(dir.path("compact.bin"));
+    CHECK_EQ(bytes.size(), size_t(COMPACT_FORMAT_SIZE));
+    CHECK_EQ(fnv1a_64(bytes), COMPACT_FORMAT_FNV);
+}
+
+// Checkpoints périodiques dans checkpoint_dir, répertoires créés au besoin
+POKER_CHECK(checkpoint, periodic_checkpoints_in_checkpoint_dir) {
+    checks::TempDir dir;
+    Json::Value solver_config;
+    solver_config["checkpoint_frequency"] = 10;
+    solver_config["checkpoint_dir"] = dir.path("runs/spot_0");
+    checks::solve_spot(checks::river_params(solver_config), 20);
+    for (int iteration : {10, 20}) {
+        MappedCheckpoint checkpoint(dir.path("runs/spot_0/checkpoint_" + std::to_string(iteration) + ".bin"), true);
+        CHECK_EQ(checkpoint.header().iteration, uint64_t(iteration));
+    }
+}
+
+namespace {
+
+// Fichier de version 3 réécrit en version 2: CheckpointEncodingInfo sans
+// base_header_crc (le nom de la base suit base_iteration), CRC recalculés
+std::string as_version_2(std::string bytes) {
+    CheckpointHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    std::vector<CheckpointSectionEntry> table(header.num_sections);
+    std::memcpy(table.data(), bytes.data() + sizeof(header), table.size() * sizeof(CheckpointSectionEntry));
+    const size_t removed = sizeof(CheckpointEncodingInfo) - offsetof(CheckpointEncodingInfo, base_header_crc);
+    for (auto& section : table) {
+        if (section.id == static_cast<uint32_t>(CheckpointSection::ENCODING)) {
+            char* info = &bytes[section.offset];
+            std::memmove(info + offsetof(CheckpointEncodingInfo, base_header_crc), info + sizeof(CheckpointEncodingInfo),
+                         section.size - sizeof(CheckpointEncodingInfo));
+            section.size -= removed;
+            section.raw_size -= removed;
+            section.crc = crc32(info, section.size);
+        }
+    }
+    header.version = 2;
+    header.header_crc = 0;
+    header.header_crc = crc32(&header, sizeof(header));
+    header.header_crc = crc32(table.data(), table.size() * sizeof(CheckpointSectionEntry), header.header_crc);
+    std::memcpy(&bytes[0], &header, sizeof(header));
+    std::memcpy(&bytes[sizeof(header)], table.data(), table.size() * sizeof(CheckpointSectionEntry));
+    return bytes;
+}
+
+} // namespace
+
+// Fichiers de version 2 (bruts et compacts) toujours lisibles
+POKER_CHECK(compact_checkpoint, reads_version_2) {
+    checks::TempDir dir;
+    CheckpointSnapshot plain = make_snapshot(4);
+    CheckpointSnapshot plain_reference = plain;
+    write_checkpoint_file(plain, dir.path("plain.bin"));
+    checks::write_file(dir.path("plain.bin"), as_version_2(checks::read_file(dir.path("plain.bin"))));
+    MappedCheckpoint plain_v2(dir.path("plain.bin"), true);
+    CHECK_EQ(plain_v2.header().version, 2u);
+    CHECK_EQ(plain_v2.num_infosets(), plain_reference.index.size());
+    for (size_t i = 0; i < plain_v2.num_infosets(); ++i) {
+        const CheckpointIndexEntry& entry = plain_v2.entry(i);
+        std::vector<double> expected = expected_values(plain_reference, plain_v2.key_of(entry));
+        CHECK(std::equal(expected.begin(), expected.end(), plain_v2.values(entry)));
+    }
+
+    CheckpointEncoding encoding;
+    encoding.compact = true;
+    QuantizedFrame previous;
+    std::vector<CheckpointSnapshot> references;
+    for (uint64_t iteration = 1; iteration <= 2; ++iteration) {
+        CheckpointSnapshot snapshot = make_evolving_snapshot(iteration);
+        references.push_back(snapshot);
+        std::string filename = dir.path("chain_" + std::to_string(iteration) + ".bin");
+        write_checkpoint_file(snapshot, filename, encoding, &previous);
+        checks::write_file(filename, as_version_2(checks::read_file(filename)));
+    }
+    MappedCheckpoint delta_v2(dir.path("chain_2.bin"), true);
+    CHECK_EQ(delta_v2.header().version, 2u);
+    check_quantized(delta_v2, references[1], encoding.quantization_step);
+}
+
+// Un delta n'est décodé que contre la base dont il a été tiré, même si une
+// autre résolution a écrit un fichier de même nom et de même itération
+POKER_CHECK(compact_checkpoint, rejects_foreign_base) {
+    checks::TempDir dir;
+    CheckpointEncoding encoding;
+    encoding.compact = true;
+    QuantizedFrame ours;
+    QuantizedFrame theirs;
+    for (uint64_t iteration = 1; iteration <= 2; ++iteration) {
+        std::string name = "chain_" + std::to_string(iteration) + ".bin";
+        CheckpointSnapshot snapshot = make_evolving_snapshot(iteration);
+        CheckpointSnapshot other = snapshot;
+        other.values[0] += 1.0;
+        write_checkpoint_file(snapshot, dir.path(name), encoding, &ours);
+        write_checkpoint_file(other, dir.path("other_" + name), encoding, &theirs);
+    }
+    MappedCheckpoint(dir.path("chain_2.bin"), false);
+    checks::write_file(dir.path("chain_1.bin"), checks::read_file(dir.path("other_chain_1.bin")));
+    CHECK_THROWS(MappedCheckpoint(dir.path("chain_2.bin"), false), std::runtime_error);
+}
+
+POKER_CHECK(compact_checkpoint, bounds_delta_chains) {
+    checks::TempDir dir;
+    CheckpointEncoding encoding;
+    encoding.compact = true;
+
+    // Delta qui se désigne lui-même comme base (même nom, même itération)
+    QuantizedFrame self;
+    for (int write = 0; write < 2; ++write) {
+        CheckpointSnapshot snapshot = make_evolving_snapshot(5);
+        write_checkpoint_file(snapshot, dir.path("self.bin"), encoding, &self);
+    }
+    CHECK_EQ(self.chain_length, 1);
+    CHECK_THROWS(MappedCheckpoint(dir.path("self.bin"), false), std::runtime_error);
+
+    // keyframe_interval au-delà de la borne: trame complète après
+    // MAX_DELTA_CHAIN_LENGTH deltas, chaîne la plus longue lisible
+    encoding.keyframe_interval = 4 * MAX_DELTA_CHAIN_LENGTH;
+    QuantizedFrame previous;
+    for (int i = 0; i <= MAX_DELTA_CHAIN_LENGTH + 1; ++i) {
+        CheckpointSnapshot snapshot;
+        snapshot.iteration = static_cast<uint64_t>(i) + 1;
+        double values[2] = {double(i), 1.0};
+        snapshot.add_infoset("node", values, values + 1, 1);
+        write_checkpoint_file(snapshot, dir.path("long_" + std::to_string(i) + ".bin"), encoding, &previous);
+    }
+    CHECK_EQ(previous.chain_length, 0);
+    MappedCheckpoint longest(dir.path("long_" + std::to_string(MAX_DELTA_CHAIN_LENGTH) + ".bin"), false);
+    CHECK_EQ(longest.values(*longest.find("node"))[0], double(MAX_DELTA_CHAIN_LENGTH));
+    std::remove(dir.path("long_0.bin").c_str());
+    MappedCheckpoint keyframe(dir.path("long_" + std::to_string(MAX_DELTA_CHAIN_LENGTH + 1) + ".bin"), false);
+    CHECK_EQ(keyframe.values(*keyframe.find("node"))[0], double(MAX_DELTA_CHAIN_LENGTH + 1));
+}
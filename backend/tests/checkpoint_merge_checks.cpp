@@ -0,0 +1,121 @@
+#include "check.h"
+#include "poker/cfr_solver.h"
+#include "poker/checkpoint.h"
+#include "poker/checkpoint_merge.h"
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace poker;
+
+namespace {
+
+// Infoset "key" de num_actions actions: regrets base + a, sommes 10 * base + a
+void add_infoset(CheckpointSnapshot& snapshot, const std::string& key, size_t num_actions, double base) {
+    std::vector<double> regrets(num_actions);
+    std::vector<double> strategy(num_actions);
+    for (size_t a = 0; a < num_actions; ++a) {
+        regrets[a] = base + a;
+        strategy[a] = 10 * base + a;
+    }
+    snapshot.add_infoset(key, regrets.data(), strategy.data(), num_actions);
+}
+
+CheckpointSnapshot make_run(uint64_t iterations) {
+    CheckpointSnapshot snapshot;
+    snapshot.solver_type = static_cast<uint32_t>(SolverType::CHANCE_SAMPLING_CFR);
+    snapshot.config_hash = 0xfeedULL;
+    snapshot.iteration = iterations;
+    snapshot.solver_state = "rng";
+    return snapshot;
+}
+
+void check_values(const MappedCheckpoint& checkpoint, const std::string& key, const std::vector<double>& expected) {
+    const CheckpointIndexEntry* entry = checkpoint.find(key);
+    CHECK(entry != nullptr);
+    CHECK_EQ(2 * size_t(entry->num_actions), expected.size());
+    for (size_t v = 0; v < expected.size(); ++v) {
+        CHECK_EQ(checkpoint.values(*entry)[v], expected[v]);
+    }
+}
+
+} // namespace
+
+POKER_CHECK(checkpoint_merge, sums_overlapping_and_disjoint_infosets) {
+    checks::TempDir dir;
+    CheckpointSnapshot first = make_run(100);
+    add_infoset(first, "shared", 3, 1.5);
+    add_infoset(first, "first_only", 2, -4.0);
+    write_checkpoint_file(first, dir.path("first.bin"));
+
+    CheckpointSnapshot second = make_run(250);
+    add_infoset(second, "shared", 3, -0.25);
+    add_infoset(second, "second_only", 1, 8.0);
+    write_checkpoint_file(second, dir.path("second.bin"));
+
+    // Entrée compacte: valeurs multiples du pas, donc exactes
+    CheckpointEncoding encoding;
+    encoding.compact = true;
+    encoding.quantization_step = 0.25;
+    CheckpointSnapshot third = make_run(50);
+    add_infoset(third, "shared", 3, 2.0);
+    write_checkpoint_file(third, dir.path("third.bin"), encoding);
+
+    CheckpointMergeSummary summary = merge_checkpoint_files(
+        {dir.path("first.bin"), dir.path("second.bin"), dir.path("third.bin")}, dir.path("merged.bin"));
+    CHECK_EQ(summary.iterations, 400u);
+    CHECK_EQ(summary.infosets, 3u);
+
+    MappedCheckpoint merged(dir.path("merged.bin"), true);
+    CHECK(!merged.is_compact());
+    CHECK_EQ(merged.header().solver_type, uint32_t(SolverType::CHANCE_SAMPLING_CFR));
+    CHECK_EQ(merged.header().config_hash, 0xfeedULL);
+    CHECK_EQ(merged.header().iteration, 400u);
+    CHECK_EQ(merged.num_infosets(), 3u);
+    // Bases 1.5 - 0.25 + 2.0: regrets 3 * a + 3.25, sommes 3 * a + 32.5
+    check_values(merged, "shared", {3.25, 6.25, 9.25, 32.5, 35.5, 38.5});
+    check_values(merged, "first_only", {-4.0, -3.0, -40.0, -39.0});
+    check_values(merged, "second_only", {8.0, 80.0});
+    for (size_t i = 1; i < merged.num_infosets(); ++i) {
+        CHECK(merged.entry(i - 1).key_hash <= merged.entry(i).key_hash);
+    }
+    CHECK(::access(dir.path("merged.bin.tmp").c_str(), F_OK) != 0);
+}
+
+POKER_CHECK(checkpoint_merge, rejects_incompatible_inputs) {
+    checks::TempDir dir;
+    CheckpointSnapshot reference = make_run(10);
+    add_infoset(reference, "node", 2, 1.0);
+    write_checkpoint_file(reference, dir.path("reference.bin"));
+
+    CheckpointSnapshot resized = make_run(10);
+    add_infoset(resized, "node", 3, 1.0);
+    write_checkpoint_file(resized, dir.path("resized.bin"));
+    CHECK_THROWS(merge_checkpoint_files({dir.path("reference.bin"), dir.path("resized.bin")}, dir.path("out.bin")),
+                 std::runtime_error);
+
+    CheckpointSnapshot other_config = make_run(10);
+    other_config.config_hash ^= 1;
+    add_infoset(other_config, "node", 2, 1.0);
+    write_checkpoint_file(other_config, dir.path("config.bin"));
+    CHECK_THROWS(merge_checkpoint_files({dir.path("reference.bin"), dir.path("config.bin")}, dir.path("out.bin")),
+                 std::runtime_error);
+
+    // Regrets pondérés (discounting de VanillaCFR) ou tronqués (CFR+): pas de somme
+    for (SolverType type : {SolverType::VANILLA_CFR, SolverType::CFR_PLUS}) {
+        CheckpointSnapshot other_solver = make_run(10);
+        other_solver.solver_type = static_cast<uint32_t>(type);
+        add_infoset(other_solver, "node", 2, 1.0);
+        write_checkpoint_file(other_solver, dir.path("solver.bin"));
+        CHECK_THROWS(merge_checkpoint_files({dir.path("reference.bin"), dir.path("solver.bin")}, dir.path("out.bin")),
+                     std::runtime_error);
+        CHECK_THROWS(merge_checkpoint_files({dir.path("solver.bin"), dir.path("solver.bin")}, dir.path("out.bin")),
+                     std::runtime_error);
+    }
+
+    CHECK_THROWS(merge_checkpoint_files({}, dir.path("out.bin")), std::runtime_error);
+    CHECK_THROWS(merge_checkpoint_files({dir.path("absent.bin")}, dir.path("out.bin")), std::runtime_error);
+    // Aucune sortie, même partielle, après un échec
+    CHECK(::access(dir.path("out.bin").c_str(), F_OK) != 0);
+    CHECK(::access(dir.path("out.bin.tmp").c_str(), F_OK) != 0);
+}
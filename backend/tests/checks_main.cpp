@@ -0,0 +1,126 @@
+#include "check.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <unistd.h>
+
+namespace poker {
+namespace checks {
+
+namespace {
+
+struct RegisteredCheck {
+    const char* group;
+    const char* name;
+    CheckFunction function;
+};
+
+std::vector<RegisteredCheck>& registry() {
+    static std::vector<RegisteredCheck> checks;
+    return checks;
+}
+
+void remove_tree(const std::string& path) {
+    if (DIR* dir = ::opendir(path.c_str())) {
+        while (dirent* entry = ::readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name != "." && name != "..") {
+                remove_tree(path + "/" + name);
+            }
+        }
+        ::closedir(dir);
+        ::rmdir(path.c_str());
+    } else {
+        ::unlink(path.c_str());
+    }
+}
+
+} // namespace
+
+int register_check(const char* group, const char* name, CheckFunction function) {
+    registry().push_back({group, name, function});
+    return 0;
+}
+
+void fail(const char* file, int line, const std::string& message) {
+    throw CheckFailure(std::string(file) + ":" + std::to_string(line) + ": " + message);
+}
+
+TempDir::TempDir() {
+    const char* base = std::getenv("TMPDIR");
+    std::string pattern = std::string(base && *base ? base : "/tmp") + "/poker_checks.XXXXXX";
+    std::vector<char> buffer(pattern.begin(), pattern.end());
+    buffer.push_back('\0');
+    if (!::mkdtemp(buffer.data())) {
+        throw CheckFailure("mkdtemp impossible: " + std::string(std::strerror(errno)));
+    }
+    path_ = buffer.data();
+}
+
+TempDir::~TempDir() {
+    remove_tree(path_);
+}
+
+std::string read_file(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        throw CheckFailure("Fichier illisible: " + filename);
+    }
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void write_file(const std::string& filename, const std::string& contents) {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    if (!file) {
+        throw CheckFailure("Écriture impossible: " + filename);
+    }
+}
+
+} // namespace checks
+} // namespace poker
+
+// poker_checks [groupe...]: toutes les vérifications des groupes donnés
+// (toutes sans argument). Code de sortie 1 si l'une échoue.
+int main(int argc, char** argv) {
+    using poker::checks::registry;
+    std::vector<std::string> groups(argv + 1, argv + argc);
+    auto selected = [&groups](const char* group) {
+        if (groups.empty()) return true;
+        for (const std::string& name : groups) {
+            if (name == group) return true;
+        }
+        return false;
+    };
+
+    // Les messages du solveur (checkpoints sauvegardés...) restent hors du rapport
+    std::cout.setstate(std::ios::failbit);
+
+    int run = 0;
+    int failed = 0;
+    for (const auto& check : registry()) {
+        if (!selected(check.group)) {
+            continue;
+        }
+        ++run;
+        try {
+            check.function();
+            std::cerr << "OK     " << check.group << "." << check.name << std::endl;
+        } catch (const std::exception& e) {
+            ++failed;
+            std::cerr << "ÉCHEC  " << check.group << "." << check.name << ": " << e.what() << std::endl;
+        }
+    }
+    if (run == 0) {
+        std::cerr << "Aucune vérification pour ce groupe" << std::endl;
+        return 1;
+    }
+    std::cerr << run - failed << "/" << run << " vérifications réussies" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#include "check.h"
+#include "poker/binary_io.h"
+#include "poker/compression.h"
+#include <string>
+
+using namespace poker;
+
+namespace {
+
+// Octets pseudo-aléatoires reproductibles (xorshift)
+std::string noise(size_t size, uint64_t state) {
+    std::string bytes(size, '\0');
+    for (char& byte : bytes) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        byte = static_cast<char>(state);
+    }
+    return bytes;
+}
+
+std::string round_trip(const std::string& input) {
+    std::string block = compress_block(input.data(), input.size());
+    std::string output(input.size(), '\0');
+    decompress_block(block.data(), block.size(), output.empty() ? nullptr : &output[0], output.size());
+    return output;
+}
+
+// Compression d'une entrée fixe (voir compressed_format_fingerprint)
+constexpr uint64_t COMPRESSED_FORMAT_SIZE = 16624;
+constexpr uint64_t COMPRESSED_FORMAT_FNV = 0x21404c261b9a7d3fULL;
+
+std::string fingerprint_input() {
+    std::string input;
+    for (int i = 0; i < 2000; ++i) {
+        input += "p" + std::to_string(i % 2) + "_s3_pot" + std::to_string(6 + i % 17) + "_board";
+        input += noise(i % 7, i + 1);
+    }
+    return input;
+}
+
+} // namespace
+
+POKER_CHECK(compression, round_trips) {
+    CHECK_EQ(round_trip(""), std::string());
+    CHECK_EQ(round_trip("x"), std::string("x"));
+    CHECK_EQ(round_trip("abcabcabcabcabcabcabcabcabc"), std::string("abcabcabcabcabcabcabcabcabc"));
+    std::string zeros(1 << 20, '\0');
+    CHECK(round_trip(zeros) == zeros);
+    std::string random = noise(100000, 1);
+    CHECK(round_trip(random) == random);
+
+    // Répétitions au-delà de la fenêtre de 64 Ko (offset sur 16 bits)
+    std::string far = noise(70000, 2);
+    far += far.substr(0, 5000) + noise(1000, 3) + far;
+    CHECK(round_trip(far) == far);
+
+    std::string input = fingerprint_input();
+    CHECK(round_trip(input) == input);
+    for (size_t size : {size_t(1), size_t(15), size_t(16), size_t(255), size_t(256), size_t(70000)}) {
+        std::string part = far.substr(0, size);
+        CHECK(round_trip(part) == part);
+    }
+}
+
+POKER_CHECK(compression, compresses_redundant_data) {
+    std::string zeros(1 << 20, '\0');
+    CHECK(compress_block(zeros.data(), zeros.size()).size() < zeros.size() / 100);
+    std::string input = fingerprint_input();
+    CHECK(compress_block(input.data(), input.size()).size() < input.size() / 2);
+    // Données incompressibles: surcoût borné
+    std::string random = noise(100000, 4);
+    CHECK(compress_block(random.data(), random.size()).size() < random.size() + random.size() / 100 + 64);
+}
+
+POKER_CHECK(compression, rejects_corrupt_blocks) {
+    std::string input = fingerprint_input();
+    std::string block = compress_block(input.data(), input.size());
+    std::string output(input.size() + 1, '\0');
+    CHECK_THROWS(decompress_block(block.data(), block.size(), &output[0], input.size() + 1), std::runtime_error);
+    CHECK_THROWS(decompress_block(block.data(), block.size(), &output[0], input.size() - 1), std::runtime_error);
+    CHECK_THROWS(decompress_block(block.data(), block.size() / 2, &output[0], input.size()), std::runtime_error);
+}
+
+// Les checkpoints compacts stockent ces blocs: leur format est figé
+POKER_CHECK(compression, compressed_format_fingerprint) {
+    std::string input = fingerprint_input();
+    std::string block = compress_block(input.data(), input.size());
+    CHECK_EQ(block.size(), size_t(COMPRESSED_FORMAT_SIZE));
+    CHECK_EQ(fnv1a_64(block), COMPRESSED_FORMAT_FNV);
+}
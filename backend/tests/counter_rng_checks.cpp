@@ -0,0 +1,148 @@
+#include "check.h"
+#include "solver_fixture.h"
+#include "poker/counter_rng.h"
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace poker;
+
+namespace {
+
+void check_block(const uint32_t counter[4], const uint32_t key[2], const uint32_t expected[4]) {
+    uint32_t block[4];
+    CounterRng::philox4x32_10(counter, key, block);
+    for (int i = 0; i < 4; ++i) {
+        CHECK_EQ(block[i], expected[i]);
+    }
+}
+
+constexpr uint64_t GOLDEN_SEED = 0x0123456789abcdefULL;
+
+} // namespace
+
+// Vecteurs de référence philox4x32_10 de Random123 (kat_vectors)
+POKER_CHECK(counter_rng, philox_known_answers) {
+    const uint32_t zero_counter[4] = {0, 0, 0, 0};
+    const uint32_t zero_key[2] = {0, 0};
+    const uint32_t zero_block[4] = {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+    check_block(zero_counter, zero_key, zero_block);
+
+    const uint32_t ones_counter[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+    const uint32_t ones_key[2] = {0xffffffff, 0xffffffff};
+    const uint32_t ones_block[4] = {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd};
+    check_block(ones_counter, ones_key, ones_block);
+
+    const uint32_t pi_counter[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+    const uint32_t pi_key[2] = {0xa4093822, 0x299f31d0};
+    const uint32_t pi_block[4] = {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1};
+    check_block(pi_counter, pi_key, pi_block);
+}
+
+// Compteur {bloc, itération, flux} sous la clé de la graine
+POKER_CHECK(counter_rng, counter_layout) {
+    const uint64_t iteration = 0x0000000500000007ULL;
+    CounterRng rng(GOLDEN_SEED, iteration, 9);
+    const uint32_t key[2] = {0x89abcdef, 0x01234567};
+    for (uint32_t block_number = 0; block_number < 3; ++block_number) {
+        const uint32_t counter[4] = {block_number, 7, 5, 9};
+        uint32_t block[4];
+        CounterRng::philox4x32_10(counter, key, block);
+        for (uint32_t value : block) {
+            CHECK_EQ(rng(), value);
+        }
+    }
+}
+
+// Tirages figés: une graine doit redonner les mêmes donnes et les mêmes
+// chemins échantillonnés d'une version à l'autre
+POKER_CHECK(counter_rng, golden_draws) {
+    CounterRng raw(GOLDEN_SEED, 42, 3);
+    for (uint32_t expected : {0xc68e448eu, 0x9f8d3c02u, 0x58587326u, 0x1c895b27u, 0x08c09b01u, 0xaa4e6645u}) {
+        CHECK_EQ(raw(), expected);
+    }
+
+    CounterRng below(GOLDEN_SEED, 42, 3);
+    for (uint32_t expected : {40u, 32u, 17u, 5u, 1u, 34u}) {
+        CHECK_EQ(below.below(52), expected);
+    }
+
+    CounterRng uniform(GOLDEN_SEED, 42, 3);
+    for (double expected : {0.77560833436978249, 0.34509963684516742, 0.034188926607663372}) {
+        CHECK_EQ(uniform.uniform(), expected);
+    }
+
+    CounterRng sample(GOLDEN_SEED, 42, 3);
+    for (size_t expected : {3u, 2u, 0u, 2u, 2u, 3u, 3u, 2u}) {
+        CHECK_EQ(sample.sample({0.5, 0.0, 1.5, 2.0}), expected);
+    }
+}
+
+POKER_CHECK(counter_rng, draw_ranges) {
+    CounterRng rng(7, 0);
+    std::vector<int> counts(5, 0);
+    for (int i = 0; i < 5000; ++i) {
+        uint32_t value = rng.below(5);
+        CHECK(value < 5);
+        ++counts[value];
+        double u = rng.uniform();
+        CHECK(u >= 0.0 && u < 1.0);
+        // Poids nul jamais tiré; somme nulle: uniforme
+        CHECK(rng.sample({0.0, 1.0, 0.0, 2.0}) % 2 == 1);
+        CHECK(rng.sample({0.0, 0.0, 0.0}) < 3);
+    }
+    for (int count : counts) {
+        CHECK(count > 850 && count < 1150);
+    }
+}
+
+namespace {
+
+using InfosetValues = std::map<std::string, std::vector<double>>;
+
+// Regrets puis sommes des stratégies de chaque infoset de l'arbre
+InfosetValues values_of(const CFRSolver& solver) {
+    InfosetValues values;
+    solver.for_each_infoset([&values](const std::string& key, const GameNode& node) {
+        std::vector<double>& infoset = values[key];
+        infoset.assign(node.regret_sum.begin(), node.regret_sum.end());
+        infoset.insert(infoset.end(), node.strategy_sum.begin(), node.strategy_sum.end());
+    });
+    return values;
+}
+
+Json::Value seeded_params(int seed) {
+    Json::Value solver_config;
+    solver_config["seed"] = seed;
+    return checks::river_params(solver_config);
+}
+
+} // namespace
+
+POKER_CHECK(seeded_solve, same_seed_same_values) {
+    InfosetValues first = values_of(*checks::solve_spot(seeded_params(17), 40));
+    InfosetValues second = values_of(*checks::solve_spot(seeded_params(17), 40));
+    CHECK(!first.empty());
+    CHECK(first == second);
+
+    InfosetValues other = values_of(*checks::solve_spot(seeded_params(18), 40));
+    CHECK_EQ(other.size(), first.size());
+    CHECK(other != first);
+}
+
+// Les tirages d'une itération ne dépendent que de la graine et de son
+// numéro: 30 + 30 itérations avec reprise = 60 itérations d'un trait
+POKER_CHECK(seeded_solve, resume_matches_straight_run) {
+    checks::TempDir dir;
+    Json::Value params = seeded_params(17);
+    InfosetValues straight = values_of(*checks::solve_spot(params, 60));
+
+    std::unique_ptr<CFRSolver> first_half = checks::solve_spot(params, 30);
+    first_half->write_checkpoint(dir.path("half.bin"));
+
+    std::unique_ptr<CFRSolver> resumed = checks::create_spot_solver(params);
+    resumed->read_checkpoint(dir.path("half.bin"));
+    CHECK_EQ(resumed->current_iteration(), 30);
+    checks::run_iterations(*resumed, params, 30);
+    CHECK(values_of(*resumed) == straight);
+}
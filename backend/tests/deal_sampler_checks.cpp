@@ -0,0 +1,161 @@
+#include "check.h"
+#include "poker/deal_sampler.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace poker;
+
+namespace {
+
+Hand hand_of(const std::string& text) {
+    std::vector<Card> cards = parse_cards(text);
+    return Hand(cards[0], cards[1]);
+}
+
+double total_weight(const HandRange& range) {
+    double total = 0.0;
+    for (const auto& combo : range) {
+        total += combo.second;
+    }
+    return total;
+}
+
+// Fréquence de chaque donne des ranges (mains des joueurs, dans l'ordre)
+std::map<std::string, double> joint_frequencies(const DealSampler& sampler, int deals) {
+    std::map<std::string, double> frequencies;
+    Deal deal;
+    for (int i = 0; i < deals; ++i) {
+        CounterRng rng(5, static_cast<uint64_t>(i));
+        sampler.deal(rng, deal);
+        std::string key;
+        for (const Hand& hand : deal.hands) {
+            key += hand_to_string(hand) + " ";
+        }
+        frequencies[key] += 1.0 / deals;
+    }
+    return frequencies;
+}
+
+} // namespace
+
+POKER_CHECK(deal_sampler, parses_range_notation) {
+    CHECK_EQ(parse_hand_range("QQ").size(), 6u);
+    CHECK_EQ(parse_hand_range("99+").size(), 36u);
+    CHECK_EQ(parse_hand_range("AKs").size(), 4u);
+    CHECK_EQ(parse_hand_range("AKo").size(), 12u);
+    CHECK_EQ(parse_hand_range("AK").size(), 16u);
+    CHECK_EQ(parse_hand_range("KA").size(), 16u);
+    CHECK_EQ(parse_hand_range("ATs+").size(), 16u);
+    CHECK_EQ(parse_hand_range("ATo+").size(), 48u);
+    CHECK_EQ(parse_hand_range(" QQ , AKs ,").size(), 10u);
+    CHECK(parse_hand_range("").empty());
+
+    HandRange explicit_combo = parse_hand_range("AhKh:2.5");
+    CHECK_EQ(explicit_combo.size(), 1u);
+    CHECK(explicit_combo[0].first == hand_of("AhKh"));
+    CHECK_EQ(explicit_combo[0].second, 2.5);
+    for (const auto& combo : parse_hand_range("AKs+")) {
+        CHECK(combo.first.first.suit() == combo.first.second.suit());
+    }
+    CHECK_EQ(total_weight(parse_hand_range("QQ:0.5,AhKh,AhKh:2")), 6.0);
+
+    for (const char* invalid : {"QQs", "AKx", "A", "AKQs", "ZZ", "QQ:", "QQ:-1", "QQ:abc", "QQ:1x", "QQ:inf",
+                                "AhAh7c"}) {
+        CHECK_THROWS(parse_hand_range(invalid), std::invalid_argument);
+    }
+}
+
+POKER_CHECK(deal_sampler, deals_without_conflicts) {
+    Board board = parse_cards("As Kd 7h");
+    DealSampler sampler(board, 3);
+    sampler.set_range(1, parse_hand_range("AA,KK,77,AK"));
+    Deal deal;
+    for (uint64_t iteration = 0; iteration < 2000; ++iteration) {
+        CounterRng rng(11, iteration);
+        sampler.deal(rng, deal);
+        CHECK_EQ(deal.hands.size(), 3u);
+        CHECK_EQ(deal.board.size(), 5u);
+        for (size_t i = 0; i < board.size(); ++i) {
+            CHECK(deal.board[i] == board[i]);
+        }
+        uint64_t used = 0;
+        auto take = [&used](const Card& card) {
+            CHECK(!(used & (uint64_t(1) << card.index())));
+            used |= uint64_t(1) << card.index();
+        };
+        for (const Card& card : deal.board) {
+            take(card);
+        }
+        for (const Hand& hand : deal.hands) {
+            take(hand.first);
+            take(hand.second);
+        }
+        // Combinaisons de AA, KK, 77 ou AK qui ne touchent pas le tableau
+        int high = static_cast<int>(deal.hands[1].first.rank());
+        int low = static_cast<int>(deal.hands[1].second.rank());
+        CHECK((high == low && (high == 14 || high == 13 || high == 7)) || high + low == 27);
+    }
+}
+
+POKER_CHECK(deal_sampler, follows_range_weights) {
+    DealSampler sampler(parse_cards("2c 3d 4h 5s 7c"), 2);
+    sampler.set_range(0, parse_hand_range("AA:1,KK:3"));
+    std::map<std::string, double> frequencies = joint_frequencies(sampler, 40000);
+    double kings = 0.0;
+    for (const auto& [key, frequency] : frequencies) {
+        if (key[0] == 'K') {
+            kings += frequency;
+        }
+    }
+    CHECK_NEAR(kings, 0.75, 0.01);
+}
+
+// Donne des ranges rejetée en bloc en cas de conflit: chaque donne
+// compatible garde une probabilité proportionnelle au produit des poids
+// (un tirage joueur par joueur donnerait 1/2 à AhKh + QcQd)
+POKER_CHECK(deal_sampler, exact_joint_distribution) {
+    Board board = parse_cards("2c 3d 4h");
+    DealSampler sampler(board, 2);
+    sampler.set_range(0, parse_hand_range("AhKh,AsKs"));
+    sampler.set_range(1, parse_hand_range("AhQd,QcQd"));
+    std::map<std::string, double> frequencies = joint_frequencies(sampler, 30000);
+    CHECK_EQ(frequencies.size(), 3u);
+    for (const auto& [key, frequency] : frequencies) {
+        CHECK(key.find("Ah") == key.rfind("Ah"));
+        CHECK_NEAR(frequency, 1.0 / 3, 0.015);
+    }
+
+    sampler.set_range(0, parse_hand_range("AhKh:2,AsKs"));
+    frequencies = joint_frequencies(sampler, 30000);
+    CHECK_EQ(frequencies.size(), 3u);
+    CHECK_NEAR(frequencies[hand_to_string(hand_of("AhKh")) + " " + hand_to_string(hand_of("QcQd")) + " "], 0.5,
+               0.015);
+}
+
+POKER_CHECK(deal_sampler, rejects_impossible_ranges) {
+    Board board = parse_cards("Ah 7c 2d");
+    DealSampler sampler(board, 2);
+    CHECK_THROWS(sampler.set_range(-1, parse_hand_range("QQ")), std::invalid_argument);
+    CHECK_THROWS(sampler.set_range(2, parse_hand_range("QQ")), std::invalid_argument);
+    // Toutes les combinaisons touchent le tableau, ou sont de poids nul
+    CHECK_THROWS(sampler.set_range(0, parse_hand_range("AhKh,7c7d")), std::invalid_argument);
+    CHECK_THROWS(sampler.set_range(0, parse_hand_range("QQ:0")), std::invalid_argument);
+
+    sampler.set_range(0, parse_hand_range("KsKh"));
+    sampler.set_range(1, parse_hand_range("KsQs"));
+    Deal deal;
+    CounterRng rng(3, 0);
+    CHECK_THROWS(sampler.deal(rng, deal), std::runtime_error);
+
+    // Range vide: retour aux mains uniformes
+    sampler.set_range(1, HandRange());
+    sampler.deal(rng, deal);
+    CHECK(deal.hands[0] == hand_of("KsKh"));
+
+    CHECK_THROWS(DealSampler(Board(), 24), std::invalid_argument);
+    DealSampler crowded(Board(), 23);
+    crowded.deal(rng, deal);
+    CHECK_EQ(deal.board.size(), 5u);
+}
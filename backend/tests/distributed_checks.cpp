@@ -0,0 +1,103 @@
+#include "check.h"
+#include "solver_fixture.h"
+#include "poker/distributed_cfr.h"
+#include "poker/solve_job.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace poker;
+
+namespace {
+
+constexpr int NUM_WORKERS = 2;
+constexpr int ITERATIONS = 20;
+
+using InfosetValues = std::map<std::string, std::vector<double>>;
+
+// Regrets puis sommes des stratégies de chaque infoset de l'arbre
+InfosetValues values_of(const CFRSolver& solver) {
+    InfosetValues values;
+    solver.for_each_infoset([&values](const std::string& key, const GameNode& node) {
+        std::vector<double>& infoset = values[key];
+        infoset.assign(node.regret_sum.begin(), node.regret_sum.end());
+        infoset.insert(infoset.end(), node.strategy_sum.begin(), node.strategy_sum.end());
+    });
+    return values;
+}
+
+// Spot du banc pour VanillaCFR (la graine est réservée aux solveurs par échantillonnage)
+Json::Value exhaustive_params() {
+    Json::Value params = checks::river_params();
+    params["solver_config"].removeMember("seed");
+    return params;
+}
+
+// Workers rejoints à la destruction: déclaré avant le coordinateur, dont
+// la destruction ferme les connexions qui les retiendraient
+struct WorkerThreads {
+    std::vector<std::thread> threads;
+    std::vector<int> status = std::vector<int>(NUM_WORKERS, -1);
+
+    ~WorkerThreads() {
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+};
+
+} // namespace
+
+// Coordinateur et deux workers (threads, socket Unix): mêmes regrets à la
+// racine qu'un VanillaCFR en un seul processus, mêmes infosets réunis
+POKER_CHECK(distributed, matches_single_process) {
+    checks::TempDir dir;
+    Json::Value params = exhaustive_params();
+    CFRConfig config = parse_solver_config(params["solver_config"]);
+    GameState root = parse_game_config(params["game_config"]);
+
+    std::unique_ptr<VanillaCFR> single = create_exhaustive_solver("postflop", std::make_shared<BasicAbstraction>(),
+                                                                  config, params["game_config"]);
+    checks::run_iterations(*single, params, ITERATIONS);
+
+    DistributedOptions options;
+    options.address = dir.path("coordinator.sock");
+    options.workers = NUM_WORKERS;
+    WorkerThreads workers;
+    DistributedCFR distributed(std::make_shared<BasicAbstraction>(), config, options, "postflop", params);
+    for (int w = 0; w < NUM_WORKERS; ++w) {
+        workers.threads.emplace_back([&workers, &options, w] {
+            workers.status[w] = run_distributed_worker(options.address);
+        });
+    }
+    checks::run_iterations(distributed, params, ITERATIONS);
+    for (std::thread& thread : workers.threads) {
+        thread.join();
+    }
+    workers.threads.clear();
+    for (int status : workers.status) {
+        CHECK_EQ(status, 0);
+    }
+
+    InfosetValues expected = values_of(*single);
+    InfosetValues actual = values_of(distributed);
+    CHECK(expected.size() > 1);
+    CHECK_EQ(actual.size(), expected.size());
+    for (const auto& [key, values] : expected) {
+        auto it = actual.find(key);
+        CHECK(it != actual.end());
+        CHECK_EQ(it->second.size(), values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            CHECK_NEAR(it->second[i], values[i], 1e-9);
+        }
+    }
+
+    std::vector<double> root_strategy = single->get_strategy(root, root.current_player);
+    std::vector<double> distributed_root = distributed.get_strategy(root, root.current_player);
+    CHECK_EQ(distributed_root.size(), root_strategy.size());
+    for (size_t i = 0; i < root_strategy.size(); ++i) {
+        CHECK_NEAR(distributed_root[i], root_strategy[i], 1e-12);
+    }
+}
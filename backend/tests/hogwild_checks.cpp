@@ -0,0 +1,123 @@
+#include "check.h"
+#include "solver_fixture.h"
+#include "poker/concurrent_node_index.h"
+#include "poker/game_tree.h"
+#include "poker/solve_job.h"
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace poker;
+
+namespace {
+
+constexpr int NUM_KEYS = 20000;
+constexpr int NUM_WRITERS = 4;
+constexpr int NUM_READERS = 4;
+
+// Seaux partagés: 256 hachages pour 20000 clés, chaînes longues et clés
+// distinctes sous un même hachage
+uint64_t colliding_hash(const std::string& key) {
+    return std::hash<std::string>{}(key) & 0xff;
+}
+
+// Infosets d'une résolution seedée de 40 itérations en un seul bloc
+// parallèle (rappel toutes les 40 itérations, pas de mesure d'exploitabilité)
+std::unique_ptr<CFRSolver> solve_hogwild(int threads) {
+    Json::Value solver_config;
+    solver_config["seed"] = 17;
+    solver_config["num_threads"] = threads;
+    Json::Value params = checks::river_params(solver_config);
+    std::unique_ptr<CFRSolver> solver = checks::create_spot_solver(params);
+    CFRSolver* stopped = solver.get();
+    solver->set_stopping_criteria(41, -1.0);
+    solver->set_iteration_callback(40, [stopped](int) { stopped->request_stop(); });
+    solver->solve(parse_game_config(params["game_config"]));
+    CHECK_EQ(solver->current_iteration(), 40);
+    return solver;
+}
+
+std::set<std::string> infoset_keys(const CFRSolver& solver) {
+    std::set<std::string> keys;
+    solver.for_each_infoset([&keys](const std::string& key, const GameNode&) { keys.insert(key); });
+    return keys;
+}
+
+} // namespace
+
+// Insertions sérialisées (comme sous le verrou de création des nœuds),
+// recherches concurrentes sans verrou: une clé est absente ou liée à son
+// nœud, jamais à un autre; toutes sont présentes à la fin
+POKER_CHECK(hogwild, concurrent_index_insert_find) {
+    std::vector<std::string> keys;
+    std::deque<GameNode> nodes;
+    for (int i = 0; i < NUM_KEYS; ++i) {
+        keys.push_back("infoset/" + std::to_string(i));
+        nodes.emplace_back(GameState(2), i % 2);
+    }
+    ConcurrentNodeIndex index(64);
+
+    std::mutex insert_mutex;
+    std::atomic<int> writers_done{0};
+    std::atomic<long> wrong_nodes{0};
+    std::vector<std::thread> threads;
+    for (int writer = 0; writer < NUM_WRITERS; ++writer) {
+        threads.emplace_back([&, writer] {
+            for (int i = writer; i < NUM_KEYS; i += NUM_WRITERS) {
+                std::lock_guard<std::mutex> lock(insert_mutex);
+                index.insert(colliding_hash(keys[i]), &keys[i], &nodes[i]);
+            }
+            ++writers_done;
+        });
+    }
+    for (int reader = 0; reader < NUM_READERS; ++reader) {
+        threads.emplace_back([&, reader] {
+            int i = reader;
+            while (writers_done.load() < NUM_WRITERS) {
+                GameNode* node = index.find(colliding_hash(keys[i]), keys[i]);
+                if (node && node != &nodes[i]) {
+                    ++wrong_nodes;
+                }
+                i = (i + 7919) % NUM_KEYS;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    CHECK_EQ(wrong_nodes.load(), 0L);
+    CHECK_EQ(index.size(), static_cast<size_t>(NUM_KEYS));
+    for (int i = 0; i < NUM_KEYS; ++i) {
+        CHECK(index.find(colliding_hash(keys[i]), keys[i]) == &nodes[i]);
+    }
+    CHECK(index.find(colliding_hash("absente"), "absente") == nullptr);
+}
+
+// Hogwild (num_threads > 1): les mises à jour concurrentes changent les
+// valeurs mais ni l'arbre créé ni leur validité
+POKER_CHECK(hogwild, threaded_solve_matches_tree) {
+    std::set<std::string> sequential = infoset_keys(*solve_hogwild(1));
+    CHECK(!sequential.empty());
+    for (int threads : {2, 4}) {
+        std::unique_ptr<CFRSolver> solver = solve_hogwild(threads);
+        CHECK(infoset_keys(*solver) == sequential);
+        solver->for_each_infoset([](const std::string&, const GameNode& node) {
+            for (double regret : node.regret_sum) {
+                CHECK(std::isfinite(regret));
+            }
+            double total = 0.0;
+            for (double weight : node.strategy_sum) {
+                CHECK(std::isfinite(weight) && weight >= 0.0);
+                total += weight;
+            }
+            CHECK(total > 0.0);
+        });
+    }
+}
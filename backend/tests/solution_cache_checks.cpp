@@ -0,0 +1,114 @@
+#include "check.h"
+#include "solver_fixture.h"
+#include "poker/solution_cache.h"
+#include "poker/solve_job.h"
+#include <string>
+#include <unistd.h>
+
+using namespace poker;
+
+namespace {
+
+// Spot du banc (river_params) avec un tableau et des ranges donnés
+Json::Value spot_params(const std::string& board, const std::string& hero, const std::string& villain) {
+    Json::Value params = checks::river_params();
+    params["game_config"]["board"] = board;
+    params["game_config"]["ranges"].append(hero);
+    params["game_config"]["ranges"].append(villain);
+    return params;
+}
+
+std::string spot_of(const Json::Value& params) {
+    return canonical_spot("postflop", params);
+}
+
+Json::Value with_max_iterations(Json::Value params, int max_iterations) {
+    params["solver_config"]["max_iterations"] = max_iterations;
+    return params;
+}
+
+} // namespace
+
+// Les cartes du flop ne sont pas ordonnées, le turn et la river si
+POKER_CHECK(solution_cache, flop_order) {
+    std::string spot = spot_of(spot_params("As Kd 7h 2c 9s", "", ""));
+    CHECK_EQ(spot_of(spot_params("7h As Kd 2c 9s", "", "")), spot);
+    CHECK_EQ(spot_of(spot_params("Kd 7h As 2c 9s", "", "")), spot);
+    CHECK(spot_of(spot_params("As Kd 7h 9s 2c", "", "")) != spot);
+    CHECK(spot_of(spot_params("As Kd 2c 7h 9s", "", "")) != spot);
+}
+
+// Couleurs renommées (s->h, h->s, d->c, c->d) sur le tableau et les
+// combinaisons explicites, éléments des ranges dans un autre ordre
+POKER_CHECK(solution_cache, suit_isomorphism) {
+    std::string spot = spot_of(spot_params("As Kd 7h 2c 9s", "AsKs, QQ, Kd7h:0.5", "AKo+,9s9h"));
+    CHECK_EQ(spot_of(spot_params("Ah Kc 7s 2d 9h", "QQ,Kc7s:0.5,KhAh", "9s9h, AKo+")), spot);
+    CHECK_EQ(spot_of(spot_params("Ah Kc 7s 2d 9h", "", "")), spot_of(spot_params("As Kd 7h 2c 9s", "", "")));
+}
+
+// Même texture mais combinaisons liées autrement au tableau, autre tableau,
+// autres paramètres de regrets: spots distincts. Les critères d'arrêt et la
+// graine ne comptent pas.
+POKER_CHECK(solution_cache, distinct_spots) {
+    Json::Value params = spot_params("As Kd 7h 2c 9s", "AsKs", "");
+    std::string spot = spot_of(params);
+    CHECK(spot_of(spot_params("As Kd 7h 2c 9s", "AhKh", "")) != spot);
+    CHECK(spot_of(spot_params("As Kd 7h 2c 9s", "AsKd", "")) != spot);
+    CHECK(spot_of(spot_params("As Kd 7h 2c 8s", "AsKs", "")) != spot);
+    CHECK(spot_of(spot_params("As Kd 7h 2c 9s", "", "AsKs")) != spot);
+
+    Json::Value discounted = params;
+    discounted["solver_config"]["alpha"] = 2.0;
+    CHECK(spot_of(discounted) != spot);
+    CHECK(canonical_spot("preflop", params) != spot);
+
+    Json::Value stopped = with_max_iterations(params, 7);
+    stopped["solver_config"]["target_exploitability"] = 0.5;
+    stopped["solver_config"]["seed"] = 99;
+    CHECK_EQ(spot_of(stopped), spot);
+}
+
+// Entrée de 30 itérations: HIT pour 30 itérations ou moins demandées (même
+// depuis un spot isomorphe), WARM au-delà pour le même game_config
+// seulement, MISS pour un spot absent
+POKER_CHECK(solution_cache, lookup_hit_or_warm) {
+    checks::TempDir dir;
+    SolutionCache cache(dir.path("cache"), 1ULL << 30);
+    Json::Value params = spot_params("As Kd 7h 2c 9s", "AhKh,QQ", "");
+    std::string spot = spot_of(params);
+    CHECK(cache.lookup(spot, params).status == SolutionCache::Status::MISS);
+
+    std::unique_ptr<CFRSolver> solver = checks::solve_spot(params, 30);
+    CFRResult result{};
+    result.iterations_completed = solver->current_iteration();
+    result.final_exploitability = 1.0;
+    result.status_message = "max_iterations";
+    cache.store(spot, *solver, "postflop", params,
+                simulation_result_json("postflop", params, result, std::vector<double>()));
+
+    SolutionCache::Lookup hit = cache.lookup(spot, with_max_iterations(params, 30));
+    CHECK(hit.status == SolutionCache::Status::HIT);
+    CHECK_EQ(hit.iterations, 30);
+    CHECK_EQ(hit.result["result"]["iterations_completed"].asInt(), 30);
+
+    SolutionCache::Lookup warm = cache.lookup(spot, with_max_iterations(params, 60));
+    CHECK(warm.status == SolutionCache::Status::WARM);
+    CHECK_EQ(warm.key, hit.key);
+    CHECK_EQ(warm.iterations, 30);
+    CHECK(::access(warm.checkpoint_path.c_str(), R_OK) == 0);
+    std::unique_ptr<CFRSolver> resumed = checks::create_spot_solver(params);
+    resumed->read_checkpoint(warm.checkpoint_path);
+    CHECK_EQ(resumed->current_iteration(), 30);
+
+    // Spot isomorphe: même entrée, résultat rendu avec sa propre configuration,
+    // mais pas de reprise (les clés du checkpoint portent le tableau réel)
+    Json::Value isomorphic = spot_params("Ah Kc 7s 2d 9h", "AsKs,QQ", "");
+    CHECK_EQ(spot_of(isomorphic), spot);
+    SolutionCache::Lookup isomorphic_hit = cache.lookup(spot, with_max_iterations(isomorphic, 20));
+    CHECK(isomorphic_hit.status == SolutionCache::Status::HIT);
+    CHECK(isomorphic_hit.result["result"]["metadata"]["game_config"] == isomorphic["game_config"]);
+    CHECK(cache.lookup(spot, with_max_iterations(isomorphic, 60)).status == SolutionCache::Status::MISS);
+
+    Json::Value other = spot_params("As Kd 7h 2c 8s", "AhKh,QQ", "");
+    CHECK(cache.lookup(spot_of(other), other).status == SolutionCache::Status::MISS);
+}
@@ -0,0 +1,54 @@
+#include "solver_fixture.h"
+#include "check.h"
+#include "poker/solve_job.h"
+
+namespace poker {
+namespace checks {
+
+Json::Value river_params(const Json::Value& solver_config) {
+    Json::Value params;
+    params["solver_config"]["checkpoint_frequency"] = 0;
+    params["solver_config"]["seed"] = 1;
+    if (solver_config.isObject()) {
+        for (const std::string& name : solver_config.getMemberNames()) {
+            params["solver_config"][name] = solver_config[name];
+        }
+    }
+    params["game_config"]["board"] = "As Kd 7h 2c 9s";
+    params["game_config"]["stack_size"] = 100;
+    for (double size : {0.33, 0.5, 0.75, 1.0, 1.5}) {
+        params["game_config"]["allowed_bet_sizes"].append(size);
+    }
+    return params;
+}
+
+std::unique_ptr<CFRSolver> create_spot_solver(const Json::Value& params) {
+    auto abstraction = std::make_shared<BasicAbstraction>();
+    return create_task_solver("postflop", abstraction, parse_solver_config(params["solver_config"]),
+                              params["game_config"]);
+}
+
+void run_iterations(CFRSolver& solver, const Json::Value& params, int iterations) {
+    int last = solver.current_iteration() + iterations;
+    if (iterations <= 0 || last >= 100) {
+        fail(__FILE__, __LINE__, "run_iterations: itération finale " + std::to_string(last));
+    }
+    // Arrêt demandé entre deux itérations: la mesure finale est aussi évitée
+    CFRSolver* stopped = &solver;
+    solver.set_stopping_criteria(last + 1, -1.0);
+    solver.set_iteration_callback(1, [stopped, last](int iteration) {
+        if (iteration >= last) {
+            stopped->request_stop();
+        }
+    });
+    solver.solve(parse_game_config(params["game_config"]));
+    solver.set_iteration_callback(0, nullptr);
+    solver.clear_stop_request();
+    if (solver.current_iteration() != last) {
+        fail(__FILE__, __LINE__, "run_iterations: " + std::to_string(solver.current_iteration()) +
+                                 " itérations au lieu de " + std::to_string(last));
+    }
+}
+
+} // namespace checks
+} // namespace poker
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "poker/cfr_solver.h"
+#include <json/json.h>
+#include <memory>
+
+namespace poker {
+namespace checks {
+
+// Spot de river (tableau complet, 100 BB, cinq tailles de mise); solver_config complète ou
+// remplace les valeurs par défaut (MCCFR, graine 1, sans checkpoint
+// périodique)
+Json::Value river_params(const Json::Value& solver_config = Json::Value());
+
+// Solveur de create_task_solver pour params (tâche postflop)
+std::unique_ptr<CFRSolver> create_spot_solver(const Json::Value& params);
+
+// Poursuit la résolution de iterations itérations. L'itération finale reste
+// sous 100: pas de mesure d'exploitabilité, trop coûteuse ici.
+void run_iterations(CFRSolver& solver, const Json::Value& params, int iterations);
+
+inline std::unique_ptr<CFRSolver> solve_spot(const Json::Value& params, int iterations) {
+    std::unique_ptr<CFRSolver> solver = create_spot_solver(params);
+    run_iterations(*solver, params, iterations);
+    return solver;
+}
+
+} // namespace checks
+} // namespace poker
@@ -0,0 +1,127 @@
+#include "check.h"
+#include "solver_fixture.h"
+#include "poker/strategy_file.h"
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace poker;
+
+namespace {
+
+struct ExpectedInfoset {
+    std::vector<Action> actions;
+    std::vector<double> strategy;
+};
+
+std::map<std::string, ExpectedInfoset> infosets_of(const CFRSolver& solver) {
+    std::map<std::string, ExpectedInfoset> infosets;
+    solver.for_each_infoset([&infosets](const std::string& key, const GameNode& node) {
+        infosets[key] = {node.actions, node.get_average_strategy()};
+    });
+    return infosets;
+}
+
+const CFRSolver& solved_spot() {
+    static std::unique_ptr<CFRSolver> solver = checks::solve_spot(checks::river_params(), 60);
+    return *solver;
+}
+
+} // namespace
+
+POKER_CHECK(strategy_file, round_trip) {
+    checks::TempDir dir;
+    const CFRSolver& solver = solved_spot();
+    std::map<std::string, ExpectedInfoset> expected = infosets_of(solver);
+    CHECK(expected.size() >= 2);
+
+    for (int bits : {8, 16}) {
+        StrategyExportOptions options;
+        options.value_bits = bits;
+        options.metadata = "{\"task_type\":\"postflop\"}";
+        std::string filename = dir.path("solution_" + std::to_string(bits) + ".strat");
+        write_strategy_file(solver, filename, options);
+
+        StrategyFile file(filename, true);
+        CHECK_EQ(file.header().version, STRATEGY_FILE_VERSION);
+        CHECK_EQ(file.header().iteration, uint64_t(solver.current_iteration()));
+        CHECK_EQ(file.header().solver_type, uint32_t(solver.solver_type()));
+        CHECK_EQ(int(file.header().value_bits), bits);
+        CHECK_EQ(std::string(file.metadata()), options.metadata);
+        CHECK_EQ(file.num_infosets(), expected.size());
+
+        const double scale = bits == 8 ? 255.0 : 65535.0;
+        for (const auto& [key, infoset] : expected) {
+            const StrategyIndexEntry* entry = file.find(key);
+            CHECK(entry != nullptr);
+            CHECK_EQ(std::string(file.key_of(*entry)), key);
+
+            std::vector<Action> actions = file.actions(*entry);
+            CHECK_EQ(actions.size(), infoset.actions.size());
+            for (size_t a = 0; a < actions.size(); ++a) {
+                CHECK(actions[a].type == infoset.actions[a].type);
+                CHECK_EQ(actions[a].amount, infoset.actions[a].amount);
+            }
+
+            // Plus forts restes: chaque probabilité à moins d'un pas, somme exacte
+            std::vector<double> strategy = file.strategy(*entry);
+            CHECK_EQ(strategy.size(), infoset.strategy.size());
+            double total = 0.0;
+            for (size_t a = 0; a < strategy.size(); ++a) {
+                CHECK_NEAR(strategy[a], infoset.strategy[a], 1.0 / scale);
+                total += strategy[a];
+            }
+            CHECK_NEAR(total, 1.0, 1e-9);
+        }
+        CHECK(file.find("absent") == nullptr);
+
+        Json::Value json = strategy_file_to_json(file);
+        CHECK_EQ(json["infosets"].size(), expected.size());
+    }
+}
+
+POKER_CHECK(strategy_file, prunes_small_probabilities) {
+    checks::TempDir dir;
+    const CFRSolver& solver = solved_spot();
+    std::map<std::string, ExpectedInfoset> expected = infosets_of(solver);
+    StrategyExportOptions options;
+    options.value_bits = 16;
+    options.prune_threshold = 0.2;
+    write_strategy_file(solver, dir.path("pruned.strat"), options);
+
+    StrategyFile file(dir.path("pruned.strat"), true);
+    for (const auto& [key, infoset] : expected) {
+        std::vector<double> strategy = file.strategy(*file.find(key));
+        if (*std::max_element(infoset.strategy.begin(), infoset.strategy.end()) < options.prune_threshold) {
+            continue; // Tout sous le seuil: repli défini par l'export
+        }
+        for (size_t a = 0; a < strategy.size(); ++a) {
+            if (infoset.strategy[a] < options.prune_threshold) {
+                CHECK_EQ(strategy[a], 0.0);
+            }
+        }
+    }
+}
+
+POKER_CHECK(strategy_file, rejects_invalid_files) {
+    checks::TempDir dir;
+    const CFRSolver& solver = solved_spot();
+    StrategyExportOptions options;
+    options.value_bits = 12;
+    CHECK_THROWS(write_strategy_file(solver, dir.path("bits.strat"), options), std::runtime_error);
+
+    options.value_bits = 8;
+    write_strategy_file(solver, dir.path("solution.strat"), options);
+    std::string bytes = checks::read_file(dir.path("solution.strat"));
+    CHECK_THROWS(StrategyFile(dir.path("absent.strat")), std::runtime_error);
+
+    std::string bad_header = bytes;
+    bad_header[offsetof(StrategyFileHeader, num_infosets)] ^= 1;
+    checks::write_file(dir.path("header.strat"), bad_header);
+    CHECK_THROWS(StrategyFile(dir.path("header.strat")), std::runtime_error);
+
+    checks::write_file(dir.path("truncated.strat"), bytes.substr(0, bytes.size() - 8));
+    CHECK_THROWS(StrategyFile(dir.path("truncated.strat")), std::runtime_error);
+}
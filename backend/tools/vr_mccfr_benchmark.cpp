@@ -0,0 +1,305 @@
+// Mesure de VR-MCCFR (CFRConfig::use_baselines) face au MCCFR simple sur
+// une rivière: variance de l'estimateur de la valeur racine, itérations
+// nécessaires pour atteindre une exploitabilité donnée, temps par itération.
+//
+//   vr_mccfr_benchmark [graines]    (20 par défaut)
+//
+// Rivière As Kd 7h 4c 2s, tapis 60/58, pot 6 après une mise de 2 du second
+// joueur, tailles 0.33/0.5/0.75/1/1.5, ranges "AA,KK,QQ,AK,72o,83o,T9s"
+// contre "JJ+,AQ+,KQs,65s,98o". Les clés d'infoset ne portent pas les
+// mains: l'exploitabilité est calculée exactement sur le jeu moyenné sur les
+// donnes (showdown à l'équité moyenne du premier joueur). La variance est
+// celle de 20000 traversées du premier joueur sur les valeurs figées aux
+// itérations 20, 100 et 500.
+//
+// Une cible non atteinte en 20000 itérations est comptée pour 20000 et
+// signalée sur stderr.
+//
+// Sortie avec 20 graines, à l'introduction de use_baselines:
+//
+//                         MCCFR simple   VR-MCCFR
+//   variance @20   it          63.5         53.7
+//   variance @100  it          68.6         65.8
+//   variance @500  it          14.5         11.7
+//   itérations expl 0.2         553          508
+//   itérations expl 0.05       2389         2159
+//   itérations expl 0.01       9467         8218
+//   temps par itération     137 us       136 us
+//
+// Depuis la correction des kickers de l'évaluateur (showdowns changés,
+// équité 0.5180 au lieu de 0.5198); 0.01 non atteinte pour les graines 15
+// et 20 (MCCFR simple), 4, 15 et 19 (VR-MCCFR):
+//
+//                         MCCFR simple   VR-MCCFR
+//   variance @20   it          52.0         58.7
+//   variance @100  it          65.5         73.3
+//   variance @500  it          14.8         13.8
+//   itérations expl 0.2         532          503
+//   itérations expl 0.05       2154         2168
+//   itérations expl 0.01      10563        10290
+//   temps par itération     124 us       116 us
+
+#include "poker/cfr_solver.h"
+#include "poker/counter_rng.h"
+#include "poker/deal_sampler.h"
+#include "poker/solve_job.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace poker;
+
+namespace {
+
+const char* const RANGES[2] = {"AA,KK,QQ,AK,72o,83o,T9s", "JJ+,AQ+,KQs,65s,98o"};
+constexpr int EQUITY_DEALS = 400000;
+constexpr int MAX_ITERATIONS = 20000;
+constexpr int EXPLOITABILITY_EVERY = 10;
+constexpr int VARIANCE_SAMPLES = 20000;
+constexpr int SNAPSHOTS[3] = {20, 100, 500};
+constexpr double TARGETS[3] = {0.2, 0.05, 0.01};
+constexpr int TIMING_ITERATIONS = 50000;
+
+GameState river_spot() {
+    GameState state(2);
+    state.street = 3;
+    state.small_blind = 0.5;
+    state.big_blind = 1.0;
+    state.board = {Card("As"), Card("Kd"), Card("7h"), Card("4c"), Card("2s")};
+    state.stacks = {60.0, 58.0};
+    state.pot = 6.0;
+    state.bets = {0.0, 2.0};
+    state.total_invested = {2.0, 4.0};
+    state.allowed_bet_sizes = {0.33, 0.5, 0.75, 1.0, 1.5};
+    return state;
+}
+
+std::vector<HandRange> spot_ranges() {
+    return {parse_hand_range(RANGES[0]), parse_hand_range(RANGES[1])};
+}
+
+// Équité moyenne du premier joueur au showdown, sur des donnes tirées des ranges
+double showdown_equity(const GameState& spot, const std::vector<HandRange>& ranges) {
+    DealSampler sampler(spot.board, spot.num_players);
+    for (int player = 0; player < 2; ++player) {
+        sampler.set_range(player, ranges[player]);
+    }
+    Deal deal;
+    GameState state = spot;
+    double wins = 0.0;
+    for (int i = 0; i < EQUITY_DEALS; ++i) {
+        CounterRng rng(777, static_cast<uint64_t>(i));
+        sampler.deal(rng, deal);
+        state.player_hands = deal.hands;
+        int winner = state.determine_winner({0, 1});
+        wins += winner == 0 ? 1.0 : winner == 1 ? 0.0 : 0.5;
+    }
+    return wins / EQUITY_DEALS;
+}
+
+// Exploitabilité exacte de la stratégie moyenne sur le jeu moyenné sur les donnes
+class ExactExploitability {
+public:
+    ExactExploitability(const GameState& spot, double equity) : spot_(spot), equity_(equity) {}
+
+    double operator()(const CFRSolver& solver) const {
+        double gain0 = value(solver, spot_, 0, 0) - value(solver, spot_, 0, -1);
+        double gain1 = value(solver, spot_, 1, 1) - value(solver, spot_, 1, -1);
+        return (gain0 + gain1) / 2.0;
+    }
+
+private:
+    // Valeur pour player quand best_responder (-1: personne) joue sa meilleure réponse
+    double value(const CFRSolver& solver, const GameState& state, int player, int best_responder) const {
+        if (state.is_terminal()) {
+            return terminal_value(state, player);
+        }
+        std::vector<Action> actions = abstraction_.get_abstracted_actions(state);
+        if (state.current_player == best_responder) {
+            double best = -1e18;
+            for (const Action& action : actions) {
+                best = std::max(best, value(solver, state.apply_action(action), player, best_responder));
+            }
+            return best;
+        }
+        std::vector<double> strategy = solver.get_strategy(state, state.current_player);
+        strategy.resize(actions.size());
+        double total = 0.0;
+        for (double p : strategy) total += p;
+        double result = 0.0;
+        for (size_t i = 0; i < actions.size(); ++i) {
+            double p = total > 0.0 ? strategy[i] / total : 1.0 / actions.size();
+            result += p * value(solver, state.apply_action(actions[i]), player, best_responder);
+        }
+        return result;
+    }
+
+    double terminal_value(const GameState& state, int player) const {
+        if (state.folded_players[0] || state.folded_players[1]) {
+            return state.get_payoffs()[player];
+        }
+        double share = player == 0 ? equity_ : 1.0 - equity_;
+        return state.pot * share - state.total_invested[player];
+    }
+
+    GameState spot_;
+    double equity_;
+    BasicAbstraction abstraction_;
+};
+
+// MCCFR dont l'estimateur racine peut être évalué sur des valeurs figées.
+// Sans mesure d'exploitabilité pendant solve(): celle du solveur parcourt
+// toutes les donnes.
+class MeasuredCFR : public ChanceSamplingCFR {
+public:
+    using ChanceSamplingCFR::ChanceSamplingCFR;
+
+    double calculate_exploitability(const GameState&) const override { return 1.0; }
+
+    // Variance de la valeur racine du premier joueur sur samples
+    // traversées, toutes depuis les valeurs de l'itération courante
+    double root_variance(const GameState& spot, uint64_t stream, int samples) {
+        DealSampler sampler = make_deal_sampler(spot);
+        GameState dealt_root = spot;
+        Deal deal;
+        save_values();
+        std::vector<double> values;
+        for (int k = 0; k < samples; ++k) {
+            CounterRng rng(stream + static_cast<uint64_t>(k), 1u << 30);
+            sampler.deal(rng, deal);
+            dealt_root.player_hands = deal.hands;
+            std::vector<double> reach(2, 1.0);
+            values.push_back(mccfr(dealt_root, deal, reach, current_iteration_, 0, rng)[0]);
+            restore_values();
+        }
+        double mean = 0.0;
+        for (double v : values) mean += v;
+        mean /= samples;
+        double variance = 0.0;
+        for (double v : values) variance += (v - mean) * (v - mean);
+        return variance / samples;
+    }
+
+private:
+    struct SavedNode {
+        std::vector<double> regret_sum;
+        std::vector<double> strategy_sum;
+        std::vector<double> baseline;
+    };
+
+    void save_values() {
+        saved_.clear();
+        for (const auto& [key, node] : node_map_) {
+            saved_[key] = {std::vector<double>(node->regret_sum.begin(), node->regret_sum.end()),
+                           std::vector<double>(node->strategy_sum.begin(), node->strategy_sum.end()),
+                           node->baseline};
+        }
+    }
+
+    // Nœuds créés depuis save_values(): remis à zéro
+    void restore_values() {
+        for (auto& [key, node] : node_map_) {
+            auto it = saved_.find(key);
+            if (it == saved_.end()) {
+                std::fill(node->regret_sum.begin(), node->regret_sum.end(), 0.0);
+                std::fill(node->strategy_sum.begin(), node->strategy_sum.end(), 0.0);
+                std::fill(node->baseline.begin(), node->baseline.end(), 0.0);
+                continue;
+            }
+            std::copy(it->second.regret_sum.begin(), it->second.regret_sum.end(), node->regret_sum.begin());
+            std::copy(it->second.strategy_sum.begin(), it->second.strategy_sum.end(), node->strategy_sum.begin());
+            node->baseline = it->second.baseline;
+        }
+    }
+
+    std::unordered_map<std::string, SavedNode> saved_;
+};
+
+struct VariantResult {
+    double variance[3] = {0.0, 0.0, 0.0};
+    double iterations[3] = {0.0, 0.0, 0.0};
+    double microseconds_per_iteration = 0.0;
+};
+
+CFRConfig variant_config(bool use_baselines, uint64_t seed, int max_iterations) {
+    CFRConfig config;
+    config.max_iterations = max_iterations;
+    config.checkpoint_frequency = 0;
+    config.seed = seed;
+    config.use_baselines = use_baselines;
+    return config;
+}
+
+VariantResult measure(bool use_baselines, int seeds, const GameState& spot, const std::vector<HandRange>& ranges,
+                      const ExactExploitability& exploitability) {
+    VariantResult result;
+    for (int seed = 1; seed <= seeds; ++seed) {
+        MeasuredCFR solver(std::make_shared<BasicAbstraction>(),
+                           variant_config(use_baselines, static_cast<uint64_t>(seed), MAX_ITERATIONS));
+        solver.set_ranges(ranges);
+        int snapshot = 0;
+        int target = 0;
+        solver.set_iteration_callback(EXPLOITABILITY_EVERY, [&](int iteration) {
+            if (snapshot < 3 && iteration == SNAPSHOTS[snapshot]) {
+                uint64_t stream = static_cast<uint64_t>(seed) * 1000003ULL;
+                result.variance[snapshot++] += solver.root_variance(spot, stream, VARIANCE_SAMPLES) / seeds;
+            }
+            while (target < 3 && exploitability(solver) <= TARGETS[target]) {
+                result.iterations[target++] += static_cast<double>(iteration) / seeds;
+            }
+            if (target == 3) {
+                solver.request_stop();
+            }
+        });
+        solver.solve(spot);
+        // Cible non atteinte: comptée pour MAX_ITERATIONS (moyenne sous-estimée)
+        for (; target < 3; ++target) {
+            std::fprintf(stderr, "graine %d: exploitabilité %g non atteinte en %d itérations\n", seed,
+                         TARGETS[target], MAX_ITERATIONS);
+            result.iterations[target] += static_cast<double>(MAX_ITERATIONS) / seeds;
+        }
+    }
+
+    MeasuredCFR timed(std::make_shared<BasicAbstraction>(), variant_config(use_baselines, 1, TIMING_ITERATIONS));
+    timed.set_ranges(ranges);
+    auto start = std::chrono::steady_clock::now();
+    timed.solve(spot);
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    result.microseconds_per_iteration = elapsed.count() / TIMING_ITERATIONS;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int seeds = argc > 1 ? std::atoi(argv[1]) : 20;
+    if (seeds <= 0) {
+        std::fprintf(stderr, "usage: %s [graines]\n", argv[0]);
+        return 1;
+    }
+
+    // Tableau seul sur la sortie standard, messages du solveur sur stderr
+    FILE* out = ::fdopen(detach_stdout(), "w");
+    GameState spot = river_spot();
+    std::vector<HandRange> ranges = spot_ranges();
+    ExactExploitability exploitability(spot, showdown_equity(spot, ranges));
+    VariantResult plain = measure(false, seeds, spot, ranges, exploitability);
+    VariantResult reduced = measure(true, seeds, spot, ranges, exploitability);
+
+    std::fprintf(out, "                        MCCFR simple   VR-MCCFR\n");
+    for (int i = 0; i < 3; ++i) {
+        std::fprintf(out, "  variance @%-4d it     %9.1f    %9.1f\n", SNAPSHOTS[i], plain.variance[i], reduced.variance[i]);
+    }
+    for (int i = 0; i < 3; ++i) {
+        std::fprintf(out, "  itérations expl %-5g %9.0f    %9.0f\n", TARGETS[i], plain.iterations[i], reduced.iterations[i]);
+    }
+    std::fprintf(out, "  temps par itération  %6.0f us    %6.0f us\n", plain.microseconds_per_iteration,
+                reduced.microseconds_per_iteration);
+    std::fclose(out);
+    return 0;
+}